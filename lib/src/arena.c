@@ -0,0 +1,142 @@
+/*!
+ * \file
+ * \brief file arena.c
+ *
+ * Bump allocator, the memory is allocated from large blocks
+ * and released at once
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*!
+ * \brief arena_alloc
+ *
+ * allocates memory from the arena, memory is aligned by ARENA_ALIGNMENT
+ * and it's valid until arena_reset() or arena_clear() is called
+ *
+ * \param arena
+ * \param size size of the memory in bytes
+ * \return allocated memory, NULL on failure
+ */
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    arena_block_t *block;
+    size_t block_size;
+    void *ret;
+
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    block = arena->current;
+    if (!block || block->size - block->used < size) {
+        block_size = arena->block_size ? arena->block_size : ARENA_DEFAULT_BLOCK_SIZE;
+        if (block_size < size) {
+            block_size = size;
+        }
+        block = (arena_block_t *)malloc(sizeof(arena_block_t) + block_size);
+        if (!block) {
+            return NULL;
+        }
+        block->size = block_size;
+        block->used = 0;
+        block->next = NULL;
+        if (arena->current) {
+            arena->current->next = block;
+        } else {
+            arena->first = block;
+        }
+        arena->current = block;
+    }
+
+    ret = (uint8_t *)(block + 1) + block->used;
+    block->used += size;
+    return ret;
+}
+
+/*!
+ * \brief arena_calloc
+ *
+ * allocates zeroed memory from the arena
+ *
+ * \param arena
+ * \param count
+ * \param size
+ * \return allocated memory, NULL on failure
+ */
+void *arena_calloc(arena_t *arena, size_t count, size_t size)
+{
+    void *ret;
+
+    if (size && count > SIZE_MAX/size) {
+        return NULL;
+    }
+    ret = arena_alloc(arena, count*size);
+    if (ret) {
+        memset(ret, 0, count*size);
+    }
+    return ret;
+}
+
+/*!
+ * \brief arena_reset
+ *
+ * releases all allocations of the arena at once, the largest
+ * block is kept for the next allocations and others are freed
+ *
+ * \param arena
+ */
+void arena_reset(arena_t *arena)
+{
+    arena_block_t *block = arena->first;
+    arena_block_t *largest = arena->first;
+    arena_block_t *next;
+
+    while (block) {
+        if (block->size > largest->size) {
+            largest = block;
+        }
+        block = block->next;
+    }
+
+    block = arena->first;
+    while (block) {
+        next = block->next;
+        if (block != largest) {
+            free(block);
+        }
+        block = next;
+    }
+
+    if (largest) {
+        largest->used = 0;
+        largest->next = NULL;
+    }
+    arena->first = largest;
+    arena->current = largest;
+}
+
+/*!
+ * \brief arena_clear
+ *
+ * frees all memory of the arena, arena can be used again
+ *
+ * \param arena
+ */
+void arena_clear(arena_t *arena)
+{
+    arena_block_t *block = arena->first;
+    arena_block_t *next;
+
+    while (block) {
+        next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+}
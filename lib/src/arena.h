@@ -0,0 +1,51 @@
+/*!
+ * \file
+ * \brief file arena.h
+ *
+ * Bump allocator, the memory is allocated from large blocks
+ * and released at once
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ARENA_DEFAULT_BLOCK_SIZE    (64*1024)
+#define ARENA_ALIGNMENT             8
+
+/*!
+ * \brief The arena_block_t struct
+ *
+ * single memory block of arena, the memory follows the struct
+ */
+typedef struct arena_block
+{
+    struct arena_block *next;
+    size_t size;    // size of the memory after the struct
+    size_t used;
+} arena_block_t;
+
+/*!
+ * \brief The arena_t struct
+ *
+ * zeroed arena_t is empty arena that uses ARENA_DEFAULT_BLOCK_SIZE
+ */
+typedef struct
+{
+    arena_block_t *first;
+    arena_block_t *current;     // last block, the allocations are done from this
+    size_t block_size;          // min size of new block, 0 == ARENA_DEFAULT_BLOCK_SIZE
+} arena_t;
+
+void *arena_alloc(arena_t *arena, size_t size);
+void *arena_calloc(arena_t *arena, size_t count, size_t size);
+void arena_reset(arena_t *arena);
+void arena_clear(arena_t *arena);
+
+#endif // ARENA_H
@@ -0,0 +1,216 @@
+/*!
+ * \file
+ * \brief file glyph_area.c
+ *
+ * Calculates the covered area of each pixel of
+ * the glyph from the outline (anti-aliasing without
+ * the quality times larger drawing)
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "glyph_area.h"
+#include "glyph_flatten.h"
+#include <math.h>
+#include <errno.h>
+
+/*!
+ * \brief max distance (in pixels) between the curve and its lines
+ */
+#define GLYPH_AREA_CURVE_TOLERANCE  0.05f
+
+/*!
+ * \brief glyph_area_init
+ *
+ * Inits the area buffer, buffer is zeroed
+ *
+ * \param area
+ * \param width width in pixels
+ * \param height height in pixels
+ * \param arena buffer is allocated from this arena
+ * \return 0 on success
+ */
+int glyph_area_init(glyph_area_t *area, int width, int height, arena_t *arena)
+{
+    area->width = width;
+    area->height = height;
+    // line that ends at the last pixel of the row adds the area into next pixel
+    area->list_area = (float *)arena_calloc(arena, (uint32_t)(width*height+1), sizeof(float));
+    if (!area->list_area) {
+        return ENOMEM;
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_area_clamp_x
+ * \param area
+ * \param x
+ * \return x that is inside of the area
+ */
+static float glyph_area_clamp_x(const glyph_area_t *area, float x)
+{
+    if (x < 0) {
+        return 0;
+    }
+    if (x > (float)(area->width - 1)) {
+        return (float)(area->width - 1);
+    }
+    return x;
+}
+
+/*!
+ * \brief glyph_area_add_line
+ *
+ * adds signed area of the line into the pixels of each row that the
+ * line crosses, area is positive if the line goes to up. The pixel
+ * that the line crosses gets the part of its area that is on the right side
+ * of the line, and the rest is added into next pixel, so sum of the row
+ * (from left) is the coverage of the pixel
+ *
+ * \param area
+ * \param x0 start x position in pixels
+ * \param y0 start y position in pixels
+ * \param x1 end x position in pixels
+ * \param y1 end y position in pixels
+ */
+void glyph_area_add_line(glyph_area_t *area, float x0, float y0, float x1, float y1)
+{
+    float direction = 1.0f;
+    float tmp, dxdy;
+    float x, x_next;
+    float row_y0, row_y1, dy, d;
+    float left, right, left_floor, right_ceil;
+    float x_mid, s, left_fraction, right_fraction;
+    float area0, area1, area2, area_last;
+    int y, y_end, xi;
+    int left_i, right_i;
+    float *row;
+
+    if (fabsf(y0 - y1) <= 0) {
+        return;
+    }
+    if (y0 > y1) {
+        direction = -1.0f;
+        tmp = x0; x0 = x1; x1 = tmp;
+        tmp = y0; y0 = y1; y1 = tmp;
+    }
+    dxdy = (x1 - x0)/(y1 - y0);
+    x = x0;
+    if (y0 < 0) {
+        x -= y0*dxdy;
+        y0 = 0;
+    }
+    if (y1 > (float)area->height) {
+        y1 = (float)area->height;
+    }
+    if (y0 >= y1) {
+        return;
+    }
+
+    tmp = floorf(y0);
+    y = (int)tmp;
+    tmp = ceilf(y1);
+    y_end = (int)tmp;
+    for (;y<y_end;y++) {
+        row = &area->list_area[y*area->width];
+        row_y0 = (float)y > y0 ? (float)y : y0;
+        row_y1 = (float)(y + 1) < y1 ? (float)(y + 1) : y1;
+        dy = row_y1 - row_y0;
+        x_next = x + dxdy*dy;
+        d = dy*direction;
+
+        if (x < x_next) {
+            left = glyph_area_clamp_x(area, x);
+            right = glyph_area_clamp_x(area, x_next);
+        } else {
+            left = glyph_area_clamp_x(area, x_next);
+            right = glyph_area_clamp_x(area, x);
+        }
+        left_floor = floorf(left);
+        left_i = (int)left_floor;
+        right_ceil = ceilf(right);
+        right_i = (int)right_ceil;
+
+        if (right_i <= left_i + 1) {
+            // line is inside of single pixel
+            x_mid = 0.5f*(left + right) - left_floor;
+            row[left_i] += d - d*x_mid;
+            row[left_i+1] += d*x_mid;
+        } else {
+            // line crosses many pixels, area increases linearly between the first and last pixel
+            s = 1.0f/(right - left);
+            left_fraction = left - left_floor;
+            area0 = 0.5f*s*(1.0f - left_fraction)*(1.0f - left_fraction);
+            right_fraction = right - right_ceil + 1.0f;
+            area_last = 0.5f*s*right_fraction*right_fraction;
+            row[left_i] += d*area0;
+            if (right_i == left_i + 2) {
+                row[left_i+1] += d*(1.0f - area0 - area_last);
+            } else {
+                area1 = s*(1.5f - left_fraction);
+                row[left_i+1] += d*(area1 - area0);
+                for (xi=left_i+2;xi<right_i-1;xi++) {
+                    row[xi] += d*s;
+                }
+                area2 = area1 + (float)(right_i - left_i - 3)*s;
+                row[right_i-1] += d*(1.0f - area2 - area_last);
+            }
+            row[right_i] += d*area_last;
+        }
+        x = x_next;
+    }
+}
+
+/*!
+ * \brief glyph_area_add_curve
+ *
+ * flattens the quadratic curve into lines
+ * with glyph_flatten_next()
+ *
+ * \param area
+ * \param x0 start x position in pixels
+ * \param y0 start y position in pixels
+ * \param x1 end x position in pixels
+ * \param y1 end y position in pixels
+ * \param curve_x control point x
+ * \param curve_y control point y
+ */
+void glyph_area_add_curve(glyph_area_t *area, float x0, float y0, float x1, float y1, float curve_x, float curve_y)
+{
+    float x, y;
+    float prev_x = x0, prev_y = y0;
+    glyph_flatten_t flatten;
+
+    glyph_flatten_init(&flatten, x0, y0, x1, y1, curve_x, curve_y,
+                       GLYPH_AREA_CURVE_TOLERANCE, GLYPH_AREA_MAX_CURVE_LINES);
+    while (glyph_flatten_next(&flatten, &x, &y)) {
+        glyph_area_add_line(area, prev_x, prev_y, x, y);
+        prev_x = x;
+        prev_y = y;
+    }
+}
+
+/*!
+ * \brief glyph_area_accumulate
+ *
+ * converts the signed area changes into the coverage of
+ * each pixel, overlapping contours are limited to 1.0f
+ *
+ * \param area
+ */
+void glyph_area_accumulate(glyph_area_t *area)
+{
+    int i;
+    float sum = 0;
+    float coverage;
+
+    // sum of each row is zero, so the rows can be summed as a single list
+    for (i=0;i<area->width*area->height;i++) {
+        sum += area->list_area[i];
+        coverage = fabsf(sum);
+        area->list_area[i] = coverage > 1.0f ? 1.0f : coverage;
+    }
+}
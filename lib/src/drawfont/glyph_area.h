@@ -0,0 +1,43 @@
+/*!
+ * \file
+ * \brief file glyph_area.h
+ *
+ * Calculates the covered area of each pixel of
+ * the glyph from the outline (anti-aliasing without
+ * the quality times larger drawing)
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef GLYPH_AREA_H
+#define GLYPH_AREA_H
+
+#include <stdint.h>
+#include "../arena.h"
+
+/*!
+ * \brief max count of the lines of a single flattened curve
+ */
+#define GLYPH_AREA_MAX_CURVE_LINES  64
+
+/*!
+ * \brief The glyph_area_t struct
+ *
+ * signed area accumulation buffer of the glyph, lines add
+ * the signed area changes into list_area and glyph_area_accumulate()
+ * converts them into coverage (0.0f - 1.0f) of each pixel
+ */
+typedef struct {
+    int width;
+    int height;
+    float *list_area;   // width*height+1, allocated from the arena
+} glyph_area_t;
+
+int glyph_area_init(glyph_area_t *area, int width, int height, arena_t *arena);
+void glyph_area_add_line(glyph_area_t *area, float x0, float y0, float x1, float y1);
+void glyph_area_add_curve(glyph_area_t *area, float x0, float y0, float x1, float y1, float curve_x, float curve_y);
+void glyph_area_accumulate(glyph_area_t *area);
+
+#endif // GLYPH_AREA_H
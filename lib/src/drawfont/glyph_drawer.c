@@ -15,141 +15,400 @@
 #include <stdlib.h>
 #include <errno.h>
 #include "glyph_filler.h"
+#include "glyph_flatten.h"
+
+/*!
+ * \brief initial size of the path index hash table
+ */
+#define GLYPH_DRAWER_PATH_INDEX_SIZE    1024
+
+/*!
+ * \brief glyph_drawer_pool_reserve
+ *
+ * makes sure that the buffer of the pool has at least count items,
+ * buffer is grown to double size and it's zeroed, only count items
+ * are allocated if the double size would exceed the max memory size
+ *
+ * \param pool
+ * \param buffer [in/out] buffer of the pool
+ * \param buffer_size [in/out] count of items in buffer
+ * \param count required count of items
+ * \param size size of the item
+ * \return 0 on success, ENOMEM if the max memory size is exceeded
+ */
+static int glyph_drawer_pool_reserve(glyph_drawer_pool_t *pool, void **buffer, size_t *buffer_size,
+                                     size_t count, size_t size)
+{
+    size_t new_size = *buffer_size*2;
+
+    if (*buffer_size >= count) {
+        return 0;
+    }
+    if (new_size < count) {
+        new_size = count;
+    }
+    // buffer is zero, so it's released before the allocation
+    free(*buffer);
+    *buffer = NULL;
+    glyph_memory_release(pool->memory, *buffer_size*size);
+    *buffer_size = 0;
+    if (glyph_memory_reserve(pool->memory, new_size, size)) {
+        new_size = count;
+        if (glyph_memory_reserve(pool->memory, new_size, size)) {
+            return ENOMEM;
+        }
+    }
+    *buffer = calloc(new_size, size);
+    if (!*buffer) {
+        glyph_memory_release(pool->memory, new_size*size);
+        return ENOMEM;
+    }
+    *buffer_size = new_size;
+    return 0;
+}
 
 /*!
  * \brief glyph_drawer_init
  *
- * Inits the font_drawing
+ * Inits the font_drawing, all planes are in single buffer
  *
  * \param drawing
  * \param width
  * \param height
+ * \param pool buffers are taken from this pool, NULL to use calloc
  * \return 0 in success
  */
-int glyph_drawer_init(font_drawing_t *drawing, int width, int height)
+int glyph_drawer_init(font_drawing_t *drawing, int width, int height, glyph_drawer_pool_t *pool)
 {
+    int i, ret;
+    size_t plane_words;
+    void *buffer;
+    size_t buffer_size;
+
     drawing->width = width;
     drawing->height = height;
-    drawing->list_pixels = (pixel_drawing_t *)calloc((uint32_t)(width*height), sizeof(pixel_drawing_t) );
-    if (!drawing->list_pixels) {
-        return errno;
+    drawing->pool = pool;
+    drawing->tiles = NULL;
+    drawing->row_words = (width + 63)/64;
+    drawing->dirty_min_y = height;
+    drawing->dirty_max_y = -1;
+    drawing->list_path_index_count = 0;
+    plane_words = (size_t)drawing->row_words*(size_t)height;
+
+    if (pool) {
+        // pool buffers are zero when they are not used
+        buffer = pool->list_path_index;
+        buffer_size = pool->list_path_index_size;
+        ret = glyph_drawer_pool_reserve(pool, &buffer, &buffer_size, GLYPH_DRAWER_PATH_INDEX_SIZE, sizeof(glyph_drawer_path_index_t));
+        pool->list_path_index = (glyph_drawer_path_index_t *)buffer;
+        pool->list_path_index_size = (uint32_t)buffer_size;
+        if (ret) {
+            return ret;
+        }
+        buffer = pool->list_plane;
+        ret = glyph_drawer_pool_reserve(pool, &buffer, &pool->list_plane_size, plane_words*GLYPH_DRAWER_PLANE_COUNT + 1, sizeof(uint64_t));
+        pool->list_plane = (uint64_t *)buffer;
+        if (ret) {
+            return ret;
+        }
+        drawing->list_path_index = pool->list_path_index;
+        drawing->list_path_index_size = pool->list_path_index_size;
+        drawing->list_plane[0] = pool->list_plane;
+    } else {
+        drawing->list_path_index_size = GLYPH_DRAWER_PATH_INDEX_SIZE;
+        drawing->list_path_index = (glyph_drawer_path_index_t *)calloc(GLYPH_DRAWER_PATH_INDEX_SIZE, sizeof(glyph_drawer_path_index_t));
+        if (!drawing->list_path_index) {
+            return ENOMEM;
+        }
+        // +1 so that the planes are not NULL when the drawing is empty
+        drawing->list_plane[0] = (uint64_t *)calloc(plane_words*GLYPH_DRAWER_PLANE_COUNT + 1, sizeof(uint64_t));
+        if (!drawing->list_plane[0]) {
+            free(drawing->list_path_index);
+            drawing->list_path_index = NULL;
+            return ENOMEM;
+        }
+    }
+    for (i=1;i<GLYPH_DRAWER_PLANE_COUNT;i++) {
+        drawing->list_plane[i] = drawing->list_plane[i-1] + plane_words;
     }
     return 0;
 }
 
+/*!
+ * \brief glyph_drawer_init_tiles
+ *
+ * Inits the font_drawing that sets the line pixels into the tiles,
+ * planes and path indexes are not used, so only the line and the
+ * inner pixels (set by glyph_scanline_fill()) are available
+ *
+ * \param drawing
+ * \param tiles canvas from glyph_tiles_init()
+ */
+void glyph_drawer_init_tiles(font_drawing_t *drawing, glyph_tiles_t *tiles)
+{
+    int i;
+
+    drawing->width = tiles->width;
+    drawing->height = tiles->height;
+    drawing->pool = NULL;
+    drawing->tiles = tiles;
+    drawing->row_words = tiles->tile_columns;
+    drawing->dirty_min_y = tiles->height;
+    drawing->dirty_max_y = -1;
+    for (i=0;i<GLYPH_DRAWER_PLANE_COUNT;i++) {
+        drawing->list_plane[i] = NULL;
+    }
+    drawing->list_path_index = NULL;
+    drawing->list_path_index_count = 0;
+    drawing->list_path_index_size = 0;
+}
+
 /*!
  * \brief glyph_drawer_clear
  *
- * Clear the font_drawing
+ * Clear the font_drawing, buffers of the pool are
+ * zeroed for the next glyph (only the dirty rows)
  *
  * \param drawing
  */
 void glyph_drawer_clear(font_drawing_t *drawing)
 {
-    free(drawing->list_pixels);
+    int i;
+    size_t start, count;
+
+    if (drawing->tiles) {
+        glyph_tiles_clear(drawing->tiles);
+        drawing->tiles = NULL;
+    } else if (!drawing->pool) {
+        free(drawing->list_plane[0]);
+        free(drawing->list_path_index);
+    } else if (drawing->list_plane[0]) {
+        if (drawing->dirty_min_y <= drawing->dirty_max_y) {
+            start = (size_t)drawing->dirty_min_y*(size_t)drawing->row_words;
+            count = (size_t)(drawing->dirty_max_y - drawing->dirty_min_y + 1)*(size_t)drawing->row_words;
+            for (i=0;i<GLYPH_DRAWER_PLANE_COUNT;i++) {
+                memset(drawing->list_plane[i] + start, 0, count*sizeof(uint64_t));
+            }
+        }
+        if (drawing->list_path_index_count) {
+            memset(drawing->list_path_index, 0, drawing->list_path_index_size*sizeof(glyph_drawer_path_index_t));
+        }
+    }
+    for (i=0;i<GLYPH_DRAWER_PLANE_COUNT;i++) {
+        drawing->list_plane[i] = NULL;
+    }
+    drawing->list_path_index = NULL;
+    drawing->list_path_index_count = 0;
+    drawing->list_path_index_size = 0;
 }
 
 /*!
- * \brief glyph_drawer_paint_curve
+ * \brief glyph_drawer_add_dirty_rows
  *
- * drawing the curve by using bezier curve
+ * Marks the rows that have set bits, dirty rows are zeroed
+ * by glyph_drawer_clear() when the drawing is from the pool
  *
- * \param x0 start x postion
- * \param y0 start y postion
- * \param x1 end x postion
- * \param y1 end y postion
- * \param curveX
- * \param curveY
  * \param drawing
- * \param line_path_index value of line (path), to avoid dublicate line value into
- * \return 0
+ * \param min_y first row
+ * \param max_y last row
  */
-int glyph_drawer_paint_curve(float x0, float y0, float x1, float y1, float curveX, float curveY, font_drawing_t *drawing, uint32_t line_path_index)
+void glyph_drawer_add_dirty_rows(font_drawing_t *drawing, int min_y, int max_y)
 {
-    if (fabs(x0 - x1) <= 0 && fabs(y0 - y1) <= 0) {
-        return 0;
+    if (min_y < 0) {
+        min_y = 0;
     }
-    int i, curve_step;
-    float distanceX0 = curveX-x0;
-    float distanceY0 = curveY-y0;
-    float distanceX1 = curveX-x1;
-    float distanceY1 = curveY-y1;
-
-    float positionLineFromBeginning0X;
-    float positionLineFromBeginning0Y;
-    float positionLineFromEnd0X;
-    float positionLineFromEnd0Y;
-
-    float positionLineFromBeginning1X;
-    float positionLineFromBeginning1Y;
-    float positionLineFromEnd1X;
-    float positionLineFromEnd1Y;
-
-    float newX0;
-    float newY0;
-    float newX1;
-    float newY1;
-
-    float prevX0 = x0;
-    float prevY0 = y0;
-    float prevX1 = x1;
-    float prevY1 = y1;
-
-    float difference = fabsf(x0 - x1);
-    float differenceTmp = fabsf(y0 - y1);
-
-    if (difference < differenceTmp) {
-        difference = differenceTmp;
+    if (max_y > drawing->height - 1) {
+        max_y = drawing->height - 1;
     }
-
-    curve_step = (int)(50.0f/difference);
-    if (curve_step <= 1) {
-        curve_step = 1;
+    if (drawing->dirty_min_y > min_y) {
+        drawing->dirty_min_y = min_y;
     }
-    if (curve_step > 25) {
-        curve_step = 25;
+    if (drawing->dirty_max_y < max_y) {
+        drawing->dirty_max_y = max_y;
     }
+}
 
-    for (i=curve_step;i<50;i+=curve_step) {
-        positionLineFromBeginning0X =  distanceX0*(float)(i)/100.0f + x0;
-        positionLineFromBeginning0Y =  distanceY0*(float)(i)/100.0f + y0;
-        positionLineFromBeginning1X =  distanceX1*(float)(i)/100.0f + x1;
-        positionLineFromBeginning1Y =  distanceY1*(float)(i)/100.0f + y1;
-
-        positionLineFromEnd0X = distanceX0*(float)(100-i)/100.0f + x0;
-        positionLineFromEnd0Y = distanceY0*(float)(100-i)/100.0f + y0;
-        positionLineFromEnd1X = distanceX1*(float)(100-i)/100.0f + x1;
-        positionLineFromEnd1Y = distanceY1*(float)(100-i)/100.0f + y1;
-
-        newX0 = (positionLineFromEnd1X-positionLineFromBeginning0X)*(float)(i)/100.0f + positionLineFromBeginning0X;
-        newY0 = (positionLineFromEnd1Y-positionLineFromBeginning0Y)*(float)(i)/100.0f + positionLineFromBeginning0Y;
-
-        newX1 = (positionLineFromEnd0X-positionLineFromBeginning1X)*(float)(i)/100.0f + positionLineFromBeginning1X;
-        newY1 = (positionLineFromEnd0Y-positionLineFromBeginning1Y)*(float)(i)/100.0f + positionLineFromBeginning1Y;
-
-        glyph_drawer_draw_line((int)newX0, (int)newY0, (int)prevX0, (int)prevY0, drawing, line_path_index);
-        glyph_drawer_draw_line((int)newX1, (int)newY1, (int)prevX1, (int)prevY1, drawing, line_path_index);
+/*!
+ * \brief glyph_drawer_pool_get_px_count
+ *
+ * Get zeroed pixel count buffer, user must zero
+ * the used part of the buffer after the use
+ *
+ * \param pool
+ * \param count
+ * \return buffer of count ints, NULL on failure
+ */
+int *glyph_drawer_pool_get_px_count(glyph_drawer_pool_t *pool, size_t count)
+{
+    void *buffer = pool->list_px_count;
+    const int ret = glyph_drawer_pool_reserve(pool, &buffer, &pool->list_px_count_size, count, sizeof(int));
 
-        prevX0 = newX0;
-        prevY0 = newY0;
-        prevX1 = newX1;
-        prevY1 = newY1;
+    pool->list_px_count = (int *)buffer;
+    if (ret) {
+        return NULL;
     }
-    i = 50;
+    return pool->list_px_count;
+}
 
-    positionLineFromBeginning0X =  distanceX0*(float)(i)/100.0f + x0;
-    positionLineFromBeginning0Y =  distanceY0*(float)(i)/100.0f + y0;
-    positionLineFromBeginning1X =  distanceX1*(float)(i)/100.0f + x1;
-    positionLineFromBeginning1Y =  distanceY1*(float)(i)/100.0f + y1;
+/*!
+ * \brief glyph_drawer_pool_clear
+ *
+ * releases the buffers of the pool
+ *
+ * \param pool
+ */
+void glyph_drawer_pool_clear(glyph_drawer_pool_t *pool)
+{
+    glyph_memory_t *memory = pool->memory;
+
+    free(pool->list_plane);
+    free(pool->list_path_index);
+    free(pool->list_px_count);
+    glyph_memory_release(memory, pool->list_plane_size*sizeof(uint64_t)
+                         + pool->list_path_index_size*sizeof(glyph_drawer_path_index_t)
+                         + pool->list_px_count_size*sizeof(int));
+    memset(pool, 0, sizeof(glyph_drawer_pool_t));
+    pool->memory = memory;
+}
 
-    newX0 = (positionLineFromBeginning0X + positionLineFromBeginning1X)/2.0f;
-    newY0 = (positionLineFromBeginning0Y + positionLineFromBeginning1Y)/2.0f;
+/*!
+ * \brief glyph_drawer_get_pixel
+ *
+ * Get values of the pixel from the planes
+ *
+ * \param drawing
+ * \param x
+ * \param y
+ * \return values of the pixel
+ */
+pixel_drawing_t glyph_drawer_get_pixel(const font_drawing_t *drawing, int x, int y)
+{
+    pixel_drawing_t pixel;
+    memset(&pixel, 0, sizeof(pixel));
+    if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE_CROSSING, x, y)) {
+        pixel.line = 2;
+    } else if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x, y)) {
+        pixel.line = 1;
+    }
+    if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x, y)) {
+        pixel.inner_pixel = 1;
+    }
+    if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_OUTER, x, y)) {
+        pixel.outer_pixel = 1;
+    }
+    if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_X, x, y)) {
+        pixel.completed_x = 1;
+    }
+    if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, x, y)) {
+        pixel.completed_y = 1;
+    }
+    if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, x, y)) {
+        pixel.line_completed = 1;
+    }
+    return pixel;
+}
 
+/*!
+ * \brief glyph_drawer_find_path_index
+ *
+ * Find the slot of the pixel from the path index hash table
+ *
+ * \param list_path_index
+ * \param size size of the table, power of two
+ * \param key pixel index + 1
+ * \return slot that has the key or the empty slot for the key
+ */
+static glyph_drawer_path_index_t *glyph_drawer_find_path_index(glyph_drawer_path_index_t *list_path_index,
+                                                               uint32_t size, uint32_t key)
+{
+    uint32_t i = (key*2654435761u) & (size - 1);
+    while (list_path_index[i].key && list_path_index[i].key != key) {
+        i = (i + 1) & (size - 1);
+    }
+    return &list_path_index[i];
+}
 
-   glyph_drawer_draw_line((int)newX0, (int)newY0, (int)prevX0, (int)prevY0, drawing, line_path_index);
-   glyph_drawer_draw_line((int)newX0, (int)newY0, (int)prevX1, (int)prevY1, drawing, line_path_index);
+/*!
+ * \brief glyph_drawer_enlarge_path_index
+ *
+ * Doubles the size of the path index hash table
+ *
+ * \param drawing
+ * \return 0 on success
+ */
+static int glyph_drawer_enlarge_path_index(font_drawing_t *drawing)
+{
+    uint32_t i;
+    const uint32_t size = drawing->list_path_index_size*2;
+    glyph_memory_t *memory = drawing->pool ? drawing->pool->memory : NULL;
+    glyph_drawer_path_index_t *list_path_index;
+
+    // size must be power of two and the old table is copied, so both are counted
+    if (glyph_memory_reserve(memory, size, sizeof(glyph_drawer_path_index_t))) {
+        return ENOMEM;
+    }
+    list_path_index = (glyph_drawer_path_index_t *)calloc(size, sizeof(glyph_drawer_path_index_t));
+    if (!list_path_index) {
+        glyph_memory_release(memory, size*sizeof(glyph_drawer_path_index_t));
+        return ENOMEM;
+    }
+    for (i=0;i<drawing->list_path_index_size;i++) {
+        if (drawing->list_path_index[i].key) {
+            *glyph_drawer_find_path_index(list_path_index, size, drawing->list_path_index[i].key) = drawing->list_path_index[i];
+        }
+    }
+    free(drawing->list_path_index);
+    glyph_memory_release(memory, drawing->list_path_index_size*sizeof(glyph_drawer_path_index_t));
+    drawing->list_path_index = list_path_index;
+    drawing->list_path_index_size = size;
+    // larger table is kept in the pool
+    if (drawing->pool) {
+        drawing->pool->list_path_index = list_path_index;
+        drawing->pool->list_path_index_size = size;
+    }
+    return 0;
+}
 
-   return 0;
+/*!
+ * \brief glyph_drawer_paint_curve
+ *
+ * drawing the quadratic bezier curve as lines, the lines
+ * are got from glyph_flatten_next()
+ *
+ * \param x0 start x postion
+ * \param y0 start y postion
+ * \param x1 end x postion
+ * \param y1 end y postion
+ * \param curveX
+ * \param curveY
+ * \param tolerance max distance between the curve and its lines (in pixels of the drawing)
+ * \param drawing
+ * \param line_path_index value of line (path), to avoid dublicate line value into
+ * \return 0 on success
+ */
+int glyph_drawer_paint_curve(float x0, float y0, float x1, float y1, float curveX, float curveY,
+                             float tolerance, font_drawing_t *drawing, uint32_t line_path_index)
+{
+    if (fabs(x0 - x1) <= 0 && fabs(y0 - y1) <= 0) {
+        return 0;
+    }
+    int ret;
+    float x, y;
+    float prev_x = x0, prev_y = y0;
+    glyph_flatten_t flatten;
+
+    glyph_flatten_init(&flatten, x0, y0, x1, y1, curveX, curveY, tolerance, GLYPH_DRAWER_MAX_CURVE_LINES);
+    while (glyph_flatten_next(&flatten, &x, &y)) {
+        // lines are drawn from the new point to the previous point, pixels of
+        // glyph_drawer_draw_line() depend on the direction
+        ret = glyph_drawer_draw_line((int)x, (int)y, (int)prev_x, (int)prev_y, drawing, line_path_index);
+        if (ret) {
+            return ret;
+        }
+        prev_x = x;
+        prev_y = y;
+    }
+    return 0;
 }
 
 /*!
@@ -157,55 +416,110 @@ int glyph_drawer_paint_curve(float x0, float y0, float x1, float y1, float curve
  *
  * Add/set line pixel into x/y
  *
- * \param x
- * \param y
  * \param drawing
+ * \param word index of the word of the pixel in the planes
+ * \param bit bit of the pixel in the word
+ * \param key pixel index + 1
  * \param line_path_index to avoid line++ if the pixel is got line from previous line
  * -> this can happen in cross"roads" and curves
+ * \return 0 on success
  */
 #ifndef TEST_CASE
 static
 #endif
-void glyph_drawer_add_line_value(int x, int y, font_drawing_t *drawing, uint32_t line_path_index)
+int glyph_drawer_add_line_value(font_drawing_t *drawing, int word, uint64_t bit, uint32_t key, uint32_t line_path_index)
 {
-    int pixel_index = y*drawing->width+x;
+    int ret, y;
+    glyph_drawer_path_index_t *path_index;
+
+    // line count is only needed by glyph_filler
+    if (drawing->tiles) {
+        y = word/drawing->row_words;
+        return glyph_tiles_set(drawing->tiles, word - y*drawing->row_words, y, bit);
+    }
+
     // if line count == 2 -> no need to continue
-    if (drawing->list_pixels[pixel_index].line == 2) {
-        return;
+    if (drawing->list_plane[GLYPH_DRAWER_PLANE_LINE_CROSSING][word] & bit) {
+        return 0;
     }
 
-    if (drawing->list_pixels[pixel_index].line == 1) {
-        if (line_path_index != drawing->list_pixels[pixel_index].previous_line_path_index) {
-            drawing->list_pixels[pixel_index].line++;
+    if (drawing->list_plane[GLYPH_DRAWER_PLANE_LINE][word] & bit) {
+        path_index = glyph_drawer_find_path_index(drawing->list_path_index, drawing->list_path_index_size, key);
+        if (line_path_index != path_index->path_index) {
+            drawing->list_plane[GLYPH_DRAWER_PLANE_LINE_CROSSING][word] |= bit;
+        }
+        return 0;
+    }
+
+    // hash table is kept at most half full
+    if (drawing->list_path_index_count*2 >= drawing->list_path_index_size) {
+        ret = glyph_drawer_enlarge_path_index(drawing);
+        if (ret) {
+            return ret;
         }
-        return;
     }
 
     // line pixel is new
+    drawing->list_plane[GLYPH_DRAWER_PLANE_LINE][word] |= bit;
+    path_index = glyph_drawer_find_path_index(drawing->list_path_index, drawing->list_path_index_size, key);
+    path_index->key = key;
+    path_index->path_index = line_path_index;
+    drawing->list_path_index_count++;
+    return 0;
+}
+
+/*!
+ * \brief glyph_drawer_add_line_area
+ *
+ * Enlarge line min/max x/y by the line x0/y0 - x1/y1,
+ * all pixels of the line are between its end points
+ *
+ * \param drawing
+ * \param x0
+ * \param y0
+ * \param x1
+ * \param y1
+ */
+static void glyph_drawer_add_line_area(font_drawing_t *drawing, int x0, int y0, int x1, int y1)
+{
+    const int min_x = x0 < x1 ? x0 : x1;
+    const int max_x = x0 < x1 ? x1 : x0;
+    const int min_y = y0 < y1 ? y0 : y1;
+    const int max_y = y0 < y1 ? y1 : y0;
+
+    glyph_drawer_add_dirty_rows(drawing, min_y, max_y);
+
     if (!drawing->line_max_x && !drawing->line_max_y) {
-        // first line pixel ever
-        drawing->line_min_x = x;
-        drawing->line_max_x = x;
-        drawing->line_min_y = y;
-        drawing->line_max_y = y;
-    } else {
-        // not first pixel line ever, so check min/max x/y
-        if (drawing->line_min_x > x) {
-            drawing->line_min_x = x;
-        }
-        if (drawing->line_min_y > y) {
-            drawing->line_min_y = y;
-        }
-        if (drawing->line_max_x < x) {
-            drawing->line_max_x = x;
-        }
-        if (drawing->line_max_y < y) {
-            drawing->line_max_y = y;
-        }
+        // first line ever
+        drawing->line_min_x = min_x;
+        drawing->line_max_x = max_x;
+        drawing->line_min_y = min_y;
+        drawing->line_max_y = max_y;
+        return;
     }
+    // not first line ever, so check min/max x/y
+    if (drawing->line_min_x > min_x) {
+        drawing->line_min_x = min_x;
+    }
+    if (drawing->line_min_y > min_y) {
+        drawing->line_min_y = min_y;
+    }
+    if (drawing->line_max_x < max_x) {
+        drawing->line_max_x = max_x;
+    }
+    if (drawing->line_max_y < max_y) {
+        drawing->line_max_y = max_y;
+    }
+}
 
-    drawing->list_pixels[pixel_index].line = 1;
-    drawing->list_pixels[pixel_index].previous_line_path_index = line_path_index;
+/*!
+ * \brief glyph_drawer_sign
+ * \param value
+ * \return -1, 0 or 1
+ */
+static int glyph_drawer_sign(int value)
+{
+    return (value > 0) - (value < 0);
 }
 
 /*!
@@ -213,6 +527,10 @@ void glyph_drawer_add_line_value(int x, int y, font_drawing_t *drawing, uint32_t
  *
  * Drawing the line between x0/y0 to x1/y1
  *
+ * Line is walked along its longer axis, the shorter axis
+ * is stepped when the remainder exceeds the length, so the pixels
+ * are same as floor(step*shorter/longer) without the divisions
+ *
  * \param x0
  * \param y0
  * \param x1
@@ -223,109 +541,80 @@ void glyph_drawer_add_line_value(int x, int y, font_drawing_t *drawing, uint32_t
  */
 int glyph_drawer_draw_line(int x0, int y0, int x1, int y1, font_drawing_t *drawing, uint32_t line_path_index)
 {
-    if (x0 >= drawing->width || x1 >= drawing->width || y0 >= drawing->height || y1 >= drawing->height) {
+    if (x0 >= drawing->width || x1 >= drawing->width || y0 >= drawing->height || y1 >= drawing->height
+            || x0 < 0 || x1 < 0 || y0 < 0 || y1 < 0) {
         return 0;
     }
 
-    int x;
-    int y;
-
-    if (x0 == x1) {
-        if (y0 == y1) {
-            glyph_drawer_add_line_value(x0, y0, drawing, line_path_index);
-        } else if (y0 < y1) {
-            for (y=y0;y<=y1;y++) {
-                glyph_drawer_add_line_value(x0, y, drawing, line_path_index);
-            }
+    int ret;
+    int i;
+    int x, y, word;
+    int length, minor_length;
+    int remainder = 0;
+    int major_x = 0, major_y = 0;
+    int minor_x = 0, minor_y = 0;
+    uint32_t key;
+    const int w_x = abs(x1 - x0);
+    const int w_y = abs(y1 - y0);
+
+    glyph_drawer_add_line_area(drawing, x0, y0, x1, y1);
+
+    // start point and the directions keep the rounding of each direction
+    if (w_y >= w_x) {
+        length = w_y;
+        minor_length = w_x;
+        if (y0 <= y1) {
+            x = x0;
+            y = y0;
+            major_y = 1;
+            minor_x = glyph_drawer_sign(x1 - x0);
+        } else if (x0 <= x1) {
+            x = x1;
+            y = y1;
+            major_y = 1;
+            minor_x = -1;
         } else {
-            for (y=y1;y<=y0;y++) {
-                glyph_drawer_add_line_value(x0, y, drawing, line_path_index);
-            }
+            x = x0;
+            y = y0;
+            major_y = -1;
+            minor_x = -1;
         }
-        return 0;
-    }
-
-    if (y0 == y1) {
+    } else {
+        length = w_x;
+        minor_length = w_y;
+        major_x = 1;
         if (x0 < x1) {
-            for (x=x0;x<=x1;x++) {
-                glyph_drawer_add_line_value(x, y0, drawing, line_path_index);
-            }
+            x = x0;
+            y = y0;
+            minor_y = glyph_drawer_sign(y1 - y0);
         } else {
-            for (x=x1;x<=x0;x++) {
-                glyph_drawer_add_line_value(x, y0, drawing, line_path_index);
-            }
+            x = x1;
+            y = y1;
+            minor_y = glyph_drawer_sign(y0 - y1);
         }
-        return 0;
     }
 
-    int wY;
-    int wX;
-    if (x0 < x1) {
-        if (y0 < y1) {
-            wX = x1 - x0;
-            wY = y1 - y0;
-            if (wY >= wX) {
-                for (y=y0;y<=y1;y++) {
-                    x = (y-y0)*wX/wY + x0;
-                    glyph_drawer_add_line_value(x, y, drawing, line_path_index);
-                }
-            } else {
-                for (x=x0;x<=x1;x++) {
-                    y = (x-x0)*wY/wX + y0;
-                    glyph_drawer_add_line_value(x, y, drawing, line_path_index);
-                }
-            }
-        } else {
-            wX = x1 - x0;
-            wY = y0 - y1;
-            if (wY >= wX) {
-                for (y=y1;y<=y0;y++) {
-                    x = x1 - (y-y1)*wX/wY;
-                    glyph_drawer_add_line_value(x, y, drawing, line_path_index);
-                }
-            } else {
-                for (x=x0;x<=x1;x++) {
-                    y = y0 - (x-x0)*wY/wX;
-                    glyph_drawer_add_line_value(x, y, drawing, line_path_index);
-                }
-            }
+    // word is the offset of the row in the planes, key is the pixel index + 1
+    word = y*drawing->row_words;
+    key = (uint32_t)(y*drawing->width + x) + 1;
+    for (i=0;;i++) {
+        ret = glyph_drawer_add_line_value(drawing, word + (x >> 6), (uint64_t)1 << (x & 63), key, line_path_index);
+        if (ret) {
+            return ret;
         }
-        return 0;
-    }
-
-    if (x0 > x1) {
-        if (y0 < y1) {
-            wX = x0 - x1;
-            wY = y1 - y0;
-            if (wY >= wX) {
-                for (y=y0;y<=y1;y++) {
-                    x = x0 - (y-y0)*wX/wY;
-                    glyph_drawer_add_line_value(x, y, drawing, line_path_index);
-                }
-            } else {
-                for (x=x1;x<=x0;x++) {
-                    y = y1 - (x-x1)*wY/wX;
-                    glyph_drawer_add_line_value(x, y, drawing, line_path_index);
-                }
-            }
+        if (i == length) {
+            break;
         }
-        else {
-            wX = x0 - x1;
-            wY = y0 - y1;
-            if (wY >= wX) {
-                for (y=y1;y<=y0;y++) {
-                    x = x0 - (y-y1)*wX/wY;
-                    glyph_drawer_add_line_value(x, y0-(y-y1), drawing, line_path_index);
-                }
-            } else {
-                for (x=x1;x<=x0;x++) {
-                    y = y0 - (x-x1)*wY/wX;
-                    glyph_drawer_add_line_value(x, y1-(y-y0), drawing, line_path_index);
-                }
-            }
+        x += major_x;
+        word += major_y*drawing->row_words;
+        key += (uint32_t)(major_y*drawing->width + major_x);
+        remainder += minor_length;
+        if (remainder >= length) {
+            remainder -= length;
+            x += minor_x;
+            word += minor_y*drawing->row_words;
+            key += (uint32_t)(minor_y*drawing->width + minor_x);
         }
-        return 0;
     }
-
-    return EPERM;
+    return 0;
 }
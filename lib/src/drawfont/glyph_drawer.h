@@ -14,15 +14,60 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "glyph_tiles.h"
+
+/*!
+ * \brief max distance between the curve and its lines
+ * in the pixels of the final image (not in pixels of the drawing)
+ */
+#define GLYPH_DRAWER_CURVE_TOLERANCE    0.05f
+
+/*!
+ * \brief max count of the lines of a single curve
+ */
+#define GLYPH_DRAWER_MAX_CURVE_LINES    256
+
+/*!
+ * \brief bit planes of the font_drawing_t
+ *
+ * GLYPH_DRAWER_PLANE_LINE is set for the line pixels and
+ * GLYPH_DRAWER_PLANE_LINE_CROSSING when the pixel is got
+ * line from two different paths (line value 2)
+ */
+#define GLYPH_DRAWER_PLANE_LINE             0
+#define GLYPH_DRAWER_PLANE_LINE_CROSSING    1
+#define GLYPH_DRAWER_PLANE_INNER            2
+#define GLYPH_DRAWER_PLANE_OUTER            3
+#define GLYPH_DRAWER_PLANE_COMPLETED_X      4
+#define GLYPH_DRAWER_PLANE_COMPLETED_Y      5
+#define GLYPH_DRAWER_PLANE_LINE_COMPLETED   6
+#define GLYPH_DRAWER_PLANE_COUNT            7
+
+/*!
+ * \brief pointer to the first word of the row y in the plane
+ */
+#define GLYPH_DRAWER_ROW(drawing, plane, y) \
+    (&(drawing)->list_plane[plane][(y)*(drawing)->row_words])
+
+/*!
+ * \brief 1 if the bit of the pixel x/y is set in the plane
+ */
+#define GLYPH_DRAWER_GET(drawing, plane, x, y) \
+    ((int)((GLYPH_DRAWER_ROW(drawing, plane, y)[(x) >> 6] >> ((x) & 63)) & 1))
+
+/*!
+ * \brief sets the bit of the pixel x/y in the plane
+ */
+#define GLYPH_DRAWER_SET(drawing, plane, x, y) \
+    (GLYPH_DRAWER_ROW(drawing, plane, y)[(x) >> 6] |= (uint64_t)1 << ((x) & 63))
 
 /*!
  * \brief The pixel_drawing_t struct
  *
- * this is for drawing the glyph image data
+ * values of the single pixel, see glyph_drawer_get_pixel()
  */
 typedef struct {
     uint8_t line : 2;
-    uint32_t previous_line_path_index;
     uint8_t inner_pixel : 1;
     uint8_t outer_pixel : 1;
     uint8_t completed_x : 1;
@@ -30,10 +75,40 @@ typedef struct {
     uint8_t line_completed : 1;
 } pixel_drawing_t;
 
+/*!
+ * \brief The glyph_drawer_path_index_t struct
+ *
+ * path index of the line pixel (key is pixel index + 1, 0 is unused)
+ */
+typedef struct {
+    uint32_t key;
+    uint32_t path_index;
+} glyph_drawer_path_index_t;
+
+/*!
+ * \brief The glyph_drawer_pool_t struct
+ *
+ * buffers of the drawing that are kept between the glyphs,
+ * buffers are grown geometrically and they are zero when they
+ * are not used, glyph_drawer_clear() zeroes only the used rows
+ */
+typedef struct
+{
+    uint64_t *list_plane;
+    size_t list_plane_size;     // count of uint64_t
+    glyph_drawer_path_index_t *list_path_index;
+    uint32_t list_path_index_size;
+    int *list_px_count;         // pixel counts of glyph_image_add_glyph_into_image()
+    size_t list_px_count_size;
+    glyph_memory_t *memory;     // buffers are counted in this, NULL if there is no limit
+} glyph_drawer_pool_t;
+
 /*!
  * \brief The font_drawing_t struct
  *
- * this is for drawing the glyph image data
+ * this is for drawing the glyph image data, each value of
+ * the pixels is in own bit plane (1 bit per pixel) and the
+ * path indexes are only stored for the line pixels
  */
 typedef struct
 {
@@ -41,13 +116,26 @@ typedef struct
     int height;
     int line_min_x, line_max_x;
     int line_min_y, line_max_y;
-    pixel_drawing_t *list_pixels;
+    int row_words;      // count of uint64_t of single row in each plane
+    uint64_t *list_plane[GLYPH_DRAWER_PLANE_COUNT];
+    glyph_drawer_path_index_t *list_path_index;     // hash table
+    uint32_t list_path_index_count;
+    uint32_t list_path_index_size;  // power of two
+    int dirty_min_y, dirty_max_y;   // rows that may have set bits
+    glyph_drawer_pool_t *pool;      // pool of the buffers, NULL if the buffers are allocated by calloc
+    glyph_tiles_t *tiles;           // line pixels are set into the tiles instead of the planes, NULL if not used
 } font_drawing_t;
 
-int glyph_drawer_init(font_drawing_t *drawing, int width, int height);
+int glyph_drawer_init(font_drawing_t *drawing, int width, int height, glyph_drawer_pool_t *pool);
+void glyph_drawer_init_tiles(font_drawing_t *drawing, glyph_tiles_t *tiles);
 void glyph_drawer_clear(font_drawing_t *drawing);
+void glyph_drawer_add_dirty_rows(font_drawing_t *drawing, int min_y, int max_y);
+int *glyph_drawer_pool_get_px_count(glyph_drawer_pool_t *pool, size_t count);
+void glyph_drawer_pool_clear(glyph_drawer_pool_t *pool);
+pixel_drawing_t glyph_drawer_get_pixel(const font_drawing_t *drawing, int x, int y);
 
-int glyph_drawer_paint_curve(float x0, float y0, float x1, float y1, float curveX, float curveY, font_drawing_t *drawing, uint32_t line_index);
+int glyph_drawer_paint_curve(float x0, float y0, float x1, float y1, float curveX, float curveY,
+                             float tolerance, font_drawing_t *drawing, uint32_t line_index);
 int glyph_drawer_draw_line(int x0, int y0, int x1, int y1, font_drawing_t *drawing, uint32_t line_index);
 
 #endif // GLYPH_DRAWER_H
@@ -18,21 +18,184 @@
 #endif
 
 /*!
- * \brief glyph_filler_get_pixel
- * \param drawing
- * \param x
- * \param y
- * \return
+ * \brief glyph_filler_lowest_bit
+ * \param bits not zero
+ * \return index of the lowest set bit
+ */
+static int glyph_filler_lowest_bit(uint64_t bits)
+{
+#ifdef __GNUC__
+    return __builtin_ctzll(bits);
+#else
+    int i = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/*!
+ * \brief glyph_filler_highest_bit
+ * \param bits not zero
+ * \return index of the highest set bit
+ */
+static int glyph_filler_highest_bit(uint64_t bits)
+{
+#ifdef __GNUC__
+    return 63 - __builtin_clzll(bits);
+#else
+    int i = 63;
+    while (!(bits >> 63)) {
+        bits <<= 1;
+        i--;
+    }
+    return i;
+#endif
+}
+
+/*!
+ * \brief glyph_filler_word_mask
+ * \param word index of the word in the row
+ * \param x0 first x
+ * \param x1 end x (not included)
+ * \return bits of the word that are in x0 - x1
  */
-pixel_drawing_t *glyph_filler_get_pixel(font_drawing_t *drawing, int x, int y)
+static uint64_t glyph_filler_word_mask(int word, int x0, int x1)
 {
-    return &drawing->list_pixels[y*drawing->width+x];
+    uint64_t mask = ~(uint64_t)0;
+    const int first_x = word*64;
+
+    if (x0 > first_x) {
+        mask &= ~(uint64_t)0 << (x0 - first_x);
+    }
+    if (x1 < first_x + 64) {
+        mask &= ~(~(uint64_t)0 << (x1 - first_x));
+    }
+    return mask;
+}
+
+/*!
+ * \brief glyph_filler_set_bits
+ *
+ * sets bits x0 - x1 of the row
+ *
+ * \param row
+ * \param x0 first x
+ * \param x1 end x (not included)
+ */
+static void glyph_filler_set_bits(uint64_t *row, int x0, int x1)
+{
+    int word;
+    if (x0 >= x1) {
+        return;
+    }
+    for (word=x0 >> 6;word<=(x1-1) >> 6;word++) {
+        row[word] |= glyph_filler_word_mask(word, x0, x1);
+    }
+}
+
+/*!
+ * \brief glyph_filler_next_pixel
+ *
+ * Find next pixel which is set in the row but not in row_not
+ *
+ * \param row
+ * \param row_not
+ * \param x first x to check
+ * \param end_x
+ * \return x of the pixel, end_x if not found
+ */
+static int glyph_filler_next_pixel(const uint64_t *row, const uint64_t *row_not, int x, int end_x)
+{
+    int word, last_word;
+    uint64_t bits;
+
+    if (x >= end_x) {
+        return end_x;
+    }
+    word = x >> 6;
+    last_word = (end_x-1) >> 6;
+    bits = row[word] & ~row_not[word] & glyph_filler_word_mask(word, x, end_x);
+    while (!bits) {
+        word++;
+        if (word > last_word) {
+            return end_x;
+        }
+        bits = row[word] & ~row_not[word] & glyph_filler_word_mask(word, x, end_x);
+    }
+    return word*64 + glyph_filler_lowest_bit(bits);
+}
+
+/*!
+ * \brief glyph_filler_next_stop
+ *
+ * Find next pixel which is set in row_a or row_b
+ *
+ * \param row_a
+ * \param row_b
+ * \param x first x to check
+ * \param end_x
+ * \return x of the pixel, end_x if not found
+ */
+static int glyph_filler_next_stop(const uint64_t *row_a, const uint64_t *row_b, int x, int end_x)
+{
+    int word, last_word;
+    uint64_t bits;
+
+    if (x >= end_x) {
+        return end_x;
+    }
+    word = x >> 6;
+    last_word = (end_x-1) >> 6;
+    bits = (row_a[word] | row_b[word]) & glyph_filler_word_mask(word, x, end_x);
+    while (!bits) {
+        word++;
+        if (word > last_word) {
+            return end_x;
+        }
+        bits = (row_a[word] | row_b[word]) & glyph_filler_word_mask(word, x, end_x);
+    }
+    return word*64 + glyph_filler_lowest_bit(bits);
+}
+
+/*!
+ * \brief glyph_filler_previous_stop
+ *
+ * Find previous pixel which is set in row_a or row_b
+ *
+ * \param row_a
+ * \param row_b
+ * \param x first x to check
+ * \param start_x smallest x to check
+ * \return x of the pixel, start_x-1 if not found
+ */
+static int glyph_filler_previous_stop(const uint64_t *row_a, const uint64_t *row_b, int x, int start_x)
+{
+    int word, first_word;
+    uint64_t bits;
+
+    if (x < start_x) {
+        return start_x-1;
+    }
+    word = x >> 6;
+    first_word = start_x >> 6;
+    bits = (row_a[word] | row_b[word]) & glyph_filler_word_mask(word, start_x, x+1);
+    while (!bits) {
+        word--;
+        if (word < first_word) {
+            return start_x-1;
+        }
+        bits = (row_a[word] | row_b[word]) & glyph_filler_word_mask(word, start_x, x+1);
+    }
+    return word*64 + glyph_filler_highest_bit(bits);
 }
 
 /*!
  * \brief glyph_filler_enlarge_inner_area
  *
- * enlarge inner area
+ * enlarge inner area, rows are handled 64 pixels at once
  *
  * \param drawing
  * \return
@@ -42,87 +205,84 @@ static uint8_t glyph_filler_enlarge_inner_area(font_drawing_t *drawing)
     int x_plus;
     int y_plus;
     int x, y;
-    int pixel_index;
-    pixel_drawing_t *pixel;
+    uint64_t *row_inner;
+    uint64_t *row_completed;
+    const uint64_t *row_line;
     uint8_t increased = 0;
 
     for (y=drawing->line_min_y+1;y<drawing->line_max_y;y++) {
-        pixel_index = y*drawing->width + drawing->line_min_x + 1;
-        for (x=drawing->line_min_x+1;x<drawing->line_max_x;x++) {
-            if (drawing->list_pixels[pixel_index].completed_y
-                    || !drawing->list_pixels[pixel_index].inner_pixel) {
-                pixel_index++;
-                continue;
-            }
-
-            drawing->list_pixels[pixel_index].completed_y = 1;
+        row_inner = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_INNER, y);
+        row_completed = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, y);
+        for (x=glyph_filler_next_pixel(row_inner, row_completed, drawing->line_min_x+1, drawing->line_max_x);
+             x<drawing->line_max_x;
+             x=glyph_filler_next_pixel(row_inner, row_completed, x+1, drawing->line_max_x)) {
+            GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, x, y);
             for (y_plus=y+1;y_plus<drawing->line_max_y;y_plus++) {
-                pixel = glyph_filler_get_pixel(drawing, x, y_plus);
-                if (pixel->line || pixel->inner_pixel) {
+                if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x, y_plus)
+                        || GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x, y_plus)) {
                     break;
                 }
 
-                pixel->completed_y = 1;
-                pixel->inner_pixel = 1;
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, x, y_plus);
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_INNER, x, y_plus);
                 increased = 1;
             }
 
             for (y_plus=y-1;y_plus>drawing->line_min_y;y_plus--) {
-                pixel = glyph_filler_get_pixel(drawing, x, y_plus);
-                if (pixel->line || pixel->inner_pixel) {
+                if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x, y_plus)
+                        || GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x, y_plus)) {
                     break;
                 }
 
-                pixel->completed_y = 1;
-                pixel->inner_pixel = 1;
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, x, y_plus);
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_INNER, x, y_plus);
                 increased = 1;
             }
-            pixel_index++;
         }
     }
 
     for (y=drawing->line_min_y+1;y<drawing->line_max_y;y++) {
-        pixel_index = y*drawing->width + drawing->line_min_x + 1;
-        for (x=drawing->line_min_x+1;x<drawing->line_max_x;x++) {
-            if (drawing->list_pixels[pixel_index].completed_x
-                    || !drawing->list_pixels[pixel_index].inner_pixel) {
-                pixel_index++;
-                continue;
-            }
-
-            drawing->list_pixels[pixel_index].completed_x = 1;
-            for (x_plus=x+1;x_plus<drawing->line_max_x;x_plus++) {
-                pixel = glyph_filler_get_pixel(drawing, x_plus, y);
-                if (pixel->line || pixel->inner_pixel) {
-                    break;
-                }
-
-                pixel->completed_x = 1;
-                pixel->inner_pixel = 1;
+        row_inner = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_INNER, y);
+        row_completed = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_X, y);
+        row_line = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y);
+        for (x=glyph_filler_next_pixel(row_inner, row_completed, drawing->line_min_x+1, drawing->line_max_x);
+             x<drawing->line_max_x;
+             x=glyph_filler_next_pixel(row_inner, row_completed, x+1, drawing->line_max_x)) {
+            GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_X, x, y);
+
+            // pixels until the next line or inner pixel
+            x_plus = glyph_filler_next_stop(row_line, row_inner, x+1, drawing->line_max_x);
+            if (x_plus > x+1) {
+                glyph_filler_set_bits(row_completed, x+1, x_plus);
+                glyph_filler_set_bits(row_inner, x+1, x_plus);
                 increased = 1;
             }
 
-            for (x_plus=x-1;x_plus>drawing->line_min_x;x_plus--) {
-                pixel = glyph_filler_get_pixel(drawing, x_plus, y);
-                if (pixel->line || pixel->inner_pixel) {
-                    break;
-                }
-
-                pixel->completed_x = 1;
-                pixel->inner_pixel = 1;
+            x_plus = glyph_filler_previous_stop(row_line, row_inner, x-1, drawing->line_min_x+1);
+            if (x_plus < x-1) {
+                glyph_filler_set_bits(row_completed, x_plus+1, x);
+                glyph_filler_set_bits(row_inner, x_plus+1, x);
                 increased = 1;
             }
-            pixel_index++;
         }
     }
 
     return increased;
 }
 
+/*!
+ * \brief glyph_filler_enlarge_outer_area_first
+ *
+ * set outer area from the edges until the line,
+ * columns are handled 64 pixels at once
+ *
+ * \param drawing
+ */
 static void glyph_filler_enlarge_outer_area_first(font_drawing_t *drawing)
 {
-    int x, y;
-    int pixel_index;
+    int x, y, word;
+    uint64_t open;
+    const uint64_t *row_line;
 
     int start_x = drawing->line_min_x;
     int end_x = drawing->line_max_x;
@@ -143,59 +303,39 @@ static void glyph_filler_enlarge_outer_area_first(font_drawing_t *drawing)
     }
 
     for (y=start_y;y<end_y;y++) {
-        pixel_index = y*drawing->width + start_x;
-        for (x=start_x;x<end_x;x++) {
-            if (!drawing->list_pixels[pixel_index].line) {
-                drawing->list_pixels[pixel_index].outer_pixel = 1;
-                if (x > start_x) {
-                    drawing->list_pixels[pixel_index-1].completed_x = 1;
-                }
-            } else {
-                break;
-            }
-            pixel_index++;
-        }
-    }
+        row_line = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y);
 
-    for (x=start_x;x<end_x;x++) {
-        for (y=start_y;y<end_y;y++) {
-            pixel_index = y*drawing->width + x;
-            if (!drawing->list_pixels[pixel_index].line) {
-                drawing->list_pixels[pixel_index].outer_pixel = 1;
-                if (y > start_y) {
-                    drawing->list_pixels[pixel_index-drawing->width].completed_y = 1;
-                }
-            } else {
-                break;
-            }
-        }
+        // from left until the first line pixel
+        x = glyph_filler_next_stop(row_line, row_line, start_x, end_x);
+        glyph_filler_set_bits(GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_OUTER, y), start_x, x);
+        glyph_filler_set_bits(GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_X, y), start_x, x-1);
+
+        // from right until the last line pixel
+        x = glyph_filler_previous_stop(row_line, row_line, end_x-1, start_x);
+        glyph_filler_set_bits(GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_OUTER, y), x+1, end_x);
+        glyph_filler_set_bits(GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_X, y), x+2, end_x);
     }
 
-    for (y=start_y;y<end_y;y++) {
-        pixel_index = y*drawing->width + end_x-1;
-        for (x=end_x-1;x>=start_x;x--) {
-            if (!drawing->list_pixels[pixel_index].line) {
-                drawing->list_pixels[pixel_index].outer_pixel = 1;
-                if (x < end_x-1) {
-                    drawing->list_pixels[pixel_index+1].completed_x = 1;
-                }
-            } else {
-                break;
+    if (start_x >= end_x) {
+        return;
+    }
+    for (word=start_x >> 6;word<=(end_x-1) >> 6;word++) {
+        // columns that have not reached the line
+        open = glyph_filler_word_mask(word, start_x, end_x);
+        for (y=start_y;y<end_y && open;y++) {
+            open &= ~GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y)[word];
+            GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_OUTER, y)[word] |= open;
+            if (y > start_y) {
+                GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, y-1)[word] |= open;
             }
-            pixel_index--;
         }
-    }
 
-    for (x=start_x;x<end_x;x++) {
-        for (y=end_y-1;y>=start_y;y--) {
-            pixel_index = y*drawing->width + x;
-            if (!drawing->list_pixels[pixel_index].line) {
-                drawing->list_pixels[pixel_index].outer_pixel = 1;
-                if (y < end_y-1) {
-                    drawing->list_pixels[pixel_index+drawing->width].completed_y = 1;
-                }
-            } else {
-                break;
+        open = glyph_filler_word_mask(word, start_x, end_x);
+        for (y=end_y-1;y>=start_y && open;y--) {
+            open &= ~GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y)[word];
+            GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_OUTER, y)[word] |= open;
+            if (y < end_y-1) {
+                GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, y+1)[word] |= open;
             }
         }
     }
@@ -205,7 +345,7 @@ static void glyph_filler_enlarge_outer_area_first(font_drawing_t *drawing)
 /*!
  * \brief glyph_filler_enlarge_outer_area
  *
- * enlarge outer area
+ * enlarge outer area, rows are handled 64 pixels at once
  *
  * \param drawing
  * \return
@@ -215,8 +355,9 @@ static uint8_t glyph_filler_enlarge_outer_area(font_drawing_t *drawing)
     int x_plus;
     int y_plus;
     int x, y;
-    int pixel_index;
-    pixel_drawing_t *pixel;
+    uint64_t *row_outer;
+    uint64_t *row_completed;
+    const uint64_t *row_line;
     uint8_t increased = 0;
 
     int start_x = drawing->line_min_x;
@@ -238,76 +379,63 @@ static uint8_t glyph_filler_enlarge_outer_area(font_drawing_t *drawing)
     }
 
     for (y=start_y;y<end_y;y++) {
-        for (x=start_x;x<end_x;x++) {
-            pixel_index = y*drawing->width + x;
-            if (drawing->list_pixels[pixel_index].completed_y) {
-                continue;
-            }
-
-
-            if (drawing->list_pixels[pixel_index].outer_pixel) {
-                drawing->list_pixels[pixel_index].completed_y = 1;
-                for (y_plus=y+1;y_plus<end_y;y_plus++) {
-                    pixel = glyph_filler_get_pixel(drawing, x, y_plus);
-                    if (pixel->line || pixel->outer_pixel) {
-                        break;
-                    }
-
-                    pixel->completed_y = 1;
-                    pixel->outer_pixel = 1;
-                    increased = 1;
+        row_outer = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_OUTER, y);
+        row_completed = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, y);
+        for (x=glyph_filler_next_pixel(row_outer, row_completed, start_x, end_x);
+             x<end_x;
+             x=glyph_filler_next_pixel(row_outer, row_completed, x+1, end_x)) {
+            GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, x, y);
+            for (y_plus=y+1;y_plus<end_y;y_plus++) {
+                if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x, y_plus)
+                        || GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_OUTER, x, y_plus)) {
+                    break;
                 }
 
-                for (y_plus=y-1;y_plus>=start_y;y_plus--) {
-                    pixel = glyph_filler_get_pixel(drawing, x, y_plus);
-                    if (pixel->line || pixel->outer_pixel) {
-                        break;
-                    }
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, x, y_plus);
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_OUTER, x, y_plus);
+                increased = 1;
+            }
 
-                    pixel->completed_y = 1;
-                    pixel->outer_pixel = 1;
-                    increased = 1;
+            for (y_plus=y-1;y_plus>=start_y;y_plus--) {
+                if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x, y_plus)
+                        || GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_OUTER, x, y_plus)) {
+                    break;
                 }
+
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_Y, x, y_plus);
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_OUTER, x, y_plus);
+                increased = 1;
             }
         }
     }
 
-    for (x=start_x;x<end_x;x++) {
-        for (y=start_y;y<end_y;y++) {
-            pixel_index = y*drawing->width + x;
-            if (drawing->list_pixels[pixel_index].completed_x) {
-                continue;
+    // each row is enlarged separately, so the rows can be handled in any order
+    for (y=start_y;y<end_y;y++) {
+        row_outer = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_OUTER, y);
+        row_completed = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_COMPLETED_X, y);
+        row_line = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y);
+        for (x=glyph_filler_next_pixel(row_outer, row_completed, start_x, end_x);
+             x<end_x;
+             x=glyph_filler_next_pixel(row_outer, row_completed, x+1, end_x)) {
+            GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_COMPLETED_X, x, y);
+
+            // pixels until the next line or outer pixel
+            x_plus = glyph_filler_next_stop(row_line, row_outer, x+1, end_x);
+            if (x_plus > x+1) {
+                glyph_filler_set_bits(row_completed, x+1, x_plus);
+                glyph_filler_set_bits(row_outer, x+1, x_plus);
+                increased = 1;
             }
 
-
-            if (drawing->list_pixels[pixel_index].outer_pixel) {
-                drawing->list_pixels[pixel_index].completed_x = 1;
-                for (x_plus=x+1;x_plus<end_x;x_plus++) {
-                    pixel = glyph_filler_get_pixel(drawing, x_plus, y);
-                    if (pixel->line || pixel->outer_pixel) {
-                        break;
-                    }
-
-                    pixel->completed_x = 1;
-                    pixel->outer_pixel = 1;
-                    increased = 1;
-                }
-
-                for (x_plus=x-1;x_plus>=start_x;x_plus--) {
-                    pixel = glyph_filler_get_pixel(drawing, x_plus, y);
-                    if (pixel->line || pixel->outer_pixel) {
-                        break;
-                    }
-
-                    pixel->completed_x = 1;
-                    pixel->outer_pixel = 1;
-                    increased = 1;
-                }
+            x_plus = glyph_filler_previous_stop(row_line, row_outer, x-1, start_x);
+            if (x_plus < x-1) {
+                glyph_filler_set_bits(row_completed, x_plus+1, x);
+                glyph_filler_set_bits(row_outer, x_plus+1, x);
+                increased = 1;
             }
         }
     }
 
-
     return increased;
 }
 
@@ -329,22 +457,21 @@ static uint8_t glyph_filler_find_new_inner_areas_secondary(int x, int y, font_dr
     }
 
     uint8_t ret = 0;
-    pixel_drawing_t *pixel_to;
     int x_plus, y_plus;
     for (x_plus=-1;x_plus<2;x_plus++) {
         for (y_plus=-1;y_plus<2;y_plus++) {
             if (x_plus != 0 || y_plus != 0) {
-                pixel_to = glyph_filler_get_pixel(drawing, x+x_plus,  y+y_plus);
-                if (pixel_to->line) {
+                if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x+x_plus, y+y_plus)) {
                     if (distance > 0) {
                         if (glyph_filler_find_new_inner_areas_secondary(x+x_plus,  y+y_plus, drawing, distance-1)) {
                             ret = 1;
                         }
                     }
-                } else if (!pixel_to->outer_pixel && !pixel_to->inner_pixel) {
+                } else if (!GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_OUTER, x+x_plus, y+y_plus)
+                           && !GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x+x_plus, y+y_plus)) {
                     if (x+x_plus >= drawing->line_min_x && y+y_plus >= drawing->line_min_y
                             && x+x_plus < drawing->line_max_x && y+y_plus < drawing->line_max_y) {
-                        pixel_to->inner_pixel = 1;
+                        GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_INNER, x+x_plus, y+y_plus);
                         ret = 1;
                     }
                 }
@@ -365,68 +492,69 @@ static uint8_t glyph_filler_find_new_inner_areas_secondary(int x, int y, font_dr
  */
 static uint8_t glyph_filler_find_new_inner_areas(font_drawing_t *drawing)
 {
-    pixel_drawing_t *pixel;
-    pixel_drawing_t *pixel_to;
     int x, y;
     int x_plus, y_plus;
     uint8_t is_outer_area;
     uint8_t is_inner_area;
     uint8_t ret = 0;
+    const uint64_t *row_line;
+    const uint64_t *row_completed;
     for (y=drawing->line_min_y;y<drawing->line_max_y;y++) {
-        for (x=drawing->line_min_x;x<drawing->line_max_x;x++) {
-            pixel = glyph_filler_get_pixel(drawing, x,  y);
-            if (pixel->line && !pixel->line_completed) {
-                is_outer_area = 0;
-                is_inner_area = 0;
-
-                // check that if there is any "outer area or inner area"
-                // next to line
-                for (x_plus=-1;x_plus<2 && is_outer_area == 0;x_plus++) {
-                    for (y_plus=-1;y_plus<2 && is_outer_area == 0;y_plus++) {
-                        if (x_plus != 0 || y_plus != 0) {
-                            if (x+x_plus >= 0 && y+y_plus >= 0
-                                    && x+x_plus < drawing->width && y+y_plus < drawing->height) {
-                                pixel_to = glyph_filler_get_pixel(drawing, x+x_plus,  y+y_plus);
-                                if (pixel_to->outer_pixel) {
-                                    is_outer_area = 1;
-                                }
-                                if (pixel_to->inner_pixel) {
-                                    is_inner_area = 1;
-                                }
+        row_line = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y);
+        row_completed = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, y);
+        for (x=glyph_filler_next_pixel(row_line, row_completed, drawing->line_min_x, drawing->line_max_x);
+             x<drawing->line_max_x;
+             x=glyph_filler_next_pixel(row_line, row_completed, x+1, drawing->line_max_x)) {
+            is_outer_area = 0;
+            is_inner_area = 0;
+
+            // check that if there is any "outer area or inner area"
+            // next to line
+            for (x_plus=-1;x_plus<2 && is_outer_area == 0;x_plus++) {
+                for (y_plus=-1;y_plus<2 && is_outer_area == 0;y_plus++) {
+                    if (x_plus != 0 || y_plus != 0) {
+                        if (x+x_plus >= 0 && y+y_plus >= 0
+                                && x+x_plus < drawing->width && y+y_plus < drawing->height) {
+                            if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_OUTER, x+x_plus, y+y_plus)) {
+                                is_outer_area = 1;
+                            }
+                            if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x+x_plus, y+y_plus)) {
+                                is_inner_area = 1;
                             }
                         }
                     }
                 }
+            }
 
-                if (is_outer_area) {
-                    pixel->line_completed = 1;
-                    for (x_plus=-1;x_plus<2;x_plus++) {
-                        for (y_plus=-1;y_plus<2;y_plus++) {
-                            if (x_plus != 0 || y_plus != 0) {
-                                if (x+x_plus >= 0 && y+y_plus >= 0
-                                        && x+x_plus >= drawing->line_min_x && y+y_plus >= drawing->line_min_y
-                                        && x+x_plus < drawing->width && y+y_plus < drawing->height
-                                        && x+x_plus < drawing->line_max_x && y+y_plus < drawing->line_max_y) {
-                                    pixel_to = glyph_filler_get_pixel(drawing, x+x_plus,  y+y_plus);
-                                    if (pixel_to->line) {
-                                        if (pixel_to->line > 1 && !pixel_to->line_completed) {
-                                            pixel_to->line_completed = 1;
-                                            if (glyph_filler_find_new_inner_areas_secondary(x+x_plus, y+y_plus, drawing, 1)) {
-                                                ret = 1;
-                                            }
+            if (is_outer_area) {
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, x, y);
+                for (x_plus=-1;x_plus<2;x_plus++) {
+                    for (y_plus=-1;y_plus<2;y_plus++) {
+                        if (x_plus != 0 || y_plus != 0) {
+                            if (x+x_plus >= 0 && y+y_plus >= 0
+                                    && x+x_plus >= drawing->line_min_x && y+y_plus >= drawing->line_min_y
+                                    && x+x_plus < drawing->width && y+y_plus < drawing->height
+                                    && x+x_plus < drawing->line_max_x && y+y_plus < drawing->line_max_y) {
+                                if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x+x_plus, y+y_plus)) {
+                                    if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE_CROSSING, x+x_plus, y+y_plus)
+                                            && !GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, x+x_plus, y+y_plus)) {
+                                        GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, x+x_plus, y+y_plus);
+                                        if (glyph_filler_find_new_inner_areas_secondary(x+x_plus, y+y_plus, drawing, 1)) {
+                                            ret = 1;
                                         }
-                                    } else if (!pixel_to->outer_pixel && !pixel_to->line && !pixel_to->inner_pixel) {
-                                        pixel_to->inner_pixel = 1;
-                                        ret = 1;
                                     }
+                                } else if (!GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_OUTER, x+x_plus, y+y_plus)
+                                           && !GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x+x_plus, y+y_plus)) {
+                                    GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_INNER, x+x_plus, y+y_plus);
+                                    ret = 1;
                                 }
                             }
                         }
                     }
-                } else if (is_inner_area) {
-                    // there was an inner area near by, so it's completed
-                    pixel->line_completed = 1;
                 }
+            } else if (is_inner_area) {
+                // there was an inner area near by, so it's completed
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, x, y);
             }
         }
     }
@@ -444,39 +572,40 @@ static uint8_t glyph_filler_find_new_inner_areas(font_drawing_t *drawing)
  */
 static uint8_t glyph_filler_find_new_outer_areas(font_drawing_t *drawing)
 {
-    pixel_drawing_t *pixel;
-    pixel_drawing_t *pixel_to;
     int x, y;
     int x_plus, y_plus;
     uint8_t is_inner_area;
     uint8_t ret = 0;
+    const uint64_t *row_line;
+    const uint64_t *row_completed;
     for (y=drawing->line_min_y+2;y<drawing->line_max_y-2;y++) {
-        for (x=drawing->line_min_x+2;x<drawing->line_max_x-2;x++) {
-            pixel = glyph_filler_get_pixel(drawing, x,  y);
-            if (pixel->line && !pixel->line_completed) {
-                is_inner_area = 0;
-
-                for (x_plus=-1;x_plus<2 && is_inner_area == 0;x_plus++) {
-                    for (y_plus=-1;y_plus<2 && is_inner_area == 0;y_plus++) {
-                        if (x_plus != 0 || y_plus != 0) {
-                            pixel_to = glyph_filler_get_pixel(drawing, x+x_plus,  y+y_plus);
-                            if (pixel_to->inner_pixel) {
-                                is_inner_area = 1;
-                            }
+        row_line = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y);
+        row_completed = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, y);
+        for (x=glyph_filler_next_pixel(row_line, row_completed, drawing->line_min_x+2, drawing->line_max_x-2);
+             x<drawing->line_max_x-2;
+             x=glyph_filler_next_pixel(row_line, row_completed, x+1, drawing->line_max_x-2)) {
+            is_inner_area = 0;
+
+            for (x_plus=-1;x_plus<2 && is_inner_area == 0;x_plus++) {
+                for (y_plus=-1;y_plus<2 && is_inner_area == 0;y_plus++) {
+                    if (x_plus != 0 || y_plus != 0) {
+                        if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x+x_plus, y+y_plus)) {
+                            is_inner_area = 1;
                         }
                     }
                 }
+            }
 
-                if (is_inner_area) {
-                    pixel->line_completed = 1;
-                    for (x_plus=-1;x_plus<2;x_plus++) {
-                        for (y_plus=-1;y_plus<2;y_plus++) {
-                            if (x_plus != 0 || y_plus != 0) {
-                                pixel_to = glyph_filler_get_pixel(drawing, x+x_plus,  y+y_plus);
-                                if (!pixel_to->outer_pixel && !pixel_to->line && !pixel_to->inner_pixel) {
-                                    pixel_to->outer_pixel = 1;
-                                    ret = 1;
-                                }
+            if (is_inner_area) {
+                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_LINE_COMPLETED, x, y);
+                for (x_plus=-1;x_plus<2;x_plus++) {
+                    for (y_plus=-1;y_plus<2;y_plus++) {
+                        if (x_plus != 0 || y_plus != 0) {
+                            if (!GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_OUTER, x+x_plus, y+y_plus)
+                                    && !GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_LINE, x+x_plus, y+y_plus)
+                                    && !GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x+x_plus, y+y_plus)) {
+                                GLYPH_DRAWER_SET(drawing, GLYPH_DRAWER_PLANE_OUTER, x+x_plus, y+y_plus);
+                                ret = 1;
                             }
                         }
                     }
@@ -541,6 +670,8 @@ int glyph_filler_draw_inner_area(font_drawing_t *drawing)
     struct timespec time_start={0,0}, time_end={0,0};
     clock_gettime(CLOCK_MONOTONIC, &time_start);
 #endif // TIME_DEBUG
+    // filling stays inside of the line area and the rows next to it
+    glyph_drawer_add_dirty_rows(drawing, drawing->line_min_y - 1, drawing->line_max_y + 1);
     glyph_filler_enlarge_outer_area_first(drawing);
 #ifdef TIME_DEBUG
         clock_gettime(CLOCK_MONOTONIC, &time_end);
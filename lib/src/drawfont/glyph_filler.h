@@ -15,7 +15,6 @@
 #include <stddef.h>
 #include "glyph_drawer.h"
 
-pixel_drawing_t *glyph_filler_get_pixel(font_drawing_t *drawing, int x, int y);
 int glyph_filler_draw_inner_area(font_drawing_t *drawing);
 
 #ifdef TIME_DEBUG
@@ -0,0 +1,92 @@
+/*!
+ * \file
+ * \brief file glyph_flatten.c
+ *
+ * Flattens the quadratic curve into lines
+ * by forward differencing
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "glyph_flatten.h"
+#include <math.h>
+
+/*!
+ * \brief glyph_flatten_init
+ *
+ * count of the lines is based on the distance of the
+ * control point from the line x0/y0 - x1/y1
+ *
+ * \param flatten
+ * \param x0 start x position
+ * \param y0 start y position
+ * \param x1 end x position
+ * \param y1 end y position
+ * \param curve_x control point x
+ * \param curve_y control point y
+ * \param tolerance max distance between the curve and its lines
+ * \param max_lines max count of the lines
+ */
+void glyph_flatten_init(glyph_flatten_t *flatten, float x0, float y0, float x1, float y1,
+                        float curve_x, float curve_y, float tolerance, int max_lines)
+{
+    float tmp, step, step_squared;
+    const float second_x = x0 - 2.0f*curve_x + x1;
+    const float second_y = y0 - 2.0f*curve_y + y1;
+
+    // distance between the curve and the lines is at most |p0-2c+p1|/(4*count*count)
+    tmp = ceilf(sqrtf(sqrtf(second_x*second_x + second_y*second_y)/(4.0f*tolerance)));
+    flatten->count = (int)tmp;
+    if (flatten->count < 1) {
+        flatten->count = 1;
+    }
+    if (flatten->count > max_lines) {
+        flatten->count = max_lines;
+    }
+
+    // B(t + step) - B(t) changes by constant 2*(p0-2c+p1)*step*step
+    step = 1.0f/(float)flatten->count;
+    step_squared = step*step;
+    flatten->x = x0;
+    flatten->y = y0;
+    flatten->first_x = 2.0f*(curve_x - x0)*step + second_x*step_squared;
+    flatten->first_y = 2.0f*(curve_y - y0)*step + second_y*step_squared;
+    flatten->second_x = 2.0f*second_x*step_squared;
+    flatten->second_y = 2.0f*second_y*step_squared;
+    flatten->end_x = x1;
+    flatten->end_y = y1;
+    flatten->index = 0;
+}
+
+/*!
+ * \brief glyph_flatten_next
+ *
+ * gets the end point of the next line, the last
+ * point is exactly the end point of the curve
+ *
+ * \param flatten
+ * \param x [out] x position
+ * \param y [out] y position
+ * \return 1 if the point was got, 0 if the curve has ended
+ */
+int glyph_flatten_next(glyph_flatten_t *flatten, float *x, float *y)
+{
+    if (flatten->index >= flatten->count) {
+        return 0;
+    }
+    flatten->index++;
+    if (flatten->index == flatten->count) {
+        *x = flatten->end_x;
+        *y = flatten->end_y;
+        return 1;
+    }
+    flatten->x += flatten->first_x;
+    flatten->y += flatten->first_y;
+    flatten->first_x += flatten->second_x;
+    flatten->first_y += flatten->second_y;
+    *x = flatten->x;
+    *y = flatten->y;
+    return 1;
+}
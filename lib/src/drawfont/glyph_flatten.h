@@ -0,0 +1,35 @@
+/*!
+ * \file
+ * \brief file glyph_flatten.h
+ *
+ * Flattens the quadratic curve into lines
+ * by forward differencing
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef GLYPH_FLATTEN_H
+#define GLYPH_FLATTEN_H
+
+/*!
+ * \brief The glyph_flatten_t struct
+ *
+ * state of the curve, the points are got one by one
+ * with glyph_flatten_next()
+ */
+typedef struct {
+    float x, y;                 // current point
+    float first_x, first_y;     // B(t + step) - B(t)
+    float second_x, second_y;   // change of first_x/first_y per step
+    float end_x, end_y;
+    int count;                  // count of the lines
+    int index;                  // count of the returned points
+} glyph_flatten_t;
+
+void glyph_flatten_init(glyph_flatten_t *flatten, float x0, float y0, float x1, float y1,
+                        float curve_x, float curve_y, float tolerance, int max_lines);
+int glyph_flatten_next(glyph_flatten_t *flatten, float *x, float *y);
+
+#endif // GLYPH_FLATTEN_H
@@ -15,34 +15,90 @@
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "../font_tables.h"
 #include "../prj-ttf-reader.h"
 #include "glyph_image.h"
 #include "glyph_image_positions.h"
 #include "glyph_drawer.h"
 #include "glyph_filler.h"
+#include "glyph_scanline.h"
+#include "glyph_area.h"
 #include "rotate_math.h"
 
 /*!
- * \brief glyph_graph_generator_is_valid_character
+ * \brief glyph_graph_generator_compare_glyph_character
  *
- * is character valid for generating the glyph
+ * qsort compare function, sorts by glyph index and then by character
+ */
+static int glyph_graph_generator_compare_glyph_character(const void *a, const void *b)
+{
+    const glyph_character_t *left = (const glyph_character_t *)a;
+    const glyph_character_t *right = (const glyph_character_t *)b;
+
+    if (left->glyph_index != right->glyph_index) {
+        return left->glyph_index < right->glyph_index ? -1 : 1;
+    }
+    if (left->character != right->character) {
+        return left->character < right->character ? -1 : 1;
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_graph_generator_find_glyph_characters
+ *
+ * finds the glyph index of each requested character, the characters
+ * that font doesn't have are ignored. Glyphs are generated in the
+ * glyph index order, so the list is sorted by glyph index
  *
  * \param list_characters
  * \param list_characters_size
- * \param character
- * \return 0 if it's valid character
+ * \param tables
+ * \param generate [out] list_glyph_character is filled
+ * \return 0 on success
  */
-static int glyph_graph_generator_is_valid_character(const uint32_t *list_characters, uint32_t list_characters_size, uint32_t character)
+static int glyph_graph_generator_find_glyph_characters(const uint32_t *list_characters, uint32_t list_characters_size,
+                                                       const font_tables_t *tables, font_generate_t *generate)
 {
-    uint32_t i;
+    uint32_t i, count = 0;
+    uint16_t glyph_index;
+
+    if (!list_characters_size) {
+        return 0;
+    }
+
+    generate->list_glyph_character = (glyph_character_t *)malloc(sizeof(glyph_character_t)*list_characters_size);
+    if (!generate->list_glyph_character) {
+        return errno;
+    }
+
     for (i=0;i<list_characters_size;i++) {
-        if (character == list_characters[i]) {
-            return 0;
+        if (cmap_get_glyph_index(&tables->character_to_glyph_index_table, list_characters[i], &glyph_index)
+                || glyph_index >= tables->max_profile.glyphs_count) {
+            continue;
         }
+        generate->list_glyph_character[count].glyph_index = glyph_index;
+        generate->list_glyph_character[count].character = list_characters[i];
+        generate->list_glyph_character[count].glyph = NULL;
+        generate->list_glyph_character[count].is_cached = 0;
+        count++;
     }
 
-    return -1;
+    qsort(generate->list_glyph_character, count, sizeof(glyph_character_t), glyph_graph_generator_compare_glyph_character);
+
+    // remove the same characters
+    generate->list_glyph_character_count = 0;
+    for (i=0;i<count;i++) {
+        if (generate->list_glyph_character_count
+                && generate->list_glyph_character[generate->list_glyph_character_count-1].character
+                    == generate->list_glyph_character[i].character) {
+            continue;
+        }
+        generate->list_glyph_character[generate->list_glyph_character_count++] = generate->list_glyph_character[i];
+    }
+    return 0;
 }
 
 /*!
@@ -128,6 +184,37 @@ static void set_min_max(float *min, float *max, const float new_value)
     }
 }
 
+/*!
+ * \brief set_quadratic_min_max
+ *
+ * sets the extremum of quadratic curve into min and max,
+ * extremum is where derivative of the curve is 0
+ * end points of the curve are not set
+ *
+ * \param min [in/out]
+ * \param max [in/out]
+ * \param value0 start point of the curve
+ * \param curve_value control point of the curve
+ * \param value1 end point of the curve
+ */
+#ifndef TEST_CASE
+static
+#endif
+void set_quadratic_min_max(float *min, float *max, const float value0, const float curve_value, const float value1)
+{
+    const float divisor = value0 - 2.0f*curve_value + value1;
+    float t;
+
+    if (fabsf(divisor) <= 0) {
+        return;
+    }
+    t = (value0 - curve_value)/divisor;
+    if (t <= 0 || t >= 1) {
+        return;
+    }
+    set_min_max(min, max, (1.0f-t)*(1.0f-t)*value0 + 2.0f*t*(1.0f-t)*curve_value + t*t*value1);
+}
+
 /*!
  * \brief get_max_value
  *
@@ -157,276 +244,1058 @@ int32_t get_max_value(float value, int quality)
     return i_value + quality;
 }
 
-#ifndef TEST_CASE
 /*!
- * \brief glyph_graph_generator_generate_graph
+ * \brief glyph_graph_generator_get_glyph
  *
- * generates the glyphs into graphic image
+ * gets the parsed outline of the glyph, outline is taken from glyph cache
+ * of the font when possible, otherwise glyph is parsed and added into cache
  *
- * \param list_characters
- * \param list_characters_size
- * \param data
- * \param data_size
+ * \param font
+ * \param glyf_view glyf table of the font
+ * \param glyph_character [in/out] glyph and is_cached are set
+ * \return 0 == success
+ */
+static int glyph_graph_generator_get_glyph(const glyph_graph_generator_font_t *font, const table_view_t *glyf_view,
+                                           glyph_character_t *glyph_character)
+{
+    font_tables_t *tables = font->tables;
+    font_generate_t *generate = font->generate;
+    const uint16_t i = glyph_character->glyph_index;
+    int ret;
+
+    if (generate->glyph_cache) {
+        glyph_character->glyph = glyph_cache_acquire(generate->glyph_cache, i);
+        if (glyph_character->glyph) {
+            glyph_character->is_cached = 1;
+            return 0;
+        }
+    }
+
+    if (!generate->list_glyph && glyf_alloc(&generate->list_glyph, &tables->max_profile)) {
+        return EIO;
+    }
+    ret = glyf_parse(font->data, glyf_view->offset + glyf_view->length, i,
+                     generate->list_glyph,
+                     glyf_view->offset, tables->list_index_loc_to_tables, &tables->max_profile,
+                     &generate->arena);
+    if (ret) {
+        return ret;
+    }
+
+    glyph_character->glyph = &generate->list_glyph[i];
+    if (generate->glyph_cache) {
+        glyph_character->glyph = glyph_cache_insert(generate->glyph_cache, &generate->list_glyph[i]);
+        if (glyph_character->glyph) {
+            glyph_character->is_cached = 1;
+        } else {
+            glyph_character->glyph = &generate->list_glyph[i];
+        }
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_graph_generator_get_rotated_bounding_box
+ *
+ * calculates the bounding box of rotated outline, the extremum
+ * of each rotated curve is calculated, so the control points
+ * of the curves are not in the bounding box
+ *
+ * \param outline
+ * \param rotate
+ * \param rotated_min_x [out]
+ * \param rotated_min_y [out]
+ * \param rotated_max_x [out]
+ * \param rotated_max_y [out]
+ */
+static void glyph_graph_generator_get_rotated_bounding_box(const glyph_outline_t *outline, const float rotate,
+                                                           float *rotated_min_x, float *rotated_min_y,
+                                                           float *rotated_max_x, float *rotated_max_y)
+{
+    glyf_outline_iterator_t iterator;
+    glyph_curve_t curve;
+    float rotated_x[3];
+    float rotated_y[3];
+    int first_time = 1;
+
+    *rotated_min_x = 0;
+    *rotated_min_y = 0;
+    *rotated_max_x = 0;
+    *rotated_max_y = 0;
+
+    glyf_outline_iterator_init(&iterator, outline);
+    while (glyf_outline_iterator_next(&iterator, &curve)) {
+        rotate_by_angle_zero(&rotated_x[0], &rotated_y[0], curve.x0, curve.y0, rotate);
+        if (first_time) {
+            first_time = 0;
+            *rotated_min_x = *rotated_max_x = rotated_x[0];
+            *rotated_min_y = *rotated_max_y = rotated_y[0];
+        } else {
+            set_min_max(rotated_min_x, rotated_max_x, rotated_x[0]);
+            set_min_max(rotated_min_y, rotated_max_y, rotated_y[0]);
+        }
+        rotate_by_angle_zero(&rotated_x[1], &rotated_y[1], curve.x1, curve.y1, rotate);
+        set_min_max(rotated_min_x, rotated_max_x, rotated_x[1]);
+        set_min_max(rotated_min_y, rotated_max_y, rotated_y[1]);
+
+        if (!curve.is_curve) {
+            // it's line, curve points are ignored
+            continue;
+        }
+        rotate_by_angle_zero(&rotated_x[2], &rotated_y[2], curve.curve_x, curve.curve_y, rotate);
+        set_quadratic_min_max(rotated_min_x, rotated_max_x, rotated_x[0], rotated_x[2], rotated_x[1]);
+        set_quadratic_min_max(rotated_min_y, rotated_max_y, rotated_y[0], rotated_y[2], rotated_y[1]);
+    }
+}
+
+/*!
+ * \brief glyph_graph_generator_measure_glyphs
+ *
+ * adds the required size of each glyph of the font to list_font_sizes
+ * If the glyphs are not rotated, only the headers of the glyphs are parsed
+ * and the outlines are parsed when the glyphs are drawn
+ *
+ * \param font
  * \param font_size_px
- * \param tables
  * \param quality
- * \param image_data
- * \param hor_metrics_table
- * \param hor_header_table
  * \param rotate
- * \param move_glyph_x
- * \param move_glyph_y
+ * \param list_font_sizes [in/out] sizes of the glyphs, reallocated when glyph is added
+ * \param list_font_sizes_count [in/out] count of list_font_sizes
  * \return 0 == success
  */
-int glyph_graph_generator_generate_graph(const uint32_t *list_characters, uint32_t list_characters_size,
-                                         const uint8_t *data, size_t data_size, float font_size_px,
-                                         font_tables_t *tables, int quality,
-                                         prj_ttf_reader_data_t *image_data,
-                                         const horizontal_metrics_table_t *hor_metrics_table,
-                                         const horizontal_header_table_t *hor_header_table,
-                                         const float rotate,
-                                         const float move_glyph_x, const float move_glyph_y)
+static int glyph_graph_generator_measure_glyphs(const glyph_graph_generator_font_t *font, float font_size_px,
+                                                int quality, const float rotate,
+                                                font_size_t **list_font_sizes, uint32_t *list_font_sizes_count)
 {
+    font_tables_t *tables = font->tables;
+    font_generate_t *generate = font->generate;
     const float rate = (float)quality*font_size_px/(float)tables->header_table.units_per_em;
-    uint16_t index_glyf;
+    table_view_t glyf_view;
     uint16_t i;
-    int list_index = 0;
-    uint32_t i2, i3;
-    uint32_t line__draw_index = 0;
+    uint32_t i_character;
     float min_x, min_y;
     float max_x, max_y;
-    int required_width, required_height;
     float rotated_min_x = 0;
     float rotated_min_y = 0;
     float rotated_max_x = 0;
     float rotated_max_y = 0;
-    int first_time;
     int is_empty;
     int ret;
-    int32_t tmpi;
     font_size_t *tmp;
-    font_drawing_t font_draw;
-    float rotated_x[3];
-    float rotated_y[3];
-    float calculated_x, calculated_y;
-
-    memset(&font_draw, 0, sizeof(font_draw));
+    glyph_t header;
+    const glyph_t *glyph;
+    glyph_character_t *glyph_character;
 
-    index_glyf = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "glyf");
-    if (UINT16_MAX == index_glyf) {
+    if (otff_get_table(&tables->table_directory, OTFF_TABLE_GLYF, &glyf_view)) {
         return EIO;
     }
 
-    if (glyf_alloc(&tables->list_glyph, &tables->max_profile)) {
-        return EIO;
+    ret = glyph_graph_generator_find_glyph_characters(font->list_characters, font->list_characters_size, tables, generate);
+    if (ret) {
+        return ret;
     }
 
     // first find every characters required size for the image
-    for (i=0;i<tables->max_profile.glyphs_count;i++) {
-        if (glyph_graph_generator_is_valid_character(list_characters,
-                                                     list_characters_size,
-                                                     tables->corr_character_table.character[i])) {
-             continue;
-        }
+    for (i_character=0;i_character<generate->list_glyph_character_count;i_character++) {
+        glyph_character = &generate->list_glyph_character[i_character];
+        i = glyph_character->glyph_index;
 
         is_empty = 1;
         if (i < tables->max_profile.glyphs_count - 1
                 && tables->list_index_loc_to_tables[i].offset == tables->list_index_loc_to_tables[i+1].offset) {
             is_empty = 0;
         }
-        ret = glyf_parse(data, data_size, i,
-                        tables->list_glyph,
-                        tables->list_table_record[index_glyf].offset, tables->list_index_loc_to_tables, &tables->max_profile);
-        if (ret) {
-            return ret;
+        if (rotate <= 0) {
+            // bounding box of the header is the size of the glyph,
+            // outline is parsed only when the glyph is drawn
+            ret = glyf_parse_bounding_box(font->data, glyf_view.offset + glyf_view.length, i,
+                                          glyf_view.offset, tables->list_index_loc_to_tables, &header);
+            if (ret) {
+                return ret;
+            }
+            glyph = &header;
+        } else {
+            // glyph of many characters is parsed only once
+            if (!i_character || generate->list_glyph_character[i_character-1].glyph_index != i) {
+                ret = glyph_graph_generator_get_glyph(font, &glyf_view, glyph_character);
+                if (ret) {
+                    return ret;
+                }
+            } else {
+                glyph_character->glyph = generate->list_glyph_character[i_character-1].glyph;
+            }
+            glyph = glyph_character->glyph;
         }
+        glyph_character->min_x = glyph->min_x;
+        glyph_character->min_y = glyph->min_y;
+        glyph_character->max_x = glyph->max_x;
+        glyph_character->max_y = glyph->max_y;
 
-        min_x = tables->list_glyph[i].min_x;
-        min_y = tables->list_glyph[i].min_y;
-        max_x = tables->list_glyph[i].max_x;
-        max_y = tables->list_glyph[i].max_y;
+        min_x = glyph->min_x;
+        min_y = glyph->min_y;
+        max_x = glyph->max_x;
+        max_y = glyph->max_y;
 
         if (fabs(min_x) <= 0 && fabs(min_y) <= 0 && fabs(max_x) <= 0 && fabs(max_y) <= 0) {
             continue;
         }
 
-        rotated_min_x = 0;
-        rotated_min_y = 0;
-        rotated_max_x = 0;
-        rotated_max_y = 0;
-        first_time = 1;
-
-        for (i2=0;i2<tables->list_glyph[i].list_path_size;i2++) {
-            for (i3=0;i3<tables->list_glyph[i].list_path[i2].list_glyph_curve_size;i3++) {
-                if (first_time) {
-                    first_time = 0;
-                    rotate_by_angle_zero(&rotated_min_x, &rotated_min_y,
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].x0,
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].y0,
-                                    rotate);
-                    rotated_max_x = rotated_min_x;
-                    rotated_max_y = rotated_min_y;
-                } else {
-                    rotate_by_angle_zero(&calculated_x, &calculated_y,
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].x0,
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].y0,
-                                    rotate);
-                    set_min_max(&rotated_min_x, &rotated_max_x, calculated_x);
-                    set_min_max(&rotated_min_y, &rotated_max_y, calculated_y);
-                }
-                rotate_by_angle_zero(&calculated_x, &calculated_y,
-                                tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].x1,
-                                tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].y1,
-                                rotate);
-                set_min_max(&rotated_min_x, &rotated_max_x, calculated_x);
-                set_min_max(&rotated_min_y, &rotated_max_y, calculated_y);
-
-                if (!tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].is_curve) {
-                    // it's line, curve points are ignored
-                    continue;
-                }
-
-                rotate_by_angle_zero(&calculated_x, &calculated_y,
-                                tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].curve_x,
-                                tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].curve_y,
-                                rotate);
-                set_min_max(&rotated_min_x, &rotated_max_x, calculated_x);
-                set_min_max(&rotated_min_y, &rotated_max_y, calculated_y);
-            }
+        if (rotate <= 0) {
+            rotated_min_x = min_x;
+            rotated_min_y = min_y;
+            rotated_max_x = max_x;
+            rotated_max_y = max_y;
+        } else {
+            glyph_graph_generator_get_rotated_bounding_box(&glyph->outline, rotate,
+                                                           &rotated_min_x, &rotated_min_y,
+                                                           &rotated_max_x, &rotated_max_y);
         }
 
-        if (tables->list_font_sizes_count == 0) {
-            tables->list_font_sizes = (font_size_t *)malloc(sizeof(font_size_t));
-            if (!tables->list_font_sizes) {
+        if (*list_font_sizes_count == 0) {
+            *list_font_sizes = (font_size_t *)malloc(sizeof(font_size_t));
+            if (!*list_font_sizes) {
                 return errno;
             }
         } else {
-            tmp = (font_size_t *)realloc(tables->list_font_sizes, sizeof(font_size_t)*(uint32_t)(tables->list_font_sizes_count+1));
+            tmp = (font_size_t *)realloc(*list_font_sizes, sizeof(font_size_t)*((size_t)*list_font_sizes_count+1));
             if (!tmp) {
                 return errno;
             }
-            tables->list_font_sizes = tmp;
+            *list_font_sizes = tmp;
         }
 
-        tables->list_font_sizes[tables->list_font_sizes_count].x = -1;
-        tables->list_font_sizes[tables->list_font_sizes_count].y = -1;
-        tables->list_font_sizes[tables->list_font_sizes_count].width = (int)( (float)(rotated_max_x-rotated_min_x)*rate/(float)quality) + 3;
-        tables->list_font_sizes[tables->list_font_sizes_count].height = (int)( (float)(rotated_max_y-rotated_min_y)*rate/(float)quality) + 3;
-        tables->list_font_sizes[tables->list_font_sizes_count].rotated_min_x = rotated_min_x;
-        tables->list_font_sizes[tables->list_font_sizes_count].rotated_max_x = rotated_max_x;
-        tables->list_font_sizes[tables->list_font_sizes_count].rotated_min_y = rotated_min_y;
-        tables->list_font_sizes[tables->list_font_sizes_count].rotated_max_y = rotated_max_y;
-        tables->list_font_sizes[tables->list_font_sizes_count].is_empty = is_empty;
-        tables->list_font_sizes_count++;
+        tmp = &(*list_font_sizes)[*list_font_sizes_count];
+        tmp->x = -1;
+        tmp->y = -1;
+        tmp->width = (int)( (float)(rotated_max_x-rotated_min_x)*rate/(float)quality) + 3;
+        tmp->height = (int)( (float)(rotated_max_y-rotated_min_y)*rate/(float)quality) + 3;
+        tmp->rotated_min_x = rotated_min_x;
+        tmp->rotated_max_x = rotated_max_x;
+        tmp->rotated_min_y = rotated_min_y;
+        tmp->rotated_max_y = rotated_max_y;
+        tmp->is_empty = is_empty;
+        (*list_font_sizes_count)++;
     }
 
-    // set positions for image, that contains the all glyphs
-    // also we get the required width/height for thei image
-    ret = glyph_image_positions_generate_glyph_positions(tables->list_font_sizes, tables->list_font_sizes_count, &required_width, &required_height);
+    return 0;
+}
+
+/*!
+ * \brief The glyph_graph_generator_job_t struct
+ *
+ * single glyph that is drawn by glyph_graph_generator_draw_glyph()
+ */
+typedef struct {
+    const glyph_graph_generator_font_t *font;
+    const glyph_character_t *glyph_character;  // outline of the glyph is already parsed
+    int list_index;     // index of the glyph in list_font_sizes and image_data->list_data
+    int64_t size;       // size of the glyph in the image, jobs are sorted by this
+} glyph_graph_generator_job_t;
+
+/*!
+ * \brief The glyph_graph_generator_raster_t struct
+ *
+ * glyphs of single generate call, drawing threads take the next job
+ * from list_job until all jobs are done or some job fails
+ */
+typedef struct glyph_graph_generator_raster {
+    glyph_graph_generator_job_t *list_job;     // sorted, largest glyph first
+    uint32_t list_job_count;
+    uint32_t next_job;      // locked by lock
+    int ret;                // error of the failed job, locked by lock
+    pthread_mutex_t lock;
+    const font_size_t *list_font_sizes;
+    prj_ttf_reader_data_t *image_data;
+    float font_size_px;
+    int quality;
+    float rotate;
+    float move_glyph_x;
+    float move_glyph_y;
+    glyph_graph_generator_workers_t *workers;   // drawing threads and canvases
+    struct glyph_graph_generator_raster *next;  // next raster that waits for the workers, locked by workers->lock
+    uint32_t helper_count;          // count of the workers that can still start to help, locked by workers->lock
+    uint32_t active_helper_count;   // count of the workers that are drawing, locked by workers->lock
+    pthread_cond_t done;            // signaled when active_helper_count becomes 0
+} glyph_graph_generator_raster_t;
+
+/*!
+ * \brief max memory size of the buffers that the canvas keeps for
+ * the next generate call, buffers of large glyphs are released
+ */
+#define GLYPH_GRAPH_GENERATOR_CANVAS_KEEP_SIZE  (4*1024*1024)
+
+/*!
+ * \brief The glyph_graph_generator_canvas_t struct
+ *
+ * buffers of single drawing thread, buffers are kept in the workers
+ * between the glyphs and the generate calls
+ */
+typedef struct glyph_graph_generator_canvas {
+    glyph_memory_t memory;          // buffers of the glyph, max is max_glyph_memory_size of the font
+    arena_t arena;                  // area of PRJ_TTF_READER_FILL_MODE_ANALYTIC
+    glyph_drawer_pool_t pool;       // canvas of PRJ_TTF_READER_FILL_MODE_FLOOD and PRJ_TTF_READER_FILL_MODE_SCANLINE
+    glyph_tiles_t tiles;            // canvas of PRJ_TTF_READER_FILL_MODE_TILED
+    glyph_scanline_t scanline;      // edge list of PRJ_TTF_READER_FILL_MODE_SCANLINE and PRJ_TTF_READER_FILL_MODE_TILED
+    uint32_t line_draw_index;       // index of the next drawn line
+    struct glyph_graph_generator_canvas *next;  // next unused canvas of the workers
+} glyph_graph_generator_canvas_t;
+
+/*!
+ * \brief glyph_graph_generator_free_canvas
+ *
+ * releases the buffers and the canvas
+ *
+ * \param canvas
+ */
+static void glyph_graph_generator_free_canvas(glyph_graph_generator_canvas_t *canvas)
+{
+    glyph_scanline_clear(&canvas->scanline);
+    arena_clear(&canvas->arena);
+    glyph_drawer_pool_clear(&canvas->pool);
+    glyph_tiles_clear(&canvas->tiles);
+    free(canvas);
+}
+
+/*!
+ * \brief glyph_graph_generator_take_canvas
+ *
+ * takes unused canvas of the workers, canvas is created
+ * if all canvases are used
+ *
+ * \param workers
+ * \return canvas, NULL on failure
+ */
+static glyph_graph_generator_canvas_t *glyph_graph_generator_take_canvas(glyph_graph_generator_workers_t *workers)
+{
+    glyph_graph_generator_canvas_t *canvas;
+
+    pthread_mutex_lock(&workers->lock);
+    canvas = workers->first_canvas;
+    if (canvas) {
+        workers->first_canvas = canvas->next;
+    }
+    pthread_mutex_unlock(&workers->lock);
+    if (canvas) {
+        return canvas;
+    }
+
+    canvas = (glyph_graph_generator_canvas_t *)calloc(1, sizeof(glyph_graph_generator_canvas_t));
+    if (!canvas) {
+        return NULL;
+    }
+    canvas->tiles.band = -1;
+    canvas->pool.memory = &canvas->memory;
+    canvas->scanline.memory = &canvas->memory;
+    return canvas;
+}
+
+/*!
+ * \brief glyph_graph_generator_give_canvas
+ *
+ * gives the canvas back to the workers for the next drawing thread,
+ * buffers larger than GLYPH_GRAPH_GENERATOR_CANVAS_KEEP_SIZE are released
+ *
+ * \param workers
+ * \param canvas
+ */
+static void glyph_graph_generator_give_canvas(glyph_graph_generator_workers_t *workers,
+                                              glyph_graph_generator_canvas_t *canvas)
+{
+    arena_reset(&canvas->arena);
+    if (canvas->arena.first && canvas->arena.first->size > GLYPH_GRAPH_GENERATOR_CANVAS_KEEP_SIZE) {
+        arena_clear(&canvas->arena);
+    }
+    // tiles were released after each glyph, the pool and the edge lists are counted in memory
+    if (canvas->memory.memory_size > GLYPH_GRAPH_GENERATOR_CANVAS_KEEP_SIZE) {
+        glyph_drawer_pool_clear(&canvas->pool);
+        glyph_scanline_clear(&canvas->scanline);
+    }
+
+    pthread_mutex_lock(&workers->lock);
+    canvas->next = workers->first_canvas;
+    workers->first_canvas = canvas;
+    pthread_mutex_unlock(&workers->lock);
+}
+
+/*!
+ * \brief glyph_graph_generator_add_jobs
+ *
+ * adds the glyphs of the font into jobs, glyphs were measured
+ * by glyph_graph_generator_measure_glyphs() and outlines that are
+ * not parsed yet are parsed here, so the jobs only read the outlines
+ *
+ * \param font
+ * \param list_font_sizes sizes and positions of the glyphs
+ * \param list_job [in/out] jobs of the glyphs
+ * \param list_index [in/out] index of the next glyph in list_font_sizes and image_data->list_data
+ * \return 0 == success
+ */
+static int glyph_graph_generator_add_jobs(const glyph_graph_generator_font_t *font, const font_size_t *list_font_sizes,
+                                          glyph_graph_generator_job_t *list_job, int *list_index)
+{
+    const font_tables_t *tables = font->tables;
+    font_generate_t *generate = font->generate;
+    table_view_t glyf_view;
+    uint16_t i;
+    uint32_t i_character;
+    int ret;
+    glyph_character_t *glyph_character;
+
+    if (otff_get_table(&tables->table_directory, OTFF_TABLE_GLYF, &glyf_view)) {
+        return EIO;
+    }
+
+    for (i_character=0;i_character<generate->list_glyph_character_count;i_character++) {
+        glyph_character = &generate->list_glyph_character[i_character];
+        i = glyph_character->glyph_index;
+
+        if (glyph_character->min_x == 0 && glyph_character->min_y == 0
+                && glyph_character->max_x == 0 && glyph_character->max_y == 0) {
+            continue;
+        }
+
+        // outline was not parsed if the glyphs are not rotated
+        if (!glyph_character->glyph) {
+            if (!i_character || generate->list_glyph_character[i_character-1].glyph_index != i) {
+                ret = glyph_graph_generator_get_glyph(font, &glyf_view, glyph_character);
+                if (ret) {
+                    return ret;
+                }
+            } else {
+                glyph_character->glyph = generate->list_glyph_character[i_character-1].glyph;
+            }
+        }
+
+        list_job[*list_index].font = font;
+        list_job[*list_index].glyph_character = glyph_character;
+        list_job[*list_index].list_index = *list_index;
+        list_job[*list_index].size = (int64_t)list_font_sizes[*list_index].width*list_font_sizes[*list_index].height;
+        (*list_index)++;
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_graph_generator_draw_glyph
+ *
+ * draws single glyph into its position of the image, glyphs
+ * are drawn from many threads, so only the data of this
+ * glyph in image_data is changed
+ *
+ * \param raster
+ * \param job
+ * \param canvas buffers of this thread
+ * \return 0 == success
+ */
+static int glyph_graph_generator_draw_glyph(const glyph_graph_generator_raster_t *raster,
+                                            const glyph_graph_generator_job_t *job,
+                                            glyph_graph_generator_canvas_t *canvas)
+{
+    const glyph_graph_generator_font_t *font = job->font;
+    const font_tables_t *tables = font->tables;
+    const font_generate_t *generate = font->generate;
+    const glyph_t *glyph = job->glyph_character->glyph;
+    const font_size_t *font_size = &raster->list_font_sizes[job->list_index];
+    prj_ttf_reader_glyph_data_t *glyph_data = &raster->image_data->list_data[job->list_index];
+    const int quality = raster->quality;
+    const float rotate = raster->rotate;
+    const float move_glyph_x = raster->move_glyph_x;
+    const float move_glyph_y = raster->move_glyph_y;
+    const float rate = (float)quality*raster->font_size_px/(float)tables->header_table.units_per_em;
+    glyf_outline_iterator_t iterator;
+    glyph_curve_t curve;
+    float min_x, min_y;
+    float max_x, max_y;
+    int ret = 0;
+    int32_t tmpi;
+    font_drawing_t font_draw;
+    float rotated_x[3];
+    float rotated_y[3];
+    float x0, y0, x1, y1;
+    const float pixel_rate = 1.0f/(float)quality;
+    glyph_area_t area;
+    int width, height;
+    size_t image_size;
+    const int use_scanline = generate->fill_mode == PRJ_TTF_READER_FILL_MODE_SCANLINE
+            || generate->fill_mode == PRJ_TTF_READER_FILL_MODE_TILED;
+
+    memset(&font_draw, 0, sizeof(font_draw));
+
+    min_x = job->glyph_character->min_x;
+    min_y = job->glyph_character->min_y;
+    max_x = job->glyph_character->max_x;
+    max_y = job->glyph_character->max_y;
+
+    tmpi = get_max_value(max_x*rate, quality);
+    tmpi = increase_max_value(tmpi, quality, font_size->rotated_max_x*rate);
+    max_x = (float)(tmpi+quality);
+    tmpi = get_max_value(max_y*rate, quality);
+    tmpi = increase_max_value(tmpi, quality, font_size->rotated_max_y*rate);
+    max_y = (float)(tmpi+quality);
+    tmpi = get_min_value(min_x*rate, quality);
+    tmpi = decrease_min_value(tmpi, quality, font_size->rotated_min_x*rate);
+    min_x = (float)(tmpi-quality);
+    tmpi = get_min_value(min_y*rate, quality);
+    tmpi = decrease_min_value(tmpi, quality, font_size->rotated_min_y*rate);
+    min_y = (float)(tmpi-quality);
+
+    // area of previous glyph is released at once
+    arena_reset(&canvas->arena);
+    width = (int)(max_x-min_x);
+    height = (int)(max_y-min_y);
+    // coverage of the analytic mode or pixel counts of the tiled mode, the
+    // pool and the scanline count their own buffers as they are grown
+    image_size = 0;
+    if (generate->fill_mode == PRJ_TTF_READER_FILL_MODE_ANALYTIC || generate->fill_mode == PRJ_TTF_READER_FILL_MODE_TILED) {
+        image_size = (size_t)(1+width/quality)*(size_t)(1+height/quality)*sizeof(float);
+    }
+    canvas->memory.max_memory_size = generate->max_glyph_memory_size ? generate->max_glyph_memory_size : SIZE_MAX;
+    if (canvas->memory.memory_size > canvas->memory.max_memory_size) {
+        // buffers of the previous glyphs are too large for this font
+        glyph_drawer_pool_clear(&canvas->pool);
+        glyph_scanline_clear(&canvas->scanline);
+    }
+    ret = glyph_memory_reserve(&canvas->memory, image_size, 1);
     if (ret) {
         return ret;
     }
-    // alloc image data
-    ret = glyph_image_generate_reader_data((uint32_t)tables->list_font_sizes_count,
-                                           required_width, required_height,
-                                           image_data);
+    if (generate->fill_mode == PRJ_TTF_READER_FILL_MODE_TILED) {
+        ret = glyph_tiles_init(&canvas->tiles, width, height, &canvas->memory);
+        if (!ret) {
+            glyph_drawer_init_tiles(&font_draw, &canvas->tiles);
+        }
+    } else if (generate->fill_mode == PRJ_TTF_READER_FILL_MODE_ANALYTIC) {
+        // coverage is calculated straight into the pixels of the image
+        ret = glyph_area_init(&area, 1+width/quality, 1+height/quality, &canvas->arena);
+    } else {
+        ret = glyph_drawer_init(&font_draw, width, height, &canvas->pool);
+    }
     if (ret) {
+        glyph_memory_release(&canvas->memory, image_size);
         return ret;
     }
 
-    // draw lines
-    for (i=0;i<tables->max_profile.glyphs_count;i++) {
-        if (glyph_graph_generator_is_valid_character(list_characters,
-                                                     list_characters_size,
-                                                     tables->corr_character_table.character[i])) {
-             continue;
+    font_draw.line_min_x = 0;
+    font_draw.line_min_y = 0;
+    font_draw.line_max_x = 0;
+    font_draw.line_max_y = 0;
+    glyph_scanline_reset(&canvas->scanline);
+
+    glyf_outline_iterator_init(&iterator, &glyph->outline);
+    while (!ret && glyf_outline_iterator_next(&iterator, &curve)) {
+        // winding of the scanline and the area needs closed contours
+        if (curve.is_repeated && generate->fill_mode != PRJ_TTF_READER_FILL_MODE_FLOOD) {
+            continue;
         }
+        rotate_by_angle_zero(&rotated_x[0], &rotated_y[0],
+                            curve.x0*rate,
+                            curve.y0*rate,
+                            rotate);
+        rotate_by_angle_zero(&rotated_x[1], &rotated_y[1],
+                            curve.x1*rate,
+                            curve.y1*rate,
+                            rotate);
+        if (curve.is_curve == 1) {
+            rotate_by_angle_zero(&rotated_x[2], &rotated_y[2],
+                                curve.curve_x*rate,
+                                curve.curve_y*rate,
+                                rotate);
+        }
+        x0 = rotated_x[0]-min_x+move_glyph_x;
+        y0 = rotated_y[0]-min_y+move_glyph_y;
+        x1 = rotated_x[1]-min_x+move_glyph_x;
+        y1 = rotated_y[1]-min_y+move_glyph_y;
 
-        if (tables->list_glyph[i].min_x == 0 && tables->list_glyph[i].min_y == 0
-                && tables->list_glyph[i].max_x == 0 && tables->list_glyph[i].max_y == 0) {
+        if (generate->fill_mode == PRJ_TTF_READER_FILL_MODE_ANALYTIC) {
+            if (curve.is_curve == 1) {
+                glyph_area_add_curve(&area, x0*pixel_rate, y0*pixel_rate, x1*pixel_rate, y1*pixel_rate,
+                                     (rotated_x[2]-min_x+move_glyph_x)*pixel_rate,
+                                     (rotated_y[2]-min_y+move_glyph_y)*pixel_rate);
+            } else {
+                glyph_area_add_line(&area, x0*pixel_rate, y0*pixel_rate, x1*pixel_rate, y1*pixel_rate);
+            }
             continue;
         }
 
-        min_x = tables->list_glyph[i].min_x;
-        min_y = tables->list_glyph[i].min_y;
-        max_x = tables->list_glyph[i].max_x;
-        max_y = tables->list_glyph[i].max_y;
-
-        tmpi = get_max_value(max_x*rate, quality);
-        tmpi = increase_max_value(tmpi, quality, tables->list_font_sizes[list_index].rotated_max_x*rate);
-        max_x = (float)(tmpi+quality);
-        tmpi = get_max_value(max_y*rate, quality);
-        tmpi = increase_max_value(tmpi, quality, tables->list_font_sizes[list_index].rotated_max_y*rate);
-        max_y = (float)(tmpi+quality);
-        tmpi = get_min_value(min_x*rate, quality);
-        tmpi = decrease_min_value(tmpi, quality, tables->list_font_sizes[list_index].rotated_min_x*rate);
-        min_x = (float)(tmpi-quality);
-        tmpi = get_min_value(min_y*rate, quality);
-        tmpi = decrease_min_value(tmpi, quality, tables->list_font_sizes[list_index].rotated_min_y*rate);
-        min_y = (float)(tmpi-quality);
-
-        ret = glyph_drawer_init(&font_draw, (int)(max_x-min_x), (int)(max_y-min_y));
-        if (ret) {
-            return ret;
+        if (curve.is_curve == 1) {
+            ret = glyph_drawer_paint_curve(x0, y0, x1, y1,
+                                           rotated_x[2]-min_x+move_glyph_x,
+                                           rotated_y[2]-min_y+move_glyph_y,
+                                           GLYPH_DRAWER_CURVE_TOLERANCE*(float)quality,
+                                           &font_draw, canvas->line_draw_index++);
+            if (!ret && use_scanline) {
+                ret = glyph_scanline_add_curve(&canvas->scanline, x0, y0, x1, y1,
+                                               rotated_x[2]-min_x+move_glyph_x,
+                                               rotated_y[2]-min_y+move_glyph_y);
+            }
+        } else {
+            ret = glyph_drawer_draw_line((int)x0, (int)y0, (int)x1, (int)y1,
+                                         &font_draw, canvas->line_draw_index++);
+            if (!ret && use_scanline) {
+                ret = glyph_scanline_add_line(&canvas->scanline, x0, y0, x1, y1);
+            }
+        }
+    }
+
+    glyph_data->character = job->glyph_character->character;
+    glyph_data->font_index = font->font_index;
+
+    if (!ret && generate->fill_mode == PRJ_TTF_READER_FILL_MODE_ANALYTIC) {
+        glyph_area_accumulate(&area);
+        ret = glyph_image_add_area_into_image(raster->list_font_sizes, job->list_index,
+                                              &area, quality, raster->image_data,
+                                              (int32_t)(-min_x),
+                                              (int32_t)(-min_y));
+    } else if (!ret) {
+        if (use_scanline) {
+            ret = glyph_scanline_fill(&canvas->scanline, &font_draw);
+        } else {
+            glyph_filler_draw_inner_area(&font_draw);
         }
+        if (!ret) {
+            ret = glyph_image_add_glyph_into_image(raster->list_font_sizes, job->list_index,
+                                                   &font_draw, quality, raster->image_data,
+                                                   (int32_t)(-min_x),
+                                                   (int32_t)(-min_y));
+        }
+    }
+    // pool of the thread is cleared also when the glyph failed
+    glyph_drawer_clear(&font_draw);
+    glyph_memory_release(&canvas->memory, image_size);
+    if (ret) {
+        return ret;
+    }
 
-        font_draw.line_min_x = 0;
-        font_draw.line_min_y = 0;
-        font_draw.line_max_x = 0;
-        font_draw.line_max_y = 0;
-
-        for (i2=0;i2<tables->list_glyph[i].list_path_size;i2++) {
-            for (i3=0;i3<tables->list_glyph[i].list_path[i2].list_glyph_curve_size;i3++) {
-                rotate_by_angle_zero(&rotated_x[0], &rotated_y[0],
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].x0*rate,
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].y0*rate,
-                                    rotate);
-                rotate_by_angle_zero(&rotated_x[1], &rotated_y[1],
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].x1*rate,
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].y1*rate,
-                                    rotate);
-                if (tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].is_curve == 1) {
-                    rotate_by_angle_zero(&rotated_x[2], &rotated_y[2],
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].curve_x*rate,
-                                    tables->list_glyph[i].list_path[i2].list_glyph_curve[i3].curve_y*rate,
-                                    rotate);
-                    glyph_drawer_paint_curve(rotated_x[0]-min_x+move_glyph_x,
-                                             rotated_y[0]-min_y+move_glyph_y,
-                                             rotated_x[1]-min_x+move_glyph_x,
-                                             rotated_y[1]-min_y+move_glyph_y,
-                                             rotated_x[2]-min_x+move_glyph_x,
-                                             rotated_y[2]-min_y+move_glyph_y,
-                                             &font_draw, line__draw_index++);
-                } else {
-                    glyph_drawer_draw_line((int)(rotated_x[0]-min_x+move_glyph_x),
-                                           (int)(rotated_y[0]-min_y+move_glyph_y),
-                                           (int)(rotated_x[1]-min_x+move_glyph_x),
-                                           (int)(rotated_y[1]-min_y+move_glyph_y),
-                                           &font_draw, line__draw_index++);
-                }
+    glyph_data->image_pixel_advance_x = hmtx_get_advance(job->glyph_character->glyph_index, font->hor_metrics_table,
+                                                         font->hor_header_table,
+                                                         raster->font_size_px/(float)tables->header_table.units_per_em);
+    glyph_data->image_pixel_bearing = hmtx_get_bearing(job->glyph_character->glyph_index, font->hor_metrics_table,
+                                                       font->hor_header_table,
+                                                       raster->font_size_px/(float)tables->header_table.units_per_em);
+    return 0;
+}
+
+/*!
+ * \brief glyph_graph_generator_draw_glyphs
+ *
+ * draws the next job until all jobs are done or some job fails
+ *
+ * \param raster
+ */
+static void glyph_graph_generator_draw_glyphs(glyph_graph_generator_raster_t *raster)
+{
+    glyph_graph_generator_canvas_t *canvas = glyph_graph_generator_take_canvas(raster->workers);
+    uint32_t job;
+    int ret;
+
+    if (!canvas) {
+        pthread_mutex_lock(&raster->lock);
+        if (!raster->ret) {
+            raster->ret = ENOMEM;
+        }
+        pthread_mutex_unlock(&raster->lock);
+        return;
+    }
+    while (1) {
+        pthread_mutex_lock(&raster->lock);
+        if (raster->ret || raster->next_job >= raster->list_job_count) {
+            pthread_mutex_unlock(&raster->lock);
+            break;
+        }
+        job = raster->next_job++;
+        pthread_mutex_unlock(&raster->lock);
+
+        ret = glyph_graph_generator_draw_glyph(raster, &raster->list_job[job], canvas);
+        if (ret == ENOMEM && canvas->memory.memory_size) {
+            // buffers kept from the earlier glyphs count against the max
+            // memory size, so the glyph is drawn once more without them
+            glyph_drawer_pool_clear(&canvas->pool);
+            glyph_scanline_clear(&canvas->scanline);
+            ret = glyph_graph_generator_draw_glyph(raster, &raster->list_job[job], canvas);
+        }
+        if (ret) {
+            pthread_mutex_lock(&raster->lock);
+            if (!raster->ret) {
+                raster->ret = ret;
             }
+            pthread_mutex_unlock(&raster->lock);
+            break;
         }
+    }
+    glyph_graph_generator_give_canvas(raster->workers, canvas);
+}
+
+/*!
+ * \brief glyph_graph_generator_work
+ *
+ * thread function of the worker, worker waits for the rasters
+ * of the generate calls and helps to draw their glyphs until
+ * the workers are cleared
+ *
+ * \param arg glyph_graph_generator_workers_t
+ * \return NULL
+ */
+static void *glyph_graph_generator_work(void *arg)
+{
+    glyph_graph_generator_workers_t *workers = (glyph_graph_generator_workers_t *)arg;
+    glyph_graph_generator_raster_t *raster;
+
+    pthread_mutex_lock(&workers->lock);
+    while (1) {
+        while (!workers->first_raster && !workers->is_stopped) {
+            pthread_cond_wait(&workers->cond, &workers->lock);
+        }
+        if (workers->is_stopped) {
+            break;
+        }
+        raster = workers->first_raster;
+        raster->helper_count--;
+        if (!raster->helper_count) {
+            workers->first_raster = raster->next;
+        }
+        raster->active_helper_count++;
+        pthread_mutex_unlock(&workers->lock);
+
+        glyph_graph_generator_draw_glyphs(raster);
+
+        pthread_mutex_lock(&workers->lock);
+        raster->active_helper_count--;
+        if (!raster->active_helper_count) {
+            pthread_cond_signal(&raster->done);
+        }
+    }
+    pthread_mutex_unlock(&workers->lock);
+    return NULL;
+}
+
+/*!
+ * \brief glyph_graph_generator_start_helpers
+ *
+ * adds the raster for the workers, workers are created
+ * when there are less than helper_count workers
+ *
+ * \param raster
+ * \param helper_count count of the workers that can help
+ */
+static void glyph_graph_generator_start_helpers(glyph_graph_generator_raster_t *raster, uint32_t helper_count)
+{
+    glyph_graph_generator_workers_t *workers = raster->workers;
+    glyph_graph_generator_raster_t **link;
+    pthread_t *list_thread;
+
+    pthread_mutex_lock(&workers->lock);
+    // threads of the parent process don't exist in the forked child
+    if (workers->list_thread_count && workers->pid != getpid()) {
+        workers->list_thread_count = 0;
+    }
+    workers->pid = getpid();
+    while (workers->list_thread_count < helper_count) {
+        list_thread = (pthread_t *)realloc(workers->list_thread, sizeof(pthread_t)*(workers->list_thread_count + 1));
+        if (!list_thread) {
+            break;
+        }
+        workers->list_thread = list_thread;
+        if (pthread_create(&workers->list_thread[workers->list_thread_count], NULL, glyph_graph_generator_work, workers)) {
+            break;
+        }
+        workers->list_thread_count++;
+    }
+    raster->helper_count = helper_count;
+    raster->next = NULL;
+    link = &workers->first_raster;
+    while (*link) {
+        link = &(*link)->next;
+    }
+    *link = raster;
+    pthread_cond_broadcast(&workers->cond);
+    pthread_mutex_unlock(&workers->lock);
+}
+
+/*!
+ * \brief glyph_graph_generator_wait_helpers
+ *
+ * removes the raster from the workers and waits
+ * until the workers that started to help are done
+ *
+ * \param raster
+ */
+static void glyph_graph_generator_wait_helpers(glyph_graph_generator_raster_t *raster)
+{
+    glyph_graph_generator_workers_t *workers = raster->workers;
+    glyph_graph_generator_raster_t **link;
+
+    pthread_mutex_lock(&workers->lock);
+    for (link=&workers->first_raster;*link;link=&(*link)->next) {
+        if (*link == raster) {
+            *link = raster->next;
+            break;
+        }
+    }
+    while (raster->active_helper_count) {
+        pthread_cond_wait(&raster->done, &workers->lock);
+    }
+    pthread_mutex_unlock(&workers->lock);
+}
 
-        glyph_filler_draw_inner_area(&font_draw);
-        image_data->list_data[list_index].character = tables->corr_character_table.character[i];
+/*!
+ * \brief glyph_graph_generator_workers_init
+ *
+ * Inits the workers, threads are created by the first
+ * generate call that uses more than one thread
+ *
+ * \param workers
+ */
+void glyph_graph_generator_workers_init(glyph_graph_generator_workers_t *workers)
+{
+    memset(workers, 0, sizeof(glyph_graph_generator_workers_t));
+    pthread_mutex_init(&workers->lock, NULL);
+    pthread_cond_init(&workers->cond, NULL);
+}
 
-        ret = glyph_image_add_glyph_into_image(tables->list_font_sizes, list_index,
-                                               &font_draw, quality, image_data,
-                                               (int32_t)(-min_x),
-                                               (int32_t)(-min_y));
+/*!
+ * \brief glyph_graph_generator_workers_clear
+ *
+ * Stops and joins the threads and releases the canvases,
+ * workers must not be used by any generate call
+ *
+ * \param workers
+ */
+void glyph_graph_generator_workers_clear(glyph_graph_generator_workers_t *workers)
+{
+    uint32_t i;
+    glyph_graph_generator_canvas_t *canvas;
+
+    pthread_mutex_lock(&workers->lock);
+    workers->is_stopped = 1;
+    pthread_cond_broadcast(&workers->cond);
+    pthread_mutex_unlock(&workers->lock);
+    if (workers->pid == getpid()) {
+        for (i=0;i<workers->list_thread_count;i++) {
+            pthread_join(workers->list_thread[i], NULL);
+        }
+    }
+    free(workers->list_thread);
+
+    while (workers->first_canvas) {
+        canvas = workers->first_canvas;
+        workers->first_canvas = canvas->next;
+        glyph_graph_generator_free_canvas(canvas);
+    }
+    pthread_cond_destroy(&workers->cond);
+    pthread_mutex_destroy(&workers->lock);
+    memset(workers, 0, sizeof(glyph_graph_generator_workers_t));
+}
+
+/*!
+ * \brief glyph_graph_generator_compare_job
+ *
+ * qsort compare, largest glyph first, so the small glyphs
+ * at the end keep the threads busy as long as possible
+ *
+ * \param a
+ * \param b
+ * \return
+ */
+static int glyph_graph_generator_compare_job(const void *a, const void *b)
+{
+    const glyph_graph_generator_job_t *job_a = (const glyph_graph_generator_job_t *)a;
+    const glyph_graph_generator_job_t *job_b = (const glyph_graph_generator_job_t *)b;
+
+    if (job_a->size != job_b->size) {
+        return job_a->size > job_b->size ? -1 : 1;
+    }
+    return job_a->list_index - job_b->list_index;
+}
+
+/*!
+ * \brief glyph_graph_generator_get_thread_count
+ *
+ * get count of the drawing threads, the largest thread count
+ * of the fonts, 0 is the count of the processors
+ *
+ * \param list_font
+ * \param list_font_count
+ * \param list_job_count
+ * \return count of the threads, at least 1
+ */
+static uint32_t glyph_graph_generator_get_thread_count(const glyph_graph_generator_font_t *list_font, uint32_t list_font_count,
+                                                       uint32_t list_job_count)
+{
+    uint32_t i;
+    long processors;
+    uint32_t thread_count = 1;
+    uint32_t font_thread_count;
+
+    for (i=0;i<list_font_count;i++) {
+        font_thread_count = list_font[i].generate->thread_count;
+        if (!font_thread_count) {
+            processors = sysconf(_SC_NPROCESSORS_ONLN);
+            font_thread_count = processors > 0 ? (uint32_t)processors : 1;
+        }
+        if (thread_count < font_thread_count) {
+            thread_count = font_thread_count;
+        }
+    }
+    if (thread_count > list_job_count) {
+        thread_count = list_job_count ? list_job_count : 1;
+    }
+    return thread_count;
+}
+
+/*!
+ * \brief glyph_graph_generator_generate_graph_fonts
+ *
+ * generates the glyphs of many fonts into same graphic image,
+ * glyphs of the first font are first in image_data->list_data.
+ * Positions of the glyphs in the image are set before drawing,
+ * so the glyphs are drawn by this thread and the workers
+ *
+ * \param list_font fonts and the characters of each font
+ * \param list_font_count
+ * \param font_size_px
+ * \param quality
+ * \param image_data
+ * \param rotate
+ * \param move_glyph_x
+ * \param move_glyph_y
+ * \return 0 == success
+ */
+int glyph_graph_generator_generate_graph_fonts(const glyph_graph_generator_font_t *list_font, uint32_t list_font_count,
+                                               float font_size_px, int quality,
+                                               prj_ttf_reader_data_t *image_data,
+                                               const float rotate,
+                                               const float move_glyph_x, const float move_glyph_y)
+{
+    uint32_t i;
+    int list_index = 0;
+    int required_width, required_height;
+    int ret = 0;
+    font_size_t *list_font_sizes = NULL;
+    uint32_t list_font_sizes_count = 0;
+    glyph_graph_generator_raster_t raster;
+    glyph_graph_generator_workers_t call_workers;
+    uint32_t thread_count;
+
+    for (i=0;i<list_font_count;i++) {
+        ret = glyph_graph_generator_measure_glyphs(&list_font[i], font_size_px, quality, rotate,
+                                                   &list_font_sizes, &list_font_sizes_count);
         if (ret) {
+            free(list_font_sizes);
             return ret;
         }
+    }
 
-        image_data->list_data[list_index].image_pixel_advance_x = hmtx_get_advance(i, hor_metrics_table,
-                                                                                      hor_header_table,
-                                                                                      font_size_px/(float)tables->header_table.units_per_em);
-        image_data->list_data[list_index].image_pixel_bearing = hmtx_get_bearing(i, hor_metrics_table,
-                                                                                      hor_header_table,
-                                                                                      font_size_px/(float)tables->header_table.units_per_em);
-        list_index++;
-        glyph_drawer_clear(&font_draw);
+    // set positions for image, that contains the all glyphs
+    // also we get the required width/height for thei image
+    ret = glyph_image_positions_generate_glyph_positions(list_font_sizes, (int)list_font_sizes_count, &required_width, &required_height);
+    if (ret) {
+        free(list_font_sizes);
+        return ret;
     }
-    return 0;
+    // alloc image data
+    ret = glyph_image_generate_reader_data(list_font_sizes_count,
+                                           required_width, required_height,
+                                           image_data);
+    if (ret) {
+        free(list_font_sizes);
+        return ret;
+    }
+
+    memset(&raster, 0, sizeof(raster));
+    raster.list_job = (glyph_graph_generator_job_t *)calloc((size_t)list_font_sizes_count + 1, sizeof(glyph_graph_generator_job_t));
+    if (!raster.list_job) {
+        free(list_font_sizes);
+        return ENOMEM;
+    }
+    for (i=0;i<list_font_count && !ret;i++) {
+        ret = glyph_graph_generator_add_jobs(&list_font[i], list_font_sizes, raster.list_job, &list_index);
+    }
+    raster.list_job_count = (uint32_t)list_index;
+    if (ret) {
+        free(raster.list_job);
+        free(list_font_sizes);
+        return ret;
+    }
+
+    qsort(raster.list_job, raster.list_job_count, sizeof(glyph_graph_generator_job_t), glyph_graph_generator_compare_job);
+    raster.list_font_sizes = list_font_sizes;
+    raster.image_data = image_data;
+    raster.font_size_px = font_size_px;
+    raster.quality = quality;
+    raster.rotate = rotate;
+    raster.move_glyph_x = move_glyph_x;
+    raster.move_glyph_y = move_glyph_y;
+    pthread_mutex_init(&raster.lock, NULL);
+    pthread_cond_init(&raster.done, NULL);
+    // workers of the font or the chain, otherwise only for this call
+    raster.workers = list_font_count ? list_font[0].generate->workers : NULL;
+    if (!raster.workers) {
+        glyph_graph_generator_workers_init(&call_workers);
+        raster.workers = &call_workers;
+    }
+
+    // this thread draws with the workers
+    thread_count = glyph_graph_generator_get_thread_count(list_font, list_font_count, raster.list_job_count);
+    if (thread_count > 1) {
+        glyph_graph_generator_start_helpers(&raster, thread_count - 1);
+    }
+    glyph_graph_generator_draw_glyphs(&raster);
+    if (thread_count > 1) {
+        glyph_graph_generator_wait_helpers(&raster);
+    }
+    if (raster.workers == &call_workers) {
+        glyph_graph_generator_workers_clear(&call_workers);
+    }
+    ret = raster.ret;
+    pthread_cond_destroy(&raster.done);
+    pthread_mutex_destroy(&raster.lock);
+    free(raster.list_job);
+    free(list_font_sizes);
+    return ret;
+}
+
+/*!
+ * \brief glyph_graph_generator_generate_graph
+ *
+ * generates the glyphs into graphic image
+ *
+ * \param list_characters
+ * \param list_characters_size
+ * \param data
+ * \param data_size
+ * \param font_size_px
+ * \param tables
+ * \param generate temporary data of this generate call
+ * \param quality
+ * \param image_data
+ * \param hor_metrics_table
+ * \param hor_header_table
+ * \param rotate
+ * \param move_glyph_x
+ * \param move_glyph_y
+ * \return 0 == success
+ */
+int glyph_graph_generator_generate_graph(const uint32_t *list_characters, uint32_t list_characters_size,
+                                         const uint8_t *data, size_t data_size, float font_size_px,
+                                         font_tables_t *tables, font_generate_t *generate, int quality,
+                                         prj_ttf_reader_data_t *image_data,
+                                         const horizontal_metrics_table_t *hor_metrics_table,
+                                         const horizontal_header_table_t *hor_header_table,
+                                         const float rotate,
+                                         const float move_glyph_x, const float move_glyph_y)
+{
+    glyph_graph_generator_font_t font;
+
+    font.data = data;
+    font.data_size = data_size;
+    font.tables = tables;
+    font.generate = generate;
+    font.hor_metrics_table = hor_metrics_table;
+    font.hor_header_table = hor_header_table;
+    font.list_characters = list_characters;
+    font.list_characters_size = list_characters_size;
+    font.font_index = 0;
+
+    return glyph_graph_generator_generate_graph_fonts(&font, 1, font_size_px, quality, image_data,
+                                                      rotate, move_glyph_x, move_glyph_y);
 }
-#endif // #ifndef TEST_CASE
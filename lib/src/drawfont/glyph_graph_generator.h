@@ -14,12 +14,57 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <pthread.h>
+#include <sys/types.h>
 #include "../prj-ttf-reader.h"
 #include "../font_tables.h"
 
+/*!
+ * \brief The glyph_graph_generator_font_t struct
+ *
+ * single font of glyph_graph_generator_generate_graph_fonts()
+ */
+typedef struct {
+    const uint8_t *data;
+    size_t data_size;
+    font_tables_t *tables;
+    font_generate_t *generate;  // temporary data of this font
+    const horizontal_metrics_table_t *hor_metrics_table;
+    const horizontal_header_table_t *hor_header_table;
+    const uint32_t *list_characters;    // characters that are generated with this font
+    uint32_t list_characters_size;
+    uint32_t font_index;        // set into prj_ttf_reader_glyph_data_t of the glyphs
+} glyph_graph_generator_font_t;
+
+/*!
+ * \brief The glyph_graph_generator_workers_t struct
+ *
+ * drawing threads and their canvases, kept by the font or the font chain
+ * between the generate calls, use glyph_graph_generator_workers_init() to init
+ * and glyph_graph_generator_workers_clear() to clear
+ */
+struct glyph_graph_generator_workers
+{
+    pthread_mutex_t lock;   // locks the workers and the waiting rasters
+    pthread_cond_t cond;    // signaled when a raster is added or the workers are stopped
+    struct glyph_graph_generator_raster *first_raster;  // rasters that wait for the workers
+    pthread_t *list_thread;
+    uint32_t list_thread_count;
+    pid_t pid;              // process that created the threads
+    int is_stopped;         // 1 when the threads must exit
+    struct glyph_graph_generator_canvas *first_canvas;  // canvases that no thread is drawing with
+};
+
+void glyph_graph_generator_workers_init(glyph_graph_generator_workers_t *workers);
+void glyph_graph_generator_workers_clear(glyph_graph_generator_workers_t *workers);
+int glyph_graph_generator_generate_graph_fonts(const glyph_graph_generator_font_t *list_font, uint32_t list_font_count,
+                                               float font_size_px, int quality,
+                                               prj_ttf_reader_data_t *image_data,
+                                               const float rotate,
+                                               const float move_glyph_x, const float move_glyph_y);
 int glyph_graph_generator_generate_graph(const uint32_t *list_characters, uint32_t list_characters_size,
                                          const uint8_t *data, size_t data_size, float font_size_px,
-                                         font_tables_t *tables, int quality,
+                                         font_tables_t *tables, font_generate_t *generate, int quality,
                                          prj_ttf_reader_data_t *image_data,
                                          const horizontal_metrics_table_t *hor_metrics_table,
                                          const horizontal_header_table_t *hor_header_table,
@@ -11,6 +11,7 @@
 
 #include "glyph_image.h"
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include "glyph_drawer.h"
 #include "../prj-ttf-reader.h"
@@ -69,21 +70,42 @@ int glyph_image_add_glyph_into_image(const font_size_t *list_sizes, int list_ind
     int end_y = 0;
     int x_converted;
     int y_converted;
-    pixel_drawing_t *p_pixel;
+    int word;
+    uint64_t bits;
+    const uint64_t *row_line = NULL;
+    const uint64_t *row_inner = NULL;
     int quality_multiply = quality*quality;
 
     int new_width = 1+drawing->width/quality;
     int new_height = 1+drawing->height/quality;
 
-    int *px_count = (int *)calloc((uint32_t)(new_width*new_height), sizeof(int) );
+    int *px_count;
+    if (drawing->pool) {
+        px_count = glyph_drawer_pool_get_px_count(drawing->pool, (size_t)(new_width*new_height));
+    } else {
+        px_count = (int *)calloc((uint32_t)(new_width*new_height), sizeof(int) );
+    }
     if (!px_count) {
-        return errno;
+        return ENOMEM;
     }
 
-    for (x=0;x<drawing->width;x++) {
-        for (y=0;y<drawing->height;y++) {
-            p_pixel = &drawing->list_pixels[y*drawing->width+x];
-            if (p_pixel->line || p_pixel->inner_pixel) {
+    // rows outside of the dirty rows are empty
+    for (y=drawing->dirty_min_y;y<=drawing->dirty_max_y;y++) {
+        if (!drawing->tiles) {
+            row_line = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_LINE, y);
+            row_inner = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_INNER, y);
+        }
+        for (word=0;word<drawing->row_words;word++) {
+            // 64 pixels are skipped at once when there is no line or inner pixel
+            if (drawing->tiles) {
+                bits = glyph_tiles_get(drawing->tiles, word, y);
+            } else {
+                bits = row_line[word] | row_inner[word];
+            }
+            for (x=word*64;bits;x++,bits>>=1) {
+                if (!(bits & 1)) {
+                    continue;
+                }
                 x_converted = x/quality;
                 y_converted = y/quality;
                 if (start_x == -1) {
@@ -126,6 +148,85 @@ int glyph_image_add_glyph_into_image(const font_size_t *list_sizes, int list_ind
     data->list_data[list_index].image_pixel_bottom_y = ((y-start_y)+list_sizes[list_index].y);
     data->list_data[list_index].image_pixel_offset_line_x = origin_x/quality - start_x;
     data->list_data[list_index].image_pixel_offset_line_y = start_y - origin_y/quality;
-    free(px_count);
+    if (!drawing->pool) {
+        free(px_count);
+    } else if (start_x != -1) {
+        // pool buffer is zeroed for the next glyph
+        memset(&px_count[start_y*new_width], 0, (size_t)((end_y-start_y+1)*new_width)*sizeof(int));
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_image_add_area_into_image
+ *
+ * add coverage of the area into final image (data), area
+ * is in the pixels of the image and it's already accumulated
+ *
+ * \param list_sizes
+ * \param list_index
+ * \param area
+ * \param quality
+ * \param data
+ * \param origin_x (offset x position)
+ * \param origin_y (offset y position)
+ * \return 0 on success
+ */
+int glyph_image_add_area_into_image(const font_size_t *list_sizes, int list_index,
+                                    const glyph_area_t *area, int quality,
+                                    prj_ttf_reader_data_t *data,
+                                    const int32_t origin_x, const int32_t origin_y)
+{
+    int x, y;
+    int start_x = -1;
+    int start_y = -1;
+    int end_x = 0;
+    int end_y = 0;
+
+    // pixels that have coverage after rounding
+    for (y=0;y<area->height;y++) {
+        for (x=0;x<area->width;x++) {
+            if (area->list_area[y*area->width+x] < 0.5f/255.0f) {
+                continue;
+            }
+            if (start_x == -1) {
+                start_x = x;
+                start_y = y;
+                end_x = x;
+                end_y = y;
+            } else {
+                if (start_x > x) {
+                    start_x = x;
+                }
+                if (start_y > y) {
+                    start_y = y;
+                }
+                if (end_x < x) {
+                    end_x = x;
+                }
+                if (end_y < y) {
+                    end_y = y;
+                }
+            }
+        }
+    }
+    if (start_x == -1) {
+        start_x = 0;
+        start_y = 0;
+    }
+
+    for (x=start_x;x<=end_x;x++) {
+        for (y=start_y;y<=end_y;y++) {
+            data->image.data[ ((y-start_y)+list_sizes[list_index].y)*data->image.width+(x-start_x)+list_sizes[list_index].x ] =
+                    (uint8_t)(area->list_area[ (end_y-y+start_y)*area->width+x ]*255.0f + 0.5f);
+        }
+    }
+
+    data->list_data[list_index].image_pixel_left_x = list_sizes[list_index].x;
+    data->list_data[list_index].image_pixel_top_y = list_sizes[list_index].y;
+    data->list_data[list_index].image_pixel_right_x = ((x-start_x)+list_sizes[list_index].x);
+    data->list_data[list_index].image_pixel_bottom_y = ((y-start_y)+list_sizes[list_index].y);
+    data->list_data[list_index].image_pixel_offset_line_x = origin_x/quality - start_x;
+    data->list_data[list_index].image_pixel_offset_line_y = start_y - origin_y/quality;
     return 0;
 }
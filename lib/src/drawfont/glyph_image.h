@@ -15,11 +15,16 @@
 #include <stdint.h>
 #include "../font_tables.h"
 #include "glyph_drawer.h"
+#include "glyph_area.h"
 
 int glyph_image_generate_reader_data(uint32_t list_sizes_count, int32_t width, int32_t height, prj_ttf_reader_data_t *data);
 int glyph_image_add_glyph_into_image(const font_size_t *list_sizes, int list_index,
                                      const font_drawing_t *drawing, int quality,
                                      prj_ttf_reader_data_t *data,
                                      const int32_t origin_x, const int32_t origin_y);
+int glyph_image_add_area_into_image(const font_size_t *list_sizes, int list_index,
+                                    const glyph_area_t *area, int quality,
+                                    prj_ttf_reader_data_t *data,
+                                    const int32_t origin_x, const int32_t origin_y);
 
 #endif // GLYPH_IMAGE_H
@@ -0,0 +1,52 @@
+/*!
+ * \file
+ * \brief file glyph_memory.c
+ *
+ * Counts the memory of the buffers of single glyph
+ * against the max memory size
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "glyph_memory.h"
+#include <errno.h>
+
+/*!
+ * \brief glyph_memory_reserve
+ *
+ * reserves the memory before the allocation
+ *
+ * \param memory NULL if there is no limit
+ * \param count count of items
+ * \param size size of the item
+ * \return 0 on success, ENOMEM if the max memory size would be exceeded
+ */
+int glyph_memory_reserve(glyph_memory_t *memory, size_t count, size_t size)
+{
+    if (!memory) {
+        return 0;
+    }
+    if (count > (memory->max_memory_size - memory->memory_size)/size) {
+        return ENOMEM;
+    }
+    memory->memory_size += count*size;
+    return 0;
+}
+
+/*!
+ * \brief glyph_memory_release
+ *
+ * releases the memory of glyph_memory_reserve() after the free
+ *
+ * \param memory NULL if there is no limit
+ * \param size size in bytes
+ */
+void glyph_memory_release(glyph_memory_t *memory, size_t size)
+{
+    if (!memory) {
+        return;
+    }
+    memory->memory_size -= size;
+}
@@ -0,0 +1,32 @@
+/*!
+ * \file
+ * \brief file glyph_memory.h
+ *
+ * Counts the memory of the buffers of single glyph
+ * against the max memory size
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef GLYPH_MEMORY_H
+#define GLYPH_MEMORY_H
+
+#include <stddef.h>
+
+/*!
+ * \brief The glyph_memory_t struct
+ *
+ * buffers of the pool, the tiles and the edge list are counted
+ * in same glyph_memory_t, so their sum stays under the max
+ */
+typedef struct {
+    size_t memory_size;         // reserved bytes
+    size_t max_memory_size;     // SIZE_MAX if there is no limit
+} glyph_memory_t;
+
+int glyph_memory_reserve(glyph_memory_t *memory, size_t count, size_t size);
+void glyph_memory_release(glyph_memory_t *memory, size_t size);
+
+#endif // GLYPH_MEMORY_H
@@ -0,0 +1,357 @@
+/*!
+ * \file
+ * \brief file glyph_scanline.c
+ *
+ * Fills the glyph graphics by scanlines with
+ * the non-zero winding rule
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "glyph_scanline.h"
+#include "glyph_flatten.h"
+#include <stdlib.h>
+#include <math.h>
+#include <errno.h>
+
+/*!
+ * \brief max distance (in canvas pixels) between the curve and its lines
+ */
+#define GLYPH_SCANLINE_CURVE_TOLERANCE  0.25f
+
+/*!
+ * \brief glyph_scanline_ceil
+ * \param value
+ * \return smallest integer that is not less than value
+ */
+static int glyph_scanline_ceil(float value)
+{
+    const float ret = ceilf(value);
+    return (int)ret;
+}
+
+/*!
+ * \brief size of single edge in list_edge, list_active and list_crossing
+ */
+#define GLYPH_SCANLINE_EDGE_MEMORY_SIZE \
+    (sizeof(glyph_scanline_edge_t) + sizeof(uint32_t) + sizeof(glyph_scanline_crossing_t))
+
+/*!
+ * \brief glyph_scanline_reserve
+ *
+ * makes sure that the lists have space for one more edge, lists are
+ * grown to double size or only by one edge if the double size would
+ * exceed the max memory size
+ *
+ * \param scanline
+ * \return 0 on success, ENOMEM if the max memory size is exceeded
+ */
+static int glyph_scanline_reserve(glyph_scanline_t *scanline)
+{
+    uint32_t new_size;
+    glyph_scanline_edge_t *list_edge;
+    uint32_t *list_active;
+    glyph_scanline_crossing_t *list_crossing;
+
+    if (scanline->list_edge_count < scanline->list_edge_size) {
+        return 0;
+    }
+
+    // realloc keeps the old list until it's copied, so both are counted
+    new_size = scanline->list_edge_size ? scanline->list_edge_size*2 : 256;
+    if (glyph_memory_reserve(scanline->memory, new_size, GLYPH_SCANLINE_EDGE_MEMORY_SIZE)) {
+        new_size = scanline->list_edge_count + 1;
+        if (glyph_memory_reserve(scanline->memory, new_size, GLYPH_SCANLINE_EDGE_MEMORY_SIZE)) {
+            return ENOMEM;
+        }
+    }
+    list_edge = (glyph_scanline_edge_t *)realloc(scanline->list_edge, sizeof(glyph_scanline_edge_t)*new_size);
+    if (!list_edge) {
+        glyph_memory_release(scanline->memory, new_size*GLYPH_SCANLINE_EDGE_MEMORY_SIZE);
+        return ENOMEM;
+    }
+    scanline->list_edge = list_edge;
+    list_active = (uint32_t *)realloc(scanline->list_active, sizeof(uint32_t)*new_size);
+    if (!list_active) {
+        glyph_memory_release(scanline->memory, new_size*GLYPH_SCANLINE_EDGE_MEMORY_SIZE);
+        return ENOMEM;
+    }
+    scanline->list_active = list_active;
+    list_crossing = (glyph_scanline_crossing_t *)realloc(scanline->list_crossing, sizeof(glyph_scanline_crossing_t)*new_size);
+    if (!list_crossing) {
+        glyph_memory_release(scanline->memory, new_size*GLYPH_SCANLINE_EDGE_MEMORY_SIZE);
+        return ENOMEM;
+    }
+    scanline->list_crossing = list_crossing;
+    glyph_memory_release(scanline->memory, scanline->list_edge_size*GLYPH_SCANLINE_EDGE_MEMORY_SIZE);
+    scanline->list_edge_size = new_size;
+    return 0;
+}
+
+/*!
+ * \brief glyph_scanline_add_line
+ *
+ * adds line of the outline into edge list,
+ * horizontal lines are not needed
+ *
+ * \param scanline
+ * \param x0 start x position
+ * \param y0 start y position
+ * \param x1 end x position
+ * \param y1 end y position
+ * \return 0 on success
+ */
+int glyph_scanline_add_line(glyph_scanline_t *scanline, float x0, float y0, float x1, float y1)
+{
+    int ret;
+    glyph_scanline_edge_t *edge;
+
+    if (fabsf(y0 - y1) <= 0) {
+        return 0;
+    }
+
+    ret = glyph_scanline_reserve(scanline);
+    if (ret) {
+        return ret;
+    }
+
+    edge = &scanline->list_edge[scanline->list_edge_count++];
+    if (y0 < y1) {
+        edge->x0 = x0;
+        edge->y0 = y0;
+        edge->y1 = y1;
+        edge->winding = 1;
+    } else {
+        edge->x0 = x1;
+        edge->y0 = y1;
+        edge->y1 = y0;
+        edge->winding = -1;
+    }
+    edge->dxdy = (x1 - x0)/(y1 - y0);
+    return 0;
+}
+
+/*!
+ * \brief glyph_scanline_add_curve
+ *
+ * flattens the quadratic curve into lines of edge list
+ * with glyph_flatten_next()
+ *
+ * \param scanline
+ * \param x0 start x position
+ * \param y0 start y position
+ * \param x1 end x position
+ * \param y1 end y position
+ * \param curve_x control point x
+ * \param curve_y control point y
+ * \return 0 on success
+ */
+int glyph_scanline_add_curve(glyph_scanline_t *scanline, float x0, float y0, float x1, float y1, float curve_x, float curve_y)
+{
+    int ret;
+    float x, y;
+    float prev_x = x0, prev_y = y0;
+    glyph_flatten_t flatten;
+
+    glyph_flatten_init(&flatten, x0, y0, x1, y1, curve_x, curve_y,
+                       GLYPH_SCANLINE_CURVE_TOLERANCE, GLYPH_SCANLINE_MAX_CURVE_LINES);
+    while (glyph_flatten_next(&flatten, &x, &y)) {
+        ret = glyph_scanline_add_line(scanline, prev_x, prev_y, x, y);
+        if (ret) {
+            return ret;
+        }
+        prev_x = x;
+        prev_y = y;
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_scanline_compare_edge
+ *
+ * qsort compare, edges are sorted by the top
+ *
+ * \param a
+ * \param b
+ * \return
+ */
+static int glyph_scanline_compare_edge(const void *a, const void *b)
+{
+    const glyph_scanline_edge_t *edge_a = (const glyph_scanline_edge_t *)a;
+    const glyph_scanline_edge_t *edge_b = (const glyph_scanline_edge_t *)b;
+
+    if (edge_a->y0 < edge_b->y0) {
+        return -1;
+    }
+    if (edge_a->y0 > edge_b->y0) {
+        return 1;
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_scanline_fill_row
+ *
+ * sets inner pixels of the row which centers
+ * are inside of the outline (winding is not zero)
+ *
+ * \param scanline
+ * \param crossing_count count of crossings in list_crossing, sorted by x
+ * \param drawing
+ * \param y row
+ * \return 0 on success
+ */
+static int glyph_scanline_fill_row(const glyph_scanline_t *scanline, uint32_t crossing_count,
+                                   font_drawing_t *drawing, int y)
+{
+    int ret;
+    uint32_t i;
+    int start_x, end_x, word;
+    int winding = 0;
+    uint64_t *row;
+
+    if (drawing->tiles) {
+        ret = glyph_tiles_get_band_row(drawing->tiles, y, &row);
+        if (ret) {
+            return ret;
+        }
+    } else {
+        row = GLYPH_DRAWER_ROW(drawing, GLYPH_DRAWER_PLANE_INNER, y);
+    }
+
+    glyph_drawer_add_dirty_rows(drawing, y, y);
+    for (i=0;i+1<crossing_count;i++) {
+        winding += scanline->list_crossing[i].winding;
+        if (!winding) {
+            continue;
+        }
+        // pixels which center x+0.5 is in [crossing i, crossing i+1)
+        start_x = glyph_scanline_ceil(scanline->list_crossing[i].x - 0.5f);
+        end_x = glyph_scanline_ceil(scanline->list_crossing[i+1].x - 0.5f);
+        if (start_x < 0) {
+            start_x = 0;
+        }
+        if (end_x > drawing->width) {
+            end_x = drawing->width;
+        }
+        // span is set 64 pixels at once
+        for (word=start_x >> 6;start_x<end_x;word++) {
+            if (end_x - word*64 >= 64) {
+                row[word] |= ~(uint64_t)0 << (start_x - word*64);
+            } else {
+                row[word] |= (~(uint64_t)0 << (start_x - word*64)) & ~(~(uint64_t)0 << (end_x - word*64));
+            }
+            start_x = (word + 1)*64;
+        }
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_scanline_fill
+ *
+ * fills the outline of edge list with non-zero winding rule,
+ * all rows are handled in single pass with active edge table
+ *
+ * \param scanline edges of the glyph in pixels of drawing
+ * \param drawing
+ * \return 0 on success
+ */
+int glyph_scanline_fill(glyph_scanline_t *scanline, font_drawing_t *drawing)
+{
+    int ret;
+    int y;
+    float center_y;
+    uint32_t i, j;
+    uint32_t next_edge = 0;
+    uint32_t active_count = 0;
+    const glyph_scanline_edge_t *edge;
+    glyph_scanline_crossing_t crossing;
+
+    if (!scanline->list_edge_count) {
+        return 0;
+    }
+
+    qsort(scanline->list_edge, scanline->list_edge_count, sizeof(glyph_scanline_edge_t), glyph_scanline_compare_edge);
+
+    y = glyph_scanline_ceil(scanline->list_edge[0].y0 - 0.5f);
+    if (y < 0) {
+        y = 0;
+    }
+    for (;y<drawing->height;y++) {
+        center_y = (float)y + 0.5f;
+
+        // add the edges that start at this row
+        while (next_edge < scanline->list_edge_count && scanline->list_edge[next_edge].y0 <= center_y) {
+            scanline->list_active[active_count++] = next_edge++;
+        }
+
+        // remove the edges that ended
+        for (i=0,j=0;i<active_count;i++) {
+            if (scanline->list_edge[scanline->list_active[i]].y1 > center_y) {
+                scanline->list_active[j++] = scanline->list_active[i];
+            }
+        }
+        active_count = j;
+        if (!active_count) {
+            if (next_edge == scanline->list_edge_count) {
+                break;
+            }
+            continue;
+        }
+
+        // crossings sorted by x, count of active edges is small
+        for (i=0;i<active_count;i++) {
+            edge = &scanline->list_edge[scanline->list_active[i]];
+            crossing.x = edge->x0 + (center_y - edge->y0)*edge->dxdy;
+            crossing.winding = edge->winding;
+            for (j=i;j>0 && scanline->list_crossing[j-1].x > crossing.x;j--) {
+                scanline->list_crossing[j] = scanline->list_crossing[j-1];
+            }
+            scanline->list_crossing[j] = crossing;
+        }
+
+        ret = glyph_scanline_fill_row(scanline, active_count, drawing, y);
+        if (ret) {
+            return ret;
+        }
+    }
+    if (drawing->tiles) {
+        return glyph_tiles_flush_band(drawing->tiles);
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_scanline_reset
+ *
+ * removes the edges, allocated lists are kept for the next glyph
+ *
+ * \param scanline
+ */
+void glyph_scanline_reset(glyph_scanline_t *scanline)
+{
+    scanline->list_edge_count = 0;
+}
+
+/*!
+ * \brief glyph_scanline_clear
+ *
+ * releases the lists
+ *
+ * \param scanline
+ */
+void glyph_scanline_clear(glyph_scanline_t *scanline)
+{
+    glyph_memory_release(scanline->memory, scanline->list_edge_size*GLYPH_SCANLINE_EDGE_MEMORY_SIZE);
+    free(scanline->list_edge);
+    free(scanline->list_active);
+    free(scanline->list_crossing);
+    scanline->list_edge = NULL;
+    scanline->list_active = NULL;
+    scanline->list_crossing = NULL;
+    scanline->list_edge_count = 0;
+    scanline->list_edge_size = 0;
+}
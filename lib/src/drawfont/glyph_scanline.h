@@ -0,0 +1,68 @@
+/*!
+ * \file
+ * \brief file glyph_scanline.h
+ *
+ * Fills the glyph graphics by scanlines with
+ * the non-zero winding rule
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef GLYPH_SCANLINE_H
+#define GLYPH_SCANLINE_H
+
+#include <stdint.h>
+#include "glyph_drawer.h"
+
+/*!
+ * \brief max count of the lines of a single flattened curve
+ */
+#define GLYPH_SCANLINE_MAX_CURVE_LINES  64
+
+/*!
+ * \brief The glyph_scanline_edge_t struct
+ *
+ * single non-horizontal line of the outline, y0 < y1
+ */
+typedef struct {
+    float x0, y0;
+    float y1;
+    float dxdy;         // change of x when y increases by 1
+    int winding;        // 1 if the line goes to up, -1 if the line goes to down
+} glyph_scanline_edge_t;
+
+/*!
+ * \brief The glyph_scanline_crossing_t struct
+ *
+ * edge crossing of the current scanline
+ */
+typedef struct {
+    float x;
+    int winding;
+} glyph_scanline_crossing_t;
+
+/*!
+ * \brief The glyph_scanline_t struct
+ *
+ * edge list of the glyph, lists are kept allocated
+ * between the glyphs, use glyph_scanline_reset() to start
+ * a new glyph and glyph_scanline_clear() to release
+ */
+typedef struct {
+    glyph_scanline_edge_t *list_edge;
+    uint32_t list_edge_count;
+    uint32_t list_edge_size;    // allocated size of list_edge, list_active and list_crossing
+    uint32_t *list_active;      // indexes of list_edge that cross the current scanline
+    glyph_scanline_crossing_t *list_crossing;
+    glyph_memory_t *memory;     // lists are counted in this, NULL if there is no limit
+} glyph_scanline_t;
+
+int glyph_scanline_add_line(glyph_scanline_t *scanline, float x0, float y0, float x1, float y1);
+int glyph_scanline_add_curve(glyph_scanline_t *scanline, float x0, float y0, float x1, float y1, float curve_x, float curve_y);
+int glyph_scanline_fill(glyph_scanline_t *scanline, font_drawing_t *drawing);
+void glyph_scanline_reset(glyph_scanline_t *scanline);
+void glyph_scanline_clear(glyph_scanline_t *scanline);
+
+#endif // GLYPH_SCANLINE_H
@@ -0,0 +1,245 @@
+/*!
+ * \file
+ * \brief file glyph_tiles.c
+ *
+ * Sparse canvas of the glyph, only the tiles that
+ * have set pixels are allocated
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "glyph_tiles.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*!
+ * \brief glyph_tiles_alloc
+ *
+ * allocates zeroed memory, fails if the max memory size would be exceeded
+ *
+ * \param tiles
+ * \param size size in bytes
+ * \return allocated memory, NULL on failure
+ */
+static void *glyph_tiles_alloc(glyph_tiles_t *tiles, size_t size)
+{
+    void *ret;
+
+    if (glyph_memory_reserve(tiles->memory, 1, size)) {
+        return NULL;
+    }
+    ret = calloc(1, size);
+    if (!ret) {
+        glyph_memory_release(tiles->memory, size);
+        return NULL;
+    }
+    tiles->memory_size += size;
+    return ret;
+}
+
+/*!
+ * \brief glyph_tiles_free_tile
+ * \param tiles
+ * \param index index of the tile in list_tile
+ */
+static void glyph_tiles_free_tile(glyph_tiles_t *tiles, int index)
+{
+    if (!tiles->list_tile[index]) {
+        return;
+    }
+    free(tiles->list_tile[index]);
+    tiles->list_tile[index] = NULL;
+    tiles->memory_size -= GLYPH_TILES_SIZE*sizeof(uint64_t);
+    glyph_memory_release(tiles->memory, GLYPH_TILES_SIZE*sizeof(uint64_t));
+}
+
+/*!
+ * \brief glyph_tiles_init
+ *
+ * Inits the empty canvas, no tile is allocated
+ *
+ * \param tiles
+ * \param width width in pixels
+ * \param height height in pixels
+ * \param memory allocations are counted in this, NULL if there is no limit
+ * \return 0 on success, ENOMEM if the max memory size is exceeded
+ */
+int glyph_tiles_init(glyph_tiles_t *tiles, int width, int height, glyph_memory_t *memory)
+{
+    size_t count;
+
+    memset(tiles, 0, sizeof(glyph_tiles_t));
+    tiles->width = width;
+    tiles->height = height;
+    tiles->tile_columns = (width + GLYPH_TILES_SIZE - 1)/GLYPH_TILES_SIZE;
+    tiles->tile_rows = (height + GLYPH_TILES_SIZE - 1)/GLYPH_TILES_SIZE;
+    tiles->band = -1;
+    tiles->memory = memory;
+
+    // +1 so that the lists are not NULL when the canvas is empty
+    count = (size_t)tiles->tile_columns*(size_t)tiles->tile_rows + 1;
+    tiles->list_tile = (uint64_t **)glyph_tiles_alloc(tiles, count*sizeof(uint64_t *));
+    tiles->list_tile_full = (uint8_t *)glyph_tiles_alloc(tiles, count*sizeof(uint8_t));
+    if (!tiles->list_tile || !tiles->list_tile_full) {
+        glyph_tiles_clear(tiles);
+        return ENOMEM;
+    }
+    return 0;
+}
+
+/*!
+ * \brief glyph_tiles_set
+ *
+ * sets the pixels of the single row of the tile,
+ * tile is allocated if it's empty
+ *
+ * \param tiles
+ * \param word x/GLYPH_TILES_SIZE
+ * \param y
+ * \param bits pixels to set, lowest bit is the left pixel
+ * \return 0 on success
+ */
+int glyph_tiles_set(glyph_tiles_t *tiles, int word, int y, uint64_t bits)
+{
+    const int index = (y/GLYPH_TILES_SIZE)*tiles->tile_columns + word;
+
+    if (tiles->list_tile_full[index]) {
+        return 0;
+    }
+    if (!tiles->list_tile[index]) {
+        tiles->list_tile[index] = (uint64_t *)glyph_tiles_alloc(tiles, GLYPH_TILES_SIZE*sizeof(uint64_t));
+        if (!tiles->list_tile[index]) {
+            return ENOMEM;
+        }
+    }
+    tiles->list_tile[index][y%GLYPH_TILES_SIZE] |= bits;
+    return 0;
+}
+
+/*!
+ * \brief glyph_tiles_get
+ *
+ * \param tiles
+ * \param word x/GLYPH_TILES_SIZE
+ * \param y
+ * \return pixels of the single row of the tile, lowest bit is the left pixel
+ */
+uint64_t glyph_tiles_get(const glyph_tiles_t *tiles, int word, int y)
+{
+    const int index = (y/GLYPH_TILES_SIZE)*tiles->tile_columns + word;
+
+    if (tiles->list_tile_full[index]) {
+        return ~(uint64_t)0;
+    }
+    if (!tiles->list_tile[index]) {
+        return 0;
+    }
+    return tiles->list_tile[index][y%GLYPH_TILES_SIZE];
+}
+
+/*!
+ * \brief glyph_tiles_get_band_row
+ *
+ * get the row of the band, band is moved into the tiles
+ * when the row of the next band is requested, so the rows
+ * must be requested from top to bottom
+ *
+ * \param tiles
+ * \param y
+ * \param row [out] tile_columns words of the row
+ * \return 0 on success
+ */
+int glyph_tiles_get_band_row(glyph_tiles_t *tiles, int y, uint64_t **row)
+{
+    int ret;
+
+    if (tiles->band != y/GLYPH_TILES_SIZE) {
+        ret = glyph_tiles_flush_band(tiles);
+        if (ret) {
+            return ret;
+        }
+        if (!tiles->list_band) {
+            tiles->list_band = (uint64_t *)glyph_tiles_alloc(tiles, (size_t)tiles->tile_columns*GLYPH_TILES_SIZE*sizeof(uint64_t));
+            if (!tiles->list_band) {
+                return ENOMEM;
+            }
+        }
+        tiles->band = y/GLYPH_TILES_SIZE;
+    }
+    *row = &tiles->list_band[(y%GLYPH_TILES_SIZE)*tiles->tile_columns];
+    return 0;
+}
+
+/*!
+ * \brief glyph_tiles_flush_band
+ *
+ * moves the pixels of the band into the tiles, tiles that the band
+ * covers completely are marked full and their pixels are released
+ *
+ * \param tiles
+ * \return 0 on success
+ */
+int glyph_tiles_flush_band(glyph_tiles_t *tiles)
+{
+    int ret = 0;
+    int column, y, index;
+    uint64_t all, any;
+    const uint64_t *band;
+
+    if (tiles->band == -1) {
+        return 0;
+    }
+    for (column=0;column<tiles->tile_columns && !ret;column++) {
+        band = &tiles->list_band[column];
+        all = ~(uint64_t)0;
+        any = 0;
+        for (y=0;y<GLYPH_TILES_SIZE;y++) {
+            all &= band[y*tiles->tile_columns];
+            any |= band[y*tiles->tile_columns];
+        }
+        if (!any) {
+            continue;
+        }
+        index = tiles->band*tiles->tile_columns + column;
+        if (all == ~(uint64_t)0) {
+            glyph_tiles_free_tile(tiles, index);
+            tiles->list_tile_full[index] = 1;
+            continue;
+        }
+        for (y=0;y<GLYPH_TILES_SIZE && !ret;y++) {
+            if (band[y*tiles->tile_columns]) {
+                ret = glyph_tiles_set(tiles, column, tiles->band*GLYPH_TILES_SIZE + y, band[y*tiles->tile_columns]);
+            }
+        }
+    }
+    memset(tiles->list_band, 0, (size_t)tiles->tile_columns*GLYPH_TILES_SIZE*sizeof(uint64_t));
+    tiles->band = -1;
+    return ret;
+}
+
+/*!
+ * \brief glyph_tiles_clear
+ *
+ * releases the tiles
+ *
+ * \param tiles
+ */
+void glyph_tiles_clear(glyph_tiles_t *tiles)
+{
+    int i;
+
+    if (tiles->list_tile) {
+        for (i=0;i<tiles->tile_columns*tiles->tile_rows;i++) {
+            free(tiles->list_tile[i]);
+        }
+    }
+    free(tiles->list_tile);
+    free(tiles->list_tile_full);
+    free(tiles->list_band);
+    glyph_memory_release(tiles->memory, tiles->memory_size);
+    memset(tiles, 0, sizeof(glyph_tiles_t));
+    tiles->band = -1;
+}
@@ -0,0 +1,54 @@
+/*!
+ * \file
+ * \brief file glyph_tiles.h
+ *
+ * Sparse canvas of the glyph, only the tiles that
+ * have set pixels are allocated
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef GLYPH_TILES_H
+#define GLYPH_TILES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "glyph_memory.h"
+
+/*!
+ * \brief width and height of the tile in pixels,
+ * single row of the tile is one uint64_t
+ */
+#define GLYPH_TILES_SIZE    64
+
+/*!
+ * \brief The glyph_tiles_t struct
+ *
+ * canvas of 1 bit pixels that is split into GLYPH_TILES_SIZE x GLYPH_TILES_SIZE
+ * tiles, empty tiles are not allocated and tiles that have all pixels set are
+ * only marked full. Rows that are filled in order (scanline) are first collected
+ * into list_band, so the tiles inside of the outline are never allocated
+ */
+typedef struct {
+    int width;
+    int height;
+    int tile_columns;
+    int tile_rows;
+    uint64_t **list_tile;       // tile_columns*tile_rows, NULL if tile is empty or full
+    uint8_t *list_tile_full;    // 1 if all pixels of the tile are set
+    uint64_t *list_band;        // GLYPH_TILES_SIZE rows of tile_columns words
+    int band;                   // tile row of list_band, -1 if list_band is empty
+    size_t memory_size;         // allocated bytes
+    glyph_memory_t *memory;     // allocations are counted in this, NULL if there is no limit
+} glyph_tiles_t;
+
+int glyph_tiles_init(glyph_tiles_t *tiles, int width, int height, glyph_memory_t *memory);
+int glyph_tiles_set(glyph_tiles_t *tiles, int word, int y, uint64_t bits);
+uint64_t glyph_tiles_get(const glyph_tiles_t *tiles, int word, int y);
+int glyph_tiles_get_band_row(glyph_tiles_t *tiles, int y, uint64_t **row);
+int glyph_tiles_flush_band(glyph_tiles_t *tiles);
+void glyph_tiles_clear(glyph_tiles_t *tiles);
+
+#endif // GLYPH_TILES_H
@@ -0,0 +1,172 @@
+/*!
+ * \file
+ * \brief file font_chain.c
+ *
+ * Font fallback chain, each character is generated with
+ * the first font of the chain that has the character
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "font_chain.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "font_handle.h"
+
+/*!
+ * \brief font_chain_create
+ *
+ * creates the chain and builds the coverage of each font
+ *
+ * \param list_font fonts in fallback order
+ * \param list_font_count
+ * \param chain [out] created chain, NULL on failure
+ * \return 0 on success
+ */
+int font_chain_create(prj_ttf_reader_font_t *const *list_font, uint32_t list_font_count,
+                      prj_ttf_reader_font_chain_t **chain)
+{
+    int ret;
+    uint32_t i;
+    prj_ttf_reader_font_chain_t *new_chain;
+
+    *chain = NULL;
+
+    new_chain = (prj_ttf_reader_font_chain_t *)calloc(1, sizeof(prj_ttf_reader_font_chain_t));
+    if (!new_chain) {
+        return errno;
+    }
+    glyph_graph_generator_workers_init(&new_chain->workers);
+    new_chain->list_font = (prj_ttf_reader_font_t **)malloc(sizeof(prj_ttf_reader_font_t *)*list_font_count);
+    new_chain->list_coverage = (const prj_ttf_reader_coverage_t **)malloc(sizeof(prj_ttf_reader_coverage_t *)*list_font_count);
+    if (!new_chain->list_font || !new_chain->list_coverage) {
+        ret = errno;
+        font_chain_clear(&new_chain);
+        return ret;
+    }
+
+    for (i=0;i<list_font_count;i++) {
+        new_chain->list_font[i] = list_font[i];
+        ret = font_handle_load_tables(list_font[i], FONT_HANDLE_TABLE_COVERAGE);
+        if (ret) {
+            font_chain_clear(&new_chain);
+            return ret;
+        }
+        new_chain->list_coverage[i] = &list_font[i]->coverage;
+    }
+    new_chain->list_font_count = list_font_count;
+
+    *chain = new_chain;
+    return 0;
+}
+
+/*!
+ * \brief font_chain_clear
+ *
+ * clears the chain, fonts of the chain are not closed
+ *
+ * \param chain [in/out] sets chain to NULL
+ */
+void font_chain_clear(prj_ttf_reader_font_chain_t **chain)
+{
+    if (!*chain) {
+        return;
+    }
+    free((*chain)->list_font);
+    free((*chain)->list_coverage);
+    glyph_graph_generator_workers_clear(&(*chain)->workers);
+    free(*chain);
+    *chain = NULL;
+}
+
+/*!
+ * \brief font_chain_get_font_index
+ *
+ * \param chain
+ * \param character
+ * \param font_index [out] index of the first font that has the character
+ * \return 0 on success, EINVAL if none of the fonts has the character
+ */
+int font_chain_get_font_index(const prj_ttf_reader_font_chain_t *chain, uint32_t character, uint32_t *font_index)
+{
+    uint32_t i;
+
+    for (i=0;i<chain->list_font_count;i++) {
+        if (prj_ttf_reader_coverage_has_character(chain->list_coverage[i], character)) {
+            *font_index = i;
+            return 0;
+        }
+    }
+    return EINVAL;
+}
+
+/*!
+ * \brief font_chain_split_characters
+ *
+ * splits the characters to the fonts of the chain, characters
+ * that none of the fonts has are ignored
+ *
+ * \param chain
+ * \param list_characters
+ * \param list_characters_size
+ * \param list_font_characters [out] allocated list of characters, characters of
+ * the first font are first, then characters of the second font and so on
+ * \param list_font_characters_size [out] count of characters of each font,
+ * size must be chain->list_font_count
+ * \return 0 on success
+ */
+int font_chain_split_characters(const prj_ttf_reader_font_chain_t *chain,
+                                const uint32_t *list_characters, uint32_t list_characters_size,
+                                uint32_t **list_font_characters, uint32_t *list_font_characters_size)
+{
+    uint32_t i;
+    uint32_t font_index;
+    uint32_t offset = 0;
+    uint32_t *list_font_offset;
+    uint32_t *list_character_font;
+
+    memset(list_font_characters_size, 0, sizeof(uint32_t)*chain->list_font_count);
+    *list_font_characters = NULL;
+    if (!list_characters_size) {
+        return 0;
+    }
+
+    list_character_font = (uint32_t *)malloc(sizeof(uint32_t)*list_characters_size);
+    if (!list_character_font) {
+        return errno;
+    }
+    for (i=0;i<list_characters_size;i++) {
+        if (font_chain_get_font_index(chain, list_characters[i], &font_index)) {
+            list_character_font[i] = UINT32_MAX;
+            continue;
+        }
+        list_character_font[i] = font_index;
+        list_font_characters_size[font_index]++;
+    }
+
+    list_font_offset = (uint32_t *)malloc(sizeof(uint32_t)*chain->list_font_count);
+    *list_font_characters = (uint32_t *)malloc(sizeof(uint32_t)*list_characters_size);
+    if (!list_font_offset || !*list_font_characters) {
+        free(list_character_font);
+        free(list_font_offset);
+        free(*list_font_characters);
+        *list_font_characters = NULL;
+        return ENOMEM;
+    }
+    for (i=0;i<chain->list_font_count;i++) {
+        list_font_offset[i] = offset;
+        offset += list_font_characters_size[i];
+    }
+    for (i=0;i<list_characters_size;i++) {
+        if (list_character_font[i] != UINT32_MAX) {
+            (*list_font_characters)[list_font_offset[list_character_font[i]]++] = list_characters[i];
+        }
+    }
+
+    free(list_character_font);
+    free(list_font_offset);
+    return 0;
+}
@@ -0,0 +1,42 @@
+/*!
+ * \file
+ * \brief file font_chain.h
+ *
+ * Font fallback chain, each character is generated with
+ * the first font of the chain that has the character
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef FONT_CHAIN_H
+#define FONT_CHAIN_H
+
+#include <stdint.h>
+#include "prj-ttf-reader.h"
+#include "drawfont/glyph_graph_generator.h"
+
+/*!
+ * \brief The prj_ttf_reader_font_chain struct
+ *
+ * ordered list of opened fonts, use prj_ttf_reader_create_font_chain() to get
+ * and prj_ttf_reader_clear_font_chain() to clear
+ */
+struct prj_ttf_reader_font_chain
+{
+    prj_ttf_reader_font_t **list_font;  // fonts are not owned by the chain
+    const prj_ttf_reader_coverage_t **list_coverage;    // coverage of each font
+    uint32_t list_font_count;
+    glyph_graph_generator_workers_t workers;    // drawing threads and canvases of the chain
+};
+
+int font_chain_create(prj_ttf_reader_font_t *const *list_font, uint32_t list_font_count,
+                      prj_ttf_reader_font_chain_t **chain);
+void font_chain_clear(prj_ttf_reader_font_chain_t **chain);
+int font_chain_get_font_index(const prj_ttf_reader_font_chain_t *chain, uint32_t character, uint32_t *font_index);
+int font_chain_split_characters(const prj_ttf_reader_font_chain_t *chain,
+                                const uint32_t *list_characters, uint32_t list_characters_size,
+                                uint32_t **list_font_characters, uint32_t *list_font_characters_size);
+
+#endif // FONT_CHAIN_H
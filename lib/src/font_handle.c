@@ -0,0 +1,741 @@
+/*!
+ * \file
+ * \brief file font_handle.c
+ *
+ * Font handle, keeps the font file data and the parsed
+ * tables alive between the generate calls
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "font_handle.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "font_tables.h"
+#include "supported_characters/coverage.h"
+
+#ifdef TEST_CASE
+int font_handle_map_file_fails = 0;     // 1 makes font_handle_map_file() fail to test the read fallback
+#endif
+
+/*!
+ * \brief font_handle_read_file
+ *
+ * Reads the file, size of the file is taken from the opened
+ * file, so file_stat is the stat of the data that was read
+ *
+ * \param file_name
+ * \param file_data_size
+ * \param file_stat [out] stat of the opened file
+ * \return file data, NULL on failure
+ */
+static uint8_t *font_handle_read_file(const char* file_name, size_t *file_data_size, struct stat *file_stat)
+{
+    uint8_t *file_data;
+    size_t file_size, i;
+    FILE *fp = fopen(file_name, "r");
+    *file_data_size = 0;
+    if (!fp) {
+        return NULL;
+    }
+
+    if (fstat(fileno(fp), file_stat) || file_stat->st_size <= 0) {
+        fclose(fp);
+        return NULL;
+    }
+    file_size = (size_t)file_stat->st_size;
+
+    file_data = (uint8_t *)malloc(file_size);
+    if (!file_data) {
+        fclose(fp);
+        return NULL;
+    }
+    i = fread(file_data, 1, file_size, fp);
+    if (i != file_size) {
+        free(file_data);
+        file_data = NULL;
+    } else {
+        *file_data_size = file_size;
+    }
+    fclose(fp);
+    return file_data;
+}
+
+/*!
+ * \brief font_handle_map_file
+ *
+ * Maps the file read-only and shared, so processes that use
+ * the same font share the page cache copy of the file
+ *
+ * \param file_name
+ * \param file_data_size
+ * \param file_stat [out] stat of the mapped file
+ * \return mapped file data, NULL on failure
+ */
+static uint8_t *font_handle_map_file(const char* file_name, size_t *file_data_size, struct stat *file_stat)
+{
+    void *file_data;
+    int fd;
+
+    *file_data_size = 0;
+#ifdef TEST_CASE
+    if (font_handle_map_file_fails) {
+        return NULL;
+    }
+#endif
+    fd = open(file_name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+
+    if (fstat(fd, file_stat) || file_stat->st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    file_data = mmap(NULL, (size_t)file_stat->st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (file_data == MAP_FAILED) {
+        return NULL;
+    }
+
+    // tables are read in random order and the glyf table is read
+    // only partly, read-ahead of the whole file is not required
+    madvise(file_data, (size_t)file_stat->st_size, MADV_RANDOM);
+
+    *file_data_size = (size_t)file_stat->st_size;
+    return (uint8_t *)file_data;
+}
+
+/*!
+ * \brief font_handle_parse_tables
+ *
+ * parse the table records and the ttf tables that
+ * every call requires (head and maxp), other tables are
+ * parsed when font_handle_load_tables() is called
+ *
+ * \param data
+ * \param data_size
+ * \param face_offset offset of the offset table of the face
+ * \param tables
+ * \return 0 on success
+ */
+static int font_handle_parse_tables(const uint8_t *data, size_t data_size, size_t face_offset, font_tables_t *tables)
+{
+    int ret;
+    size_t offset = face_offset;
+    table_view_t view;
+
+    ret = otff_parse_offset_table(data, data_size, &offset, &tables->offsets);
+    if (ret) {
+        return ret;
+    }
+
+    ret = otff_parse_table_records(data, data_size, &offset, &tables->list_table_record, &tables->offsets);
+    if (ret) {
+        return ret;
+    }
+
+    otff_parse_table_directory(tables->list_table_record, tables->offsets.num_tables, data_size, &tables->table_directory);
+
+    ret = otff_get_table(&tables->table_directory, OTFF_TABLE_HEAD, &view);
+    if (ret) {
+        return ret;
+    }
+
+    ret = head_parse_head_table(data, view.offset + view.length, view.offset, &tables->header_table);
+    if (ret) {
+        return ret;
+    }
+
+    ret = otff_get_table(&tables->table_directory, OTFF_TABLE_MAXP, &view);
+    if (ret) {
+        return ret;
+    }
+
+    ret = maxp_parse_maximum_profile(data, view.offset + view.length, view.offset, &tables->max_profile);
+    if (ret) {
+        return ret;
+    }
+
+    if (tables->max_profile.glyphs_count == 0) {
+        return EINVAL;
+    }
+    return 0;
+}
+
+/*!
+ * \brief font_handle_get_shared_param
+ *
+ * parameters of the table that changes the parsed table,
+ * same table (offset) with same parameters can be shared
+ *
+ * \param tables
+ * \param table FONT_HANDLE_TABLE_LOCA or FONT_HANDLE_TABLE_HMTX
+ * \return parameters of the table
+ */
+static uint32_t font_handle_get_shared_param(const font_tables_t *tables, uint32_t table)
+{
+    if (table == FONT_HANDLE_TABLE_LOCA) {
+        return (uint32_t)tables->max_profile.glyphs_count << 16 | (uint16_t)tables->header_table.format;
+    }
+    return (uint32_t)tables->max_profile.glyphs_count << 16 | tables->hor_header_table.number_of_hmetrics;
+}
+
+/*!
+ * \brief font_handle_find_shared_table
+ *
+ * file->lock must be locked
+ *
+ * \param file
+ * \param table FONT_HANDLE_TABLE_LOCA or FONT_HANDLE_TABLE_HMTX
+ * \param offset offset of the table
+ * \param param parameters of the table
+ * \return index of the table in list_shared_table, UINT32_MAX if not found
+ */
+static uint32_t font_handle_find_shared_table(const font_file_t *file, uint32_t table, size_t offset, uint32_t param)
+{
+    uint32_t i;
+    for (i=0;i<file->list_shared_table_count;i++) {
+        if (file->list_shared_table[i].table == table
+                && file->list_shared_table[i].offset == offset
+                && file->list_shared_table[i].param == param) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+/*!
+ * \brief font_handle_load_shared_table
+ *
+ * Gets the loca or hmtx table from the other face of the font file
+ * if it's already parsed, otherwise parses the table and shares
+ * it for the other faces
+ *
+ * \param font
+ * \param table FONT_HANDLE_TABLE_LOCA or FONT_HANDLE_TABLE_HMTX
+ * \param view table view
+ * \return 0 on success
+ */
+static int font_handle_load_shared_table(prj_ttf_reader_font_t *font, uint32_t table, const table_view_t *view)
+{
+    int ret;
+    uint32_t index;
+    font_shared_table_t *tmp;
+    font_file_t *file = font->file;
+    font_tables_t *tables = &font->tables;
+    uint32_t param = font_handle_get_shared_param(tables, table);
+
+    pthread_mutex_lock(&file->lock);
+    index = font_handle_find_shared_table(file, table, view->offset, param);
+    if (index != UINT32_MAX) {
+        file->list_shared_table[index].ref_count++;
+        if (table == FONT_HANDLE_TABLE_LOCA) {
+            tables->list_index_loc_to_tables = file->list_shared_table[index].list_index_loc_to_tables;
+        } else {
+            tables->hor_metrics_table = file->list_shared_table[index].hor_metrics_table;
+        }
+        pthread_mutex_unlock(&file->lock);
+        return 0;
+    }
+
+    if (table == FONT_HANDLE_TABLE_LOCA) {
+        ret = loca_parse(file->data, view->offset + view->length, view->offset, &tables->list_index_loc_to_tables,
+                         (uint32_t)tables->max_profile.glyphs_count+1, tables->header_table.format);
+    } else {
+        ret = hmtx_parse(file->data, view->offset + view->length,
+                         &tables->hor_metrics_table, view->offset,
+                         &tables->hor_header_table, &tables->max_profile);
+    }
+    if (ret) {
+        pthread_mutex_unlock(&file->lock);
+        return ret;
+    }
+
+    tmp = (font_shared_table_t *)realloc(file->list_shared_table,
+                                         sizeof(font_shared_table_t)*(file->list_shared_table_count+1));
+    if (!tmp) {
+        pthread_mutex_unlock(&file->lock);
+        return errno;
+    }
+    file->list_shared_table = tmp;
+    memset(&file->list_shared_table[file->list_shared_table_count], 0, sizeof(font_shared_table_t));
+    file->list_shared_table[file->list_shared_table_count].table = table;
+    file->list_shared_table[file->list_shared_table_count].offset = view->offset;
+    file->list_shared_table[file->list_shared_table_count].param = param;
+    file->list_shared_table[file->list_shared_table_count].ref_count = 1;
+    file->list_shared_table[file->list_shared_table_count].list_index_loc_to_tables = tables->list_index_loc_to_tables;
+    file->list_shared_table[file->list_shared_table_count].hor_metrics_table = tables->hor_metrics_table;
+    if (table == FONT_HANDLE_TABLE_LOCA) {
+        memset(&file->list_shared_table[file->list_shared_table_count].hor_metrics_table, 0, sizeof(horizontal_metrics_table_t));
+    } else {
+        file->list_shared_table[file->list_shared_table_count].list_index_loc_to_tables = NULL;
+    }
+    file->list_shared_table_count++;
+    pthread_mutex_unlock(&file->lock);
+    return 0;
+}
+
+/*!
+ * \brief font_handle_release_shared_table
+ *
+ * Releases the shared loca or hmtx table of the font,
+ * table is cleared when the last face releases it
+ *
+ * \param font
+ * \param table FONT_HANDLE_TABLE_LOCA or FONT_HANDLE_TABLE_HMTX
+ */
+static void font_handle_release_shared_table(prj_ttf_reader_font_t *font, uint32_t table)
+{
+    uint32_t index;
+    table_view_t view;
+    font_file_t *file = font->file;
+
+    if (otff_get_table(&font->tables.table_directory,
+                       table == FONT_HANDLE_TABLE_LOCA ? OTFF_TABLE_LOCA : OTFF_TABLE_HMTX, &view)) {
+        return;
+    }
+
+    pthread_mutex_lock(&file->lock);
+    index = font_handle_find_shared_table(file, table, view.offset, font_handle_get_shared_param(&font->tables, table));
+    if (index != UINT32_MAX) {
+        file->list_shared_table[index].ref_count--;
+        if (!file->list_shared_table[index].ref_count) {
+            loca_clear(&file->list_shared_table[index].list_index_loc_to_tables);
+            hmtx_clear(&file->list_shared_table[index].hor_metrics_table);
+            file->list_shared_table_count--;
+            if (index != file->list_shared_table_count) {
+                file->list_shared_table[index] = file->list_shared_table[file->list_shared_table_count];
+            }
+        }
+    }
+    pthread_mutex_unlock(&file->lock);
+}
+
+/*!
+ * \brief font_handle_clear_tables
+ *
+ * Clears the font_tables of the font, shared tables are released
+ *
+ * \param font
+ */
+static void font_handle_clear_tables(prj_ttf_reader_font_t *font)
+{
+    font_tables_t *tables = &font->tables;
+
+    if (font->loaded_tables & FONT_HANDLE_TABLE_LOCA) {
+        font_handle_release_shared_table(font, FONT_HANDLE_TABLE_LOCA);
+        tables->list_index_loc_to_tables = NULL;
+    }
+    if (font->loaded_tables & FONT_HANDLE_TABLE_HMTX) {
+        font_handle_release_shared_table(font, FONT_HANDLE_TABLE_HMTX);
+        memset(&tables->hor_metrics_table, 0, sizeof(horizontal_metrics_table_t));
+    }
+
+    name_clear(&tables->name_table);
+    loca_clear(&tables->list_index_loc_to_tables);
+    cmap_clear(&tables->character_to_glyph_index_table);
+    coverage_clear(&font->coverage);
+    hmtx_clear(&tables->hor_metrics_table);
+    otff_clear(&tables->list_table_record);
+}
+
+/*!
+ * \brief font_handle_load_table
+ *
+ * parse the single table
+ *
+ * \param font
+ * \param table FONT_HANDLE_TABLE_* value
+ * \return 0 on success
+ */
+static int font_handle_load_table(prj_ttf_reader_font_t *font, uint32_t table)
+{
+    int ret;
+    table_view_t view;
+    size_t table_end;
+    font_tables_t *tables = &font->tables;
+
+    switch (table) {
+        case FONT_HANDLE_TABLE_CMAP:
+            ret = otff_get_table(&tables->table_directory, OTFF_TABLE_CMAP, &view);
+            if (ret) {
+                return ret;
+            }
+            table_end = view.offset + view.length;
+            return cmap_parse_character_to_glyph_index_mapping_table(font->file_data, table_end, view.offset,
+                                                                     &tables->character_to_glyph_index_table);
+        case FONT_HANDLE_TABLE_LOCA:
+            ret = otff_get_table(&tables->table_directory, OTFF_TABLE_LOCA, &view);
+            if (ret) {
+                return ret;
+            }
+            return font_handle_load_shared_table(font, table, &view);
+        case FONT_HANDLE_TABLE_HHEA:
+            ret = otff_get_table(&tables->table_directory, OTFF_TABLE_HHEA, &view);
+            if (ret) {
+                return ret;
+            }
+            table_end = view.offset + view.length;
+            return hhea_parse(font->file_data, table_end, view.offset, &tables->hor_header_table);
+        case FONT_HANDLE_TABLE_HMTX:
+            ret = otff_get_table(&tables->table_directory, OTFF_TABLE_HMTX, &view);
+            if (ret) {
+                return ret;
+            }
+            return font_handle_load_shared_table(font, table, &view);
+        case FONT_HANDLE_TABLE_NAME:
+            ret = otff_get_table(&tables->table_directory, OTFF_TABLE_NAME, &view);
+            if (ret) {
+                return ret;
+            }
+            table_end = view.offset + view.length;
+            return name_parse_naming_table(font->file_data, table_end, view.offset, &tables->name_table);
+        case FONT_HANDLE_TABLE_COVERAGE:
+            return coverage_build(&tables->character_to_glyph_index_table, tables->max_profile.glyphs_count,
+                                  &font->coverage);
+        default:
+            break;
+    }
+    return EINVAL;
+}
+
+/*!
+ * \brief font_handle_load_tables
+ *
+ * parse the tables that are not yet parsed, each table
+ * is parsed only once, the first time it's required
+ *
+ * \param font
+ * \param tables FONT_HANDLE_TABLE_* values combined with |
+ * \return 0 on success
+ */
+int font_handle_load_tables(prj_ttf_reader_font_t *font, uint32_t tables)
+{
+    int ret;
+    uint32_t table;
+
+    // hmtx parsing requires hhea
+    if (tables & FONT_HANDLE_TABLE_HMTX) {
+        tables |= FONT_HANDLE_TABLE_HHEA;
+    }
+    // coverage is built from cmap
+    if (tables & FONT_HANDLE_TABLE_COVERAGE) {
+        tables |= FONT_HANDLE_TABLE_CMAP;
+    }
+
+    pthread_mutex_lock(&font->lock);
+    for (table=1;table<=FONT_HANDLE_TABLE_COVERAGE;table<<=1) {
+        if (!(tables & table) || (font->loaded_tables & table)) {
+            continue;
+        }
+        // partly parsed table is not parsed again, it's cleared on close
+        if (font->failed_tables & table) {
+            pthread_mutex_unlock(&font->lock);
+            return EINVAL;
+        }
+        ret = font_handle_load_table(font, table);
+        if (ret) {
+            font->failed_tables |= table;
+            pthread_mutex_unlock(&font->lock);
+            return ret;
+        }
+        font->loaded_tables |= table;
+    }
+    pthread_mutex_unlock(&font->lock);
+    return 0;
+}
+
+/*!
+ * \brief font_handle_destroy_file
+ *
+ * Releases the font data and clears the font file
+ *
+ * \param file
+ */
+static void font_handle_destroy_file(font_file_t *file)
+{
+    uint32_t i;
+    for (i=0;i<file->list_shared_table_count;i++) {
+        loca_clear(&file->list_shared_table[i].list_index_loc_to_tables);
+        hmtx_clear(&file->list_shared_table[i].hor_metrics_table);
+    }
+    free(file->list_shared_table);
+    if (file->data_owner == FONT_HANDLE_DATA_MMAP) {
+        munmap(file->data, file->data_size);
+    } else if (file->data_owner == FONT_HANDLE_DATA_MALLOC) {
+        free(file->data);
+    }
+    pthread_mutex_destroy(&file->lock);
+    free(file);
+}
+
+/*!
+ * \brief font_handle_release_file
+ *
+ * Releases the reference of the font file, font file
+ * is destroyed when the last reference is released
+ *
+ * \param file
+ */
+static void font_handle_release_file(font_file_t *file)
+{
+    uint32_t ref_count;
+
+    pthread_mutex_lock(&file->lock);
+    file->ref_count--;
+    ref_count = file->ref_count;
+    pthread_mutex_unlock(&file->lock);
+    if (!ref_count) {
+        font_handle_destroy_file(file);
+    }
+}
+
+/*!
+ * \brief font_handle_open_face
+ *
+ * Opens the face of the font file, the face uses the same font data
+ * and the same shared tables as the other faces of the font file
+ *
+ * \param file font file
+ * \param face_index index of the face in font collection, 0 if font is not a collection
+ * \param font [out] opened face, NULL on failure
+ * \return 0 on success
+ */
+int font_handle_open_face(font_file_t *file, uint32_t face_index, prj_ttf_reader_font_t **font)
+{
+    int ret;
+    size_t face_offset;
+    prj_ttf_reader_font_t *new_font;
+
+    *font = NULL;
+    if (face_index >= file->face_count) {
+        return EINVAL;
+    }
+
+    new_font = (prj_ttf_reader_font_t *)calloc(1, sizeof(prj_ttf_reader_font_t));
+    if (!new_font) {
+        return errno;
+    }
+
+    pthread_mutex_lock(&file->lock);
+    file->ref_count++;
+    pthread_mutex_unlock(&file->lock);
+
+    pthread_mutex_init(&new_font->lock, NULL);
+    glyph_cache_init(&new_font->glyph_cache, 0, PRJ_TTF_READER_GLYPH_CACHE_DEFAULT_SIZE);
+    glyph_graph_generator_workers_init(&new_font->workers);
+    new_font->file = file;
+    new_font->face_index = face_index;
+    new_font->file_data = file->data;
+    new_font->file_data_size = file->data_size;
+
+    ret = otff_get_face_offset(file->data, file->data_size, face_index, &face_offset);
+    if (!ret) {
+        ret = font_handle_parse_tables(new_font->file_data, new_font->file_data_size, face_offset, &new_font->tables);
+    }
+    if (ret) {
+        font_handle_close(&new_font);
+        return ret;
+    }
+    new_font->glyph_cache.glyphs_count = new_font->tables.max_profile.glyphs_count;
+
+    *font = new_font;
+    return 0;
+}
+
+/*!
+ * \brief font_handle_open_data
+ *
+ * Opens the face of the font data, all opens are routed here
+ * On failure the font data is released by data_owner
+ *
+ * \param file_data font data
+ * \param file_data_size size of font data
+ * \param data_owner FONT_HANDLE_DATA_MALLOC, FONT_HANDLE_DATA_MMAP or FONT_HANDLE_DATA_BORROWED
+ * \param face_index index of the face in font collection, 0 if font is not a collection
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+static int font_handle_open_data(uint8_t *file_data, size_t file_data_size, int data_owner, uint32_t face_index,
+                                 prj_ttf_reader_font_t **font)
+{
+    int ret;
+    font_file_t *file;
+
+    file = (font_file_t *)calloc(1, sizeof(font_file_t));
+    if (!file) {
+        ret = errno;
+        if (data_owner == FONT_HANDLE_DATA_MMAP) {
+            munmap(file_data, file_data_size);
+        } else if (data_owner == FONT_HANDLE_DATA_MALLOC) {
+            free(file_data);
+        }
+        return ret;
+    }
+
+    pthread_mutex_init(&file->lock, NULL);
+    file->data = file_data;
+    file->data_size = file_data_size;
+    file->data_owner = data_owner;
+    // reference of this function, released after the face is opened
+    file->ref_count = 1;
+
+    ret = otff_get_face_count(file_data, file_data_size, &file->face_count);
+    if (!ret) {
+        ret = font_handle_open_face(file, face_index, font);
+    }
+    font_handle_release_file(file);
+    return ret;
+}
+
+/*!
+ * \brief font_handle_open
+ *
+ * Reads (or maps) the font file and parses the tables
+ * If mapping the file fails, the file is read instead
+ *
+ * \param font_file_name full filepath of ttf file
+ * \param load_mode PRJ_TTF_READER_LOAD_MODE_READ or PRJ_TTF_READER_LOAD_MODE_MMAP
+ * \param face_index index of the face in font collection, 0 if font is not a collection
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int font_handle_open(const char *font_file_name, int load_mode, uint32_t face_index, prj_ttf_reader_font_t **font)
+{
+    int ret;
+    uint8_t *file_data = NULL;
+    size_t file_data_size = 0;
+    struct stat file_stat;
+    int data_owner = FONT_HANDLE_DATA_MMAP;
+
+    *font = NULL;
+    if (load_mode == PRJ_TTF_READER_LOAD_MODE_MMAP) {
+        file_data = font_handle_map_file(font_file_name, &file_data_size, &file_stat);
+    }
+    if (!file_data) {
+        data_owner = FONT_HANDLE_DATA_MALLOC;
+        file_data = font_handle_read_file(font_file_name, &file_data_size, &file_stat);
+        if (!file_data) {
+            return 1;
+        }
+    }
+
+    ret = font_handle_open_data(file_data, file_data_size, data_owner, face_index, font);
+    if (ret) {
+        return ret;
+    }
+    (*font)->file->file_stat = file_stat;
+    return 0;
+}
+
+/*!
+ * \brief font_handle_open_memory
+ *
+ * Parses the tables of the font data in memory
+ *
+ * \param font_data font data
+ * \param font_data_size size of font data
+ * \param memory_mode PRJ_TTF_READER_MEMORY_MODE_COPY copies the font data,
+ * PRJ_TTF_READER_MEMORY_MODE_BORROW uses font_data without copying
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int font_handle_open_memory(const uint8_t *font_data, size_t font_data_size, int memory_mode, prj_ttf_reader_font_t **font)
+{
+    uint8_t *file_data;
+
+    *font = NULL;
+    if (memory_mode == PRJ_TTF_READER_MEMORY_MODE_BORROW) {
+        // font data is never modified, it's only kept as non-const
+        // to share the same field with the owned data
+        return font_handle_open_data((uint8_t *)(uintptr_t)font_data, font_data_size, FONT_HANDLE_DATA_BORROWED, 0, font);
+    }
+
+    file_data = (uint8_t *)malloc(font_data_size);
+    if (!file_data) {
+        return errno;
+    }
+    memcpy(file_data, font_data, font_data_size);
+    return font_handle_open_data(file_data, font_data_size, FONT_HANDLE_DATA_MALLOC, 0, font);
+}
+
+/*!
+ * \brief font_handle_close
+ *
+ * Clears the font and sets it NULL, font data is released
+ * when the last face of the font file is closed
+ *
+ * \param font [in/out]
+ */
+void font_handle_close(prj_ttf_reader_font_t **font)
+{
+    font_file_t *file;
+
+    if (!*font) {
+        return;
+    }
+
+    file = (*font)->file;
+    font_handle_clear_tables(*font);
+    glyph_cache_clear(&(*font)->glyph_cache);
+    glyph_graph_generator_workers_clear(&(*font)->workers);
+    pthread_mutex_destroy(&(*font)->lock);
+    free(*font);
+    *font = NULL;
+    font_handle_release_file(file);
+}
+
+/*!
+ * \brief font_handle_init_generate
+ *
+ * Inits the temporary data of generate call, options of the font
+ * are copied under the lock, so they can be changed from other
+ * threads while the font is used
+ *
+ * \param font
+ * \param generate [out]
+ */
+void font_handle_init_generate(prj_ttf_reader_font_t *font, font_generate_t *generate)
+{
+    memset(generate, 0, sizeof(font_generate_t));
+    generate->glyph_cache = &font->glyph_cache;
+    generate->workers = &font->workers;
+    pthread_mutex_lock(&font->lock);
+    generate->fill_mode = font->fill_mode;
+    generate->max_glyph_memory_size = font->max_glyph_memory_size;
+    generate->thread_count = font->thread_count;
+    pthread_mutex_unlock(&font->lock);
+}
+
+/*!
+ * \brief font_handle_clear_generate
+ *
+ * Clears the temporary data of generate call and releases
+ * the cached glyph outlines
+ *
+ * \param generate
+ */
+void font_handle_clear_generate(font_generate_t *generate)
+{
+    uint32_t i;
+
+    for (i=0;i<generate->list_glyph_character_count;i++) {
+        if (generate->list_glyph_character[i].is_cached) {
+            glyph_cache_release(generate->glyph_cache, generate->list_glyph_character[i].glyph);
+        }
+    }
+    glyf_clear(&generate->list_glyph, &generate->arena);
+    free(generate->list_glyph_character);
+    generate->list_glyph_character = NULL;
+    generate->list_glyph_character_count = 0;
+}
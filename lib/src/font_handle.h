@@ -0,0 +1,114 @@
+/*!
+ * \file
+ * \brief file font_handle.h
+ *
+ * Font handle, keeps the font file data and the parsed
+ * tables alive between the generate calls
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef FONT_HANDLE_H
+#define FONT_HANDLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "prj-ttf-reader.h"
+#include "font_tables.h"
+#include "drawfont/glyph_graph_generator.h"
+
+/*!
+ * \brief owner of font_file_t data
+ */
+#define FONT_HANDLE_DATA_MALLOC     0   // data is malloc'ed, freed on close
+#define FONT_HANDLE_DATA_MMAP       1   // data is mmap'ed, unmapped on close
+#define FONT_HANDLE_DATA_BORROWED   2   // data is owned by the caller
+
+/*!
+ * \brief tables of font_handle_load_tables()
+ * the table records, head and maxp are always parsed on open
+ */
+#define FONT_HANDLE_TABLE_CMAP      0x01
+#define FONT_HANDLE_TABLE_HHEA      0x02
+#define FONT_HANDLE_TABLE_HMTX      0x04
+#define FONT_HANDLE_TABLE_LOCA      0x08
+#define FONT_HANDLE_TABLE_NAME      0x10
+#define FONT_HANDLE_TABLE_COVERAGE  0x20    // built from cmap, not a font table
+
+/*!
+ * \brief The font_shared_table_t struct
+ *
+ * Parsed table that is shared between the faces of the
+ * font collection, faces that have the same table (same offset
+ * and same parameters) use the same parsed table
+ */
+typedef struct
+{
+    uint32_t table;     // FONT_HANDLE_TABLE_LOCA or FONT_HANDLE_TABLE_HMTX
+    size_t offset;      // offset of the table in font data
+    uint32_t param;     // parameters of the parsed table, see font_handle_get_shared_param()
+    uint32_t ref_count; // number of faces that use this table
+    index_to_loc_table_t *list_index_loc_to_tables;
+    horizontal_metrics_table_t hor_metrics_table;
+} font_shared_table_t;
+
+/*!
+ * \brief The font_file_t struct
+ *
+ * font data (the font file) that is shared between
+ * the faces of the font collection
+ */
+typedef struct
+{
+    uint8_t *data;
+    size_t data_size;
+    int data_owner;     // FONT_HANDLE_DATA_MALLOC, FONT_HANDLE_DATA_MMAP or FONT_HANDLE_DATA_BORROWED
+    struct stat file_stat;  // stat of the opened font file (fstat of the read or mapped file), zero if font is from memory
+    uint32_t face_count;
+    uint32_t ref_count; // number of faces that use this file
+    pthread_mutex_t lock;   // locks ref_count and list_shared_table
+    font_shared_table_t *list_shared_table;
+    uint32_t list_shared_table_count;
+} font_file_t;
+
+/*!
+ * \brief The prj_ttf_reader_font struct
+ *
+ * opened font (single face of the font file), use prj_ttf_reader_open_font() to get
+ * and prj_ttf_reader_close_font() to clear
+ */
+struct prj_ttf_reader_font
+{
+    font_file_t *file;
+    uint32_t face_index;
+    uint8_t *file_data;     // same as file->data
+    size_t file_data_size;  // same as file->data_size
+    font_tables_t tables;
+    prj_ttf_reader_coverage_t coverage;
+    glyph_cache_t glyph_cache;  // parsed glyph outlines, kept between the generate calls
+    int fill_mode;          // PRJ_TTF_READER_FILL_MODE_* of the generated glyphs, locked by lock
+    size_t max_glyph_memory_size;   // max memory size of the canvas of single glyph, 0 if there is no limit, locked by lock
+    uint32_t thread_count;  // count of the drawing threads, 0 is the count of the processors, locked by lock
+    glyph_graph_generator_workers_t workers;    // drawing threads and canvases, kept between the generate calls
+    uint32_t loaded_tables; // FONT_HANDLE_TABLE_* values of parsed tables
+    uint32_t failed_tables; // FONT_HANDLE_TABLE_* values of tables that failed to parse
+    pthread_mutex_t lock;   // locks the table loading and the options, font can be used from many threads
+
+    int is_shared;          // 1 if font is from font_registry_acquire(), released with font_registry_release()
+    uint32_t ref_count;     // references of shared font, locked by font registry
+};
+
+int font_handle_open(const char *font_file_name, int load_mode, uint32_t face_index, prj_ttf_reader_font_t **font);
+int font_handle_open_memory(const uint8_t *font_data, size_t font_data_size, int memory_mode, prj_ttf_reader_font_t **font);
+int font_handle_open_face(font_file_t *file, uint32_t face_index, prj_ttf_reader_font_t **font);
+int font_handle_load_tables(prj_ttf_reader_font_t *font, uint32_t tables);
+void font_handle_close(prj_ttf_reader_font_t **font);
+
+void font_handle_init_generate(prj_ttf_reader_font_t *font, font_generate_t *generate);
+void font_handle_clear_generate(font_generate_t *generate);
+
+#endif // FONT_HANDLE_H
@@ -0,0 +1,286 @@
+/*!
+ * \file
+ * \brief file font_registry.c
+ *
+ * Process-wide registry of shared fonts, the same font file
+ * is opened only once and shared with reference count
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "font_registry.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "font_handle.h"
+
+/*!
+ * \brief The font_registry_entry_t struct
+ *
+ * Single shared font, key is canonical path, face index, load mode
+ * and the device, inode, modification time and size of the opened
+ * font file (font->file->file_stat)
+ */
+typedef struct
+{
+    char *path;             // canonical path of font file
+    uint32_t face_index;
+    int load_mode;          // PRJ_TTF_READER_LOAD_MODE_READ or PRJ_TTF_READER_LOAD_MODE_MMAP
+    prj_ttf_reader_font_t *font;
+} font_registry_entry_t;
+
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static font_registry_entry_t *list_entry = NULL;
+static uint32_t list_entry_count = 0;
+
+/*!
+ * \brief font_registry_is_same_file
+ *
+ * \param entry
+ * \param file_stat
+ * \return 1 if entry is for the same (unchanged) file
+ */
+static int font_registry_is_same_file(const font_registry_entry_t *entry, const struct stat *file_stat)
+{
+    const struct stat *entry_stat = &entry->font->file->file_stat;
+    return entry_stat->st_dev == file_stat->st_dev
+            && entry_stat->st_ino == file_stat->st_ino
+            && entry_stat->st_size == file_stat->st_size
+            && entry_stat->st_mtim.tv_sec == file_stat->st_mtim.tv_sec
+            && entry_stat->st_mtim.tv_nsec == file_stat->st_mtim.tv_nsec;
+}
+
+/*!
+ * \brief font_registry_remove_entry
+ *
+ * Removes the entry from registry, the font of the entry is
+ * not closed, it's closed when the last reference is released
+ * registry_lock must be locked
+ *
+ * \param index index of entry in list_entry
+ */
+static void font_registry_remove_entry(uint32_t index)
+{
+    free(list_entry[index].path);
+    list_entry_count--;
+    if (index != list_entry_count) {
+        list_entry[index] = list_entry[list_entry_count];
+    }
+    if (!list_entry_count) {
+        free(list_entry);
+        list_entry = NULL;
+    }
+}
+
+/*!
+ * \brief font_registry_remove_stale_entries
+ *
+ * Removes the entries of the font file that is changed after it
+ * was opened, fonts of removed entries are kept for current users
+ * registry_lock must be locked
+ *
+ * \param path canonical path of font file
+ * \param file_stat stat of the current font file
+ */
+static void font_registry_remove_stale_entries(const char *path, const struct stat *file_stat)
+{
+    uint32_t i = 0;
+    while (i < list_entry_count) {
+        if (!strcmp(list_entry[i].path, path) && !font_registry_is_same_file(&list_entry[i], file_stat)) {
+            font_registry_remove_entry(i);
+        } else {
+            i++;
+        }
+    }
+}
+
+/*!
+ * \brief font_registry_find_entry
+ *
+ * registry_lock must be locked
+ *
+ * \param path canonical path of font file
+ * \param file_stat stat of the font file
+ * \param face_index index of the face
+ * \param load_mode PRJ_TTF_READER_LOAD_MODE_READ or PRJ_TTF_READER_LOAD_MODE_MMAP
+ * \return index of entry in list_entry, UINT32_MAX if not found
+ */
+static uint32_t font_registry_find_entry(const char *path, const struct stat *file_stat, uint32_t face_index, int load_mode)
+{
+    uint32_t i;
+    for (i=0;i<list_entry_count;i++) {
+        if (list_entry[i].face_index == face_index && list_entry[i].load_mode == load_mode
+                && !strcmp(list_entry[i].path, path) && font_registry_is_same_file(&list_entry[i], file_stat)) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+/*!
+ * \brief font_registry_find_file
+ *
+ * finds the other face of the same (unchanged) font file
+ * registry_lock must be locked
+ *
+ * \param path canonical path of font file
+ * \param file_stat
+ * \param load_mode PRJ_TTF_READER_LOAD_MODE_READ or PRJ_TTF_READER_LOAD_MODE_MMAP
+ * \return font file, NULL if not found
+ */
+static font_file_t *font_registry_find_file(const char *path, const struct stat *file_stat, int load_mode)
+{
+    uint32_t i;
+    for (i=0;i<list_entry_count;i++) {
+        if (list_entry[i].load_mode == load_mode && !strcmp(list_entry[i].path, path)
+                && font_registry_is_same_file(&list_entry[i], file_stat)) {
+            return list_entry[i].font->file;
+        }
+    }
+    return NULL;
+}
+
+/*!
+ * \brief font_registry_acquire
+ *
+ * Gets the shared font of font file, opens the font file if it's
+ * not yet opened or if the font file is changed after it was opened
+ * Release the font with font_registry_release()
+ *
+ * Font file is read without locking the registry, the new font is
+ * keyed with the stat of the opened file (not the stat of the path),
+ * if the same font was opened at the same time, the first one is shared
+ *
+ * Faces of the same font collection share the same font file
+ *
+ * Font that was read (PRJ_TTF_READER_LOAD_MODE_READ) keeps its own copy,
+ * so it's not affected when the font file is changed. Mapped font
+ * (PRJ_TTF_READER_LOAD_MODE_MMAP) sees the changes that are written into
+ * the same file, only a font file that is replaced (new inode) is safe
+ *
+ * \param font_file_name full filepath of ttf file
+ * \param face_index index of the face in font collection, 0 if font is not a collection
+ * \param load_mode PRJ_TTF_READER_LOAD_MODE_READ or PRJ_TTF_READER_LOAD_MODE_MMAP
+ * \param font [out] shared font, NULL on failure
+ * \return 0 on success
+ */
+int font_registry_acquire(const char *font_file_name, uint32_t face_index, int load_mode, prj_ttf_reader_font_t **font)
+{
+    int ret;
+    uint32_t index;
+    font_file_t *file;
+    struct stat file_stat;
+    char path[PATH_MAX];
+    font_registry_entry_t *tmp;
+    prj_ttf_reader_font_t *new_font = NULL;
+
+    *font = NULL;
+    if (!realpath(font_file_name, path)) {
+        return errno;
+    }
+    if (stat(path, &file_stat)) {
+        return errno;
+    }
+
+    pthread_mutex_lock(&registry_lock);
+    index = font_registry_find_entry(path, &file_stat, face_index, load_mode);
+    if (index != UINT32_MAX) {
+        list_entry[index].font->ref_count++;
+        *font = list_entry[index].font;
+        pthread_mutex_unlock(&registry_lock);
+        return 0;
+    }
+
+    // other face of the font collection is parsed from the font data in memory,
+    // registry keeps the font file open until font_handle_open_face() takes its reference
+    file = font_registry_find_file(path, &file_stat, load_mode);
+    if (file) {
+        ret = font_handle_open_face(file, face_index, &new_font);
+        pthread_mutex_unlock(&registry_lock);
+    } else {
+        pthread_mutex_unlock(&registry_lock);
+        ret = font_handle_open(path, load_mode, face_index, &new_font);
+    }
+    if (ret) {
+        return ret;
+    }
+
+    pthread_mutex_lock(&registry_lock);
+    // same font was opened by other thread at the same time
+    index = font_registry_find_entry(path, &new_font->file->file_stat, face_index, load_mode);
+    if (index != UINT32_MAX) {
+        list_entry[index].font->ref_count++;
+        *font = list_entry[index].font;
+        pthread_mutex_unlock(&registry_lock);
+        font_handle_close(&new_font);
+        return 0;
+    }
+
+    font_registry_remove_stale_entries(path, &new_font->file->file_stat);
+
+    tmp = (font_registry_entry_t *)realloc(list_entry, sizeof(font_registry_entry_t)*(list_entry_count+1));
+    if (!tmp) {
+        ret = errno;
+        pthread_mutex_unlock(&registry_lock);
+        font_handle_close(&new_font);
+        return ret;
+    }
+    list_entry = tmp;
+
+    list_entry[list_entry_count].path = strdup(path);
+    if (!list_entry[list_entry_count].path) {
+        ret = errno;
+        pthread_mutex_unlock(&registry_lock);
+        font_handle_close(&new_font);
+        return ret;
+    }
+    list_entry[list_entry_count].face_index = face_index;
+    list_entry[list_entry_count].load_mode = load_mode;
+    list_entry[list_entry_count].font = new_font;
+    list_entry_count++;
+
+    new_font->is_shared = 1;
+    new_font->ref_count = 1;
+    *font = new_font;
+    pthread_mutex_unlock(&registry_lock);
+    return 0;
+}
+
+/*!
+ * \brief font_registry_release
+ *
+ * Releases the shared font, font is closed and removed from
+ * the registry when the last reference is released
+ *
+ * \param font [in/out] sets font to NULL
+ */
+void font_registry_release(prj_ttf_reader_font_t **font)
+{
+    uint32_t i;
+
+    if (!*font) {
+        return;
+    }
+
+    pthread_mutex_lock(&registry_lock);
+    (*font)->ref_count--;
+    if ((*font)->ref_count) {
+        pthread_mutex_unlock(&registry_lock);
+        *font = NULL;
+        return;
+    }
+
+    for (i=0;i<list_entry_count;i++) {
+        if (list_entry[i].font == *font) {
+            font_registry_remove_entry(i);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&registry_lock);
+    font_handle_close(font);
+}
@@ -0,0 +1,21 @@
+/*!
+ * \file
+ * \brief file font_registry.h
+ *
+ * Process-wide registry of shared fonts, the same font file
+ * is opened only once and shared with reference count
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef FONT_REGISTRY_H
+#define FONT_REGISTRY_H
+
+#include "prj-ttf-reader.h"
+
+int font_registry_acquire(const char *font_file_name, uint32_t face_index, int load_mode, prj_ttf_reader_font_t **font);
+void font_registry_release(prj_ttf_reader_font_t **font);
+
+#endif // FONT_REGISTRY_H
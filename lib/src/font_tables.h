@@ -17,11 +17,13 @@
 #include "reader/head.h"
 #include "reader/hhea.h"
 #include "reader/loca.h"
-#include "reader/kern.h"
 #include "reader/name.h"
 #include "reader/otff.h"
 #include "reader/maxp.h"
 #include "reader/hmtx.h"
+#include "glyph_cache.h"
+
+typedef struct glyph_graph_generator_workers glyph_graph_generator_workers_t;
 
 typedef struct {
     int x, y;
@@ -43,7 +45,7 @@ typedef struct
 {
     offset_table_t offsets;
     table_record_t *list_table_record;  // list size is offsets.num_tables
-    character_table_t corr_character_table;
+    table_directory_t table_directory;  // list_table_record indexed by table_id_t
     character_to_glyph_index_mapping_table_t character_to_glyph_index_table;
     naming_table_t name_table;
     maximum_profile_t max_profile;
@@ -51,11 +53,40 @@ typedef struct
     horizontal_metrics_table_t hor_metrics_table;
     horizontal_header_table_t hor_header_table;
     font_header_table_t header_table;
-    glyph_t *list_glyph; // list of glyphs (count is max_profile.glyphs_count)
-
-    // own temporary
-    font_size_t *list_font_sizes;
-    int16_t list_font_sizes_count;
 } font_tables_t;
 
+/*!
+ * \brief The glyph_character_t struct
+ *
+ * requested character and its glyph index
+ */
+typedef struct {
+    uint16_t glyph_index;
+    uint32_t character;
+    int16_t min_x, min_y;   // bounding box from the header of the glyph
+    int16_t max_x, max_y;
+    const glyph_t *glyph;   // parsed outline of the glyph, NULL until the glyph is needed
+    int is_cached;          // 1 if glyph is from glyph_cache and must be released (set only for the first character of the glyph)
+} glyph_character_t;
+
+/*!
+ * \brief The font_generate_t struct
+ *
+ * Temporary data for a single generate call, font_tables_t
+ * is not changed while generating, so the same font_tables_t
+ * can be used for many generate calls
+ */
+typedef struct
+{
+    glyph_t *list_glyph; // list of glyphs (count is max_profile.glyphs_count), allocated only if glyph is not in cache
+    glyph_cache_t *glyph_cache; // outline cache of the font, NULL if not used
+    arena_t arena;          // data of list_glyph
+    glyph_character_t *list_glyph_character; // requested characters that font has, sorted by glyph index
+    uint32_t list_glyph_character_count;
+    int fill_mode;          // PRJ_TTF_READER_FILL_MODE_*
+    size_t max_glyph_memory_size;   // max memory size of the canvas of single glyph, 0 if there is no limit
+    uint32_t thread_count;  // count of the drawing threads, 0 is the count of the processors
+    glyph_graph_generator_workers_t *workers;   // drawing threads of the font or the chain, NULL if not kept
+} font_generate_t;
+
 #endif // FONT_TABLES_H
@@ -0,0 +1,380 @@
+/*!
+ * \file
+ * \brief file glyph_cache.c
+ *
+ * Cache of the parsed glyph outlines, keeps the outlines
+ * of the font between the generate calls
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "glyph_cache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*!
+ * \brief glyph_cache_unlink
+ *
+ * removes the entry from LRU list
+ *
+ * \param cache
+ * \param entry
+ */
+static void glyph_cache_unlink(glyph_cache_t *cache, glyph_cache_entry_t *entry)
+{
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        cache->first = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        cache->last = entry->prev;
+    }
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+/*!
+ * \brief glyph_cache_link_first
+ *
+ * adds the entry as most recently used
+ *
+ * \param cache
+ * \param entry
+ */
+static void glyph_cache_link_first(glyph_cache_t *cache, glyph_cache_entry_t *entry)
+{
+    entry->prev = NULL;
+    entry->next = cache->first;
+    if (cache->first) {
+        cache->first->prev = entry;
+    } else {
+        cache->last = entry;
+    }
+    cache->first = entry;
+}
+
+/*!
+ * \brief glyph_cache_get_entry
+ *
+ * \param glyph outline from glyph_cache_acquire() or glyph_cache_insert()
+ * \return entry of the cached outline
+ */
+static glyph_cache_entry_t *glyph_cache_get_entry(const glyph_t *glyph)
+{
+    return (glyph_cache_entry_t *)(void *)((uint8_t *)(uintptr_t)glyph - offsetof(glyph_cache_entry_t, glyph));
+}
+
+/*!
+ * \brief glyph_cache_unpin_components
+ *
+ * components of the cached composite glyph are kept
+ * in the cache while the composite glyph is cached
+ *
+ * \param glyph cached glyph
+ * \param component_count count of components to unpin
+ */
+static void glyph_cache_unpin_components(const glyph_t *glyph, uint16_t component_count)
+{
+    uint16_t i;
+
+    for (i=0;i<component_count;i++) {
+        glyph_cache_get_entry(glyph->outline.list_component[i].glyph)->pin_count--;
+    }
+}
+
+/*!
+ * \brief glyph_cache_evict
+ *
+ * removes the least recently used entries until memory size is below
+ * max_memory_size, entries that are in use are kept
+ *
+ * \param cache
+ */
+static void glyph_cache_evict(glyph_cache_t *cache)
+{
+    glyph_cache_entry_t *entry = cache->last;
+    glyph_cache_entry_t *prev;
+
+    while (entry && cache->memory_size > cache->max_memory_size) {
+        prev = entry->prev;
+        if (!entry->pin_count) {
+            glyph_cache_unlink(cache, entry);
+            cache->list_entry[entry->glyph.glyph_index] = NULL;
+            cache->memory_size -= entry->memory_size;
+            cache->entry_count--;
+            cache->eviction_count++;
+            if (entry->glyph.outline.component_count) {
+                // components may be evicted now, start again from the least recently used
+                glyph_cache_unpin_components(&entry->glyph, entry->glyph.outline.component_count);
+                prev = cache->last;
+            }
+            free(entry);
+        }
+        entry = prev;
+    }
+}
+
+/*!
+ * \brief glyph_cache_pin_component
+ *
+ * gets the component of composite glyph from the cache, or
+ * adds it into the cache, hit and miss counts are not changed
+ *
+ * \param cache
+ * \param glyph parsed component glyph
+ * \return cached component, NULL if memory allocation failed
+ */
+static const glyph_t *glyph_cache_pin_component(glyph_cache_t *cache, const glyph_t *glyph)
+{
+    glyph_cache_entry_t *entry = NULL;
+
+    pthread_mutex_lock(&cache->lock);
+    if (cache->list_entry) {
+        entry = cache->list_entry[glyph->glyph_index];
+    }
+    if (entry) {
+        entry->pin_count++;
+        pthread_mutex_unlock(&cache->lock);
+        return &entry->glyph;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return glyph_cache_insert(cache, glyph);
+}
+
+/*!
+ * \brief glyph_cache_init
+ *
+ * \param cache
+ * \param glyphs_count glyphs count of the font
+ * \param max_memory_size max size of cached outlines in bytes, 0 disables the cache
+ */
+void glyph_cache_init(glyph_cache_t *cache, uint16_t glyphs_count, size_t max_memory_size)
+{
+    memset(cache, 0, sizeof(glyph_cache_t));
+    cache->glyphs_count = glyphs_count;
+    cache->max_memory_size = max_memory_size;
+    pthread_mutex_init(&cache->lock, NULL);
+}
+
+/*!
+ * \brief glyph_cache_clear
+ *
+ * frees the all cached outlines
+ *
+ * \param cache
+ */
+void glyph_cache_clear(glyph_cache_t *cache)
+{
+    glyph_cache_entry_t *entry = cache->first;
+    glyph_cache_entry_t *next;
+
+    while (entry) {
+        next = entry->next;
+        free(entry);
+        entry = next;
+    }
+    free(cache->list_entry);
+    pthread_mutex_destroy(&cache->lock);
+    memset(cache, 0, sizeof(glyph_cache_t));
+}
+
+/*!
+ * \brief glyph_cache_acquire
+ *
+ * get the cached outline of the glyph, outline is kept in the cache
+ * until glyph_cache_release() is called
+ *
+ * \param cache
+ * \param glyph_index
+ * \return cached outline, NULL if glyph is not in cache
+ */
+const glyph_t *glyph_cache_acquire(glyph_cache_t *cache, uint16_t glyph_index)
+{
+    glyph_cache_entry_t *entry = NULL;
+
+    pthread_mutex_lock(&cache->lock);
+    if (cache->list_entry && glyph_index < cache->glyphs_count) {
+        entry = cache->list_entry[glyph_index];
+    }
+    if (!entry) {
+        cache->miss_count++;
+        pthread_mutex_unlock(&cache->lock);
+        return NULL;
+    }
+    cache->hit_count++;
+    entry->pin_count++;
+    glyph_cache_unlink(cache, entry);
+    glyph_cache_link_first(cache, entry);
+    pthread_mutex_unlock(&cache->lock);
+    return &entry->glyph;
+}
+
+/*!
+ * \brief glyph_cache_insert
+ *
+ * copies the parsed outline into the cache, outline is kept
+ * in the cache until glyph_cache_release() is called
+ * Components of composite glyph are cached as their own entries
+ * and they are kept in the cache with the composite glyph
+ *
+ * \param cache
+ * \param glyph parsed glyph from glyf_parse()
+ * \return cached outline, NULL if cache is disabled or memory allocation failed
+ */
+const glyph_t *glyph_cache_insert(glyph_cache_t *cache, const glyph_t *glyph)
+{
+    uint16_t i;
+    size_t memory_size;
+    glyph_cache_entry_t *entry;
+    uint8_t *list_data;
+    const glyph_outline_t *outline = &glyph->outline;
+    glyph_outline_t *cached_outline;
+
+    if (!cache->max_memory_size || glyph->glyph_index >= cache->glyphs_count) {
+        return NULL;
+    }
+
+    // lists are after the entry, sorted by alignment
+    memory_size = sizeof(glyph_cache_entry_t) + sizeof(glyph_component_t)*outline->component_count
+            + sizeof(uint16_t)*outline->contour_count
+            + (sizeof(int16_t)*2 + sizeof(uint8_t))*outline->point_count;
+
+    entry = (glyph_cache_entry_t *)malloc(memory_size);
+    if (!entry) {
+        return NULL;
+    }
+    memset(entry, 0, sizeof(glyph_cache_entry_t));
+
+    entry->glyph.glyph_index = glyph->glyph_index;
+    entry->glyph.min_x = glyph->min_x;
+    entry->glyph.min_y = glyph->min_y;
+    entry->glyph.max_x = glyph->max_x;
+    entry->glyph.max_y = glyph->max_y;
+    entry->glyph.num_contours = glyph->num_contours;
+    entry->glyph.loaded = 1;
+
+    cached_outline = &entry->glyph.outline;
+    cached_outline->point_count = outline->point_count;
+    cached_outline->contour_count = outline->contour_count;
+    cached_outline->component_depth = outline->component_depth;
+
+    list_data = (uint8_t *)(entry + 1);
+    if (outline->component_count) {
+        // components are cached once and composite glyph refers to them
+        cached_outline->list_component = (glyph_component_t *)(void *)list_data;
+        for (i=0;i<outline->component_count;i++) {
+            cached_outline->list_component[i] = outline->list_component[i];
+            cached_outline->list_component[i].glyph = glyph_cache_pin_component(cache, outline->list_component[i].glyph);
+            if (!cached_outline->list_component[i].glyph) {
+                pthread_mutex_lock(&cache->lock);
+                glyph_cache_unpin_components(&entry->glyph, i);
+                glyph_cache_evict(cache);
+                pthread_mutex_unlock(&cache->lock);
+                free(entry);
+                return NULL;
+            }
+        }
+        cached_outline->component_count = outline->component_count;
+        list_data += sizeof(glyph_component_t)*outline->component_count;
+    }
+    if (outline->contour_count) {
+        cached_outline->list_end_points = (uint16_t *)(void *)list_data;
+        memcpy(list_data, outline->list_end_points, sizeof(uint16_t)*outline->contour_count);
+        list_data += sizeof(uint16_t)*outline->contour_count;
+    }
+    if (outline->point_count) {
+        cached_outline->list_point_x = (int16_t *)(void *)list_data;
+        memcpy(list_data, outline->list_point_x, sizeof(int16_t)*outline->point_count);
+        list_data += sizeof(int16_t)*outline->point_count;
+        cached_outline->list_point_y = (int16_t *)(void *)list_data;
+        memcpy(list_data, outline->list_point_y, sizeof(int16_t)*outline->point_count);
+        list_data += sizeof(int16_t)*outline->point_count;
+        cached_outline->list_flags = list_data;
+        memcpy(list_data, outline->list_flags, sizeof(uint8_t)*outline->point_count);
+    }
+    entry->memory_size = memory_size;
+    entry->pin_count = 1;
+
+    pthread_mutex_lock(&cache->lock);
+    if (!cache->list_entry) {
+        cache->list_entry = (glyph_cache_entry_t **)calloc(cache->glyphs_count, sizeof(glyph_cache_entry_t *));
+        if (!cache->list_entry) {
+            glyph_cache_unpin_components(&entry->glyph, entry->glyph.outline.component_count);
+            pthread_mutex_unlock(&cache->lock);
+            free(entry);
+            return NULL;
+        }
+    }
+    if (cache->list_entry[glyph->glyph_index]) {
+        // other thread has added the same glyph
+        glyph_cache_unpin_components(&entry->glyph, entry->glyph.outline.component_count);
+        free(entry);
+        entry = cache->list_entry[glyph->glyph_index];
+        entry->pin_count++;
+        glyph_cache_unlink(cache, entry);
+    } else {
+        cache->list_entry[glyph->glyph_index] = entry;
+        cache->memory_size += memory_size;
+        cache->entry_count++;
+    }
+    glyph_cache_link_first(cache, entry);
+    glyph_cache_evict(cache);
+    pthread_mutex_unlock(&cache->lock);
+    return &entry->glyph;
+}
+
+/*!
+ * \brief glyph_cache_release
+ *
+ * releases the outline from glyph_cache_acquire() or glyph_cache_insert()
+ *
+ * \param cache
+ * \param glyph
+ */
+void glyph_cache_release(glyph_cache_t *cache, const glyph_t *glyph)
+{
+    glyph_cache_entry_t *entry = glyph_cache_get_entry(glyph);
+
+    pthread_mutex_lock(&cache->lock);
+    entry->pin_count--;
+    glyph_cache_evict(cache);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/*!
+ * \brief glyph_cache_set_max_memory_size
+ *
+ * \param cache
+ * \param max_memory_size max size of cached outlines in bytes, 0 disables the cache
+ */
+void glyph_cache_set_max_memory_size(glyph_cache_t *cache, size_t max_memory_size)
+{
+    pthread_mutex_lock(&cache->lock);
+    cache->max_memory_size = max_memory_size;
+    glyph_cache_evict(cache);
+    pthread_mutex_unlock(&cache->lock);
+}
+
+/*!
+ * \brief glyph_cache_get_stats
+ *
+ * \param cache
+ * \param stats [out]
+ */
+void glyph_cache_get_stats(glyph_cache_t *cache, prj_ttf_reader_glyph_cache_stats_t *stats)
+{
+    pthread_mutex_lock(&cache->lock);
+    stats->hit_count = cache->hit_count;
+    stats->miss_count = cache->miss_count;
+    stats->eviction_count = cache->eviction_count;
+    stats->glyph_count = cache->entry_count;
+    stats->memory_size = cache->memory_size;
+    stats->max_memory_size = cache->max_memory_size;
+    pthread_mutex_unlock(&cache->lock);
+}
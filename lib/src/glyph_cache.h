@@ -0,0 +1,65 @@
+/*!
+ * \file
+ * \brief file glyph_cache.h
+ *
+ * Cache of the parsed glyph outlines, keeps the outlines
+ * of the font between the generate calls
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "prj-ttf-reader.h"
+#include "reader/glyf.h"
+
+/*!
+ * \brief The glyph_cache_entry_t struct
+ *
+ * cached outline of single glyph, the lists of the outline are
+ * allocated in the same memory block after the entry
+ */
+typedef struct glyph_cache_entry
+{
+    glyph_t glyph;              // only glyph_index, bounding box and outline are set
+    size_t memory_size;         // size of the memory block
+    uint32_t pin_count;         // entry is not evicted while it's used
+    struct glyph_cache_entry *prev;  // more recently used entry
+    struct glyph_cache_entry *next;  // less recently used entry
+} glyph_cache_entry_t;
+
+/*!
+ * \brief The glyph_cache_t struct
+ *
+ * LRU cache of the glyph outlines of single font
+ */
+typedef struct
+{
+    glyph_cache_entry_t **list_entry;   // indexed by glyph index, size is glyphs_count
+    uint16_t glyphs_count;
+    glyph_cache_entry_t *first;         // most recently used
+    glyph_cache_entry_t *last;          // least recently used
+    uint32_t entry_count;
+    size_t memory_size;
+    size_t max_memory_size;             // 0 disables the cache
+    uint64_t hit_count;
+    uint64_t miss_count;
+    uint64_t eviction_count;
+    pthread_mutex_t lock;
+} glyph_cache_t;
+
+void glyph_cache_init(glyph_cache_t *cache, uint16_t glyphs_count, size_t max_memory_size);
+void glyph_cache_clear(glyph_cache_t *cache);
+const glyph_t *glyph_cache_acquire(glyph_cache_t *cache, uint16_t glyph_index);
+const glyph_t *glyph_cache_insert(glyph_cache_t *cache, const glyph_t *glyph);
+void glyph_cache_release(glyph_cache_t *cache, const glyph_t *glyph);
+void glyph_cache_set_max_memory_size(glyph_cache_t *cache, size_t max_memory_size);
+void glyph_cache_get_stats(glyph_cache_t *cache, prj_ttf_reader_glyph_cache_stats_t *stats);
+
+#endif // GLYPH_CACHE_H
@@ -23,15 +23,22 @@
 #include "drawfont/rotate_math.h"
 #include "reader/parse_value.h"
 #include "reader/parse_text.h"
+#include "reader/kern.h"
 #include "font_tables.h"
+#include "font_handle.h"
+#include "font_registry.h"
+#include "font_chain.h"
 #include "supported_characters/read_supported_characters.h"
 
 static int prj_ttf_reader_parse_data(const uint32_t *list_characters, uint32_t list_characters_size,
-                                     const uint8_t *data, size_t data_size, float font_size_px, font_tables_t *tables,
+                                     prj_ttf_reader_font_t *font, float font_size_px,
                                      int quality, prj_ttf_reader_data_t *image_data,
-                                     float rotate, float move_glyph_x, float move_glyph_y);
-static uint8_t *prj_ttf_reader_read_file(const char* file_name, size_t *file_data_size);
-static void prj_ttf_reader_clear(font_tables_t *tables);
+                                     float rotate, float move_glyph_x, float move_glyph_y,
+                                     int is_single_thread);
+static int prj_ttf_reader_parse_data_chain(const uint32_t *list_characters, uint32_t list_characters_size,
+                                           prj_ttf_reader_font_chain_t *chain, float font_size_px,
+                                           int quality, prj_ttf_reader_data_t *image_data,
+                                           float rotate, float move_glyph_x, float move_glyph_y);
 static int prj_ttf_reader_generate_glyphs_from_list(const uint32_t *list_characters, uint32_t list_characters_size,
                                              const char *font_file_name, float font_size_px, int quality,
                                              prj_ttf_reader_data_t *data,
@@ -234,230 +241,206 @@ static int prj_ttf_reader_generate_glyphs_from_list(const uint32_t *list_charact
                                              prj_ttf_reader_data_t *data, float rotate,
                                              float move_glyph_x, float move_glyph_y)
 {
-    font_tables_t tables;
-    memset(&tables, 0, sizeof(tables));
-
-    uint8_t *file_data;
-    size_t file_data_size;
+    prj_ttf_reader_font_t *font;
     int ret;
 
-    file_data = prj_ttf_reader_read_file(font_file_name, &file_data_size);
-
-    if (!file_data) {
-        return 1;
+    // single call font is not shared, font is read into memory, so the
+    // font file can be rewritten between the calls
+    ret = font_handle_open(font_file_name, PRJ_TTF_READER_LOAD_MODE_READ, 0, &font);
+    if (ret) {
+        return ret;
     }
 
-    ret = prj_ttf_reader_parse_data(list_characters, list_characters_size, file_data, file_data_size, font_size_px, &tables, quality, data,
-        rotate, move_glyph_x, move_glyph_y);
-    free(file_data);
-    prj_ttf_reader_clear(&tables);
+    // file name calls don't use the drawing threads, callers of the old
+    // API may already generate from many threads
+    ret = prj_ttf_reader_parse_data(list_characters, list_characters_size, font, font_size_px, quality, data,
+        rotate, move_glyph_x, move_glyph_y, 1);
+    font_handle_close(&font);
     return ret;
 }
 
 /*!
- * \brief clear
- *
- * Clears the font_tables
- *
- * \param tables
- */
-static void prj_ttf_reader_clear(font_tables_t *tables)
-{
-    glyf_clear(&tables->list_glyph, &tables->max_profile);
-    name_clear(&tables->name_table);
-    loca_clear(&tables->list_index_loc_to_tables);
-    cmap_clear(&tables->character_to_glyph_index_table);
-    hmtx_clear(&tables->hor_metrics_table);
-    otff_clear(&tables->list_table_record);
-    free(tables->list_font_sizes);
-    tables->list_font_sizes_count = 0;
-}
-
-/*!
- * \brief prj_ttf_reader_read_file
+ * \brief prj_ttf_reader_parse_kerning
  *
- * Reads the file
+ * adds the kerning of the characters that were generated
+ * with the font into image_data
  *
- * \param file_name
- * \param file_data_size
- * \return
+ * \param font
+ * \param font_size_px
+ * \param image_data
+ * \param generate generate call of the font, list_glyph_character has the generated characters
+ * \return 0 on success
  */
-static uint8_t *prj_ttf_reader_read_file(const char* file_name, size_t *file_data_size)
+static int prj_ttf_reader_parse_kerning(prj_ttf_reader_font_t *font, float font_size_px,
+                                        prj_ttf_reader_data_t *image_data, const font_generate_t *generate)
 {
-    uint8_t *file_data;
-    size_t file_size, i;
-    FILE *fp = fopen(file_name, "r");
-    if (!fp) {
-        *file_data_size = 0;
-        return NULL;
-    }
+    table_view_t kern_view;
+    font_tables_t *tables = &font->tables;
 
-    fseek(fp, 0L, SEEK_END);
-    file_size = (size_t)(ftell(fp));
-    if (!file_size) {
-        *file_data_size = 0;
-        fclose(fp);
-        return NULL;
+    //Kearning table
+    if (otff_get_table(&tables->table_directory, OTFF_TABLE_KERN, &kern_view)) {
+        return 0;
     }
 
-
-    file_data = (uint8_t *)malloc(file_size);
-    fseek(fp, 0L, SEEK_SET);
-    i = fread(file_data, 1, file_size, fp);
-    if (i != file_size) {
-        free(file_data);
-        file_data = NULL;
-        *file_data_size = 0;
-    } else {
-        *file_data_size = file_size;
-    }
-    fclose(fp);
-    return file_data;
+    return kern_parse(font->file_data, kern_view.offset + kern_view.length, kern_view.offset,
+                      image_data, (float)font_size_px/tables->header_table.units_per_em,
+                      generate->list_glyph_character, generate->list_glyph_character_count);
 }
 
 /*!
  * \brief prj_ttf_reader_parse_data
  *
- * parse the ttf data
+ * generates the glyphs and kerning from the parsed font
  *
  * \param list_characters
  * \param list_characters_size
- * \param data
- * \param data_size
+ * \param font
  * \param font_size_px
- * \param tables
  * \param quality
- * \param data
+ * \param image_data
  * \param rotate
  * \param move_glyph_x
  * \param move_glyph_y
+ * \param is_single_thread 1 if the glyphs are drawn only in the calling thread,
+ * 0 to use thread count of the font
  * \return 0 on success
  */
 static int prj_ttf_reader_parse_data(const uint32_t *list_characters, uint32_t list_characters_size,
-                                     const uint8_t *data, size_t data_size, float font_size_px,
-                                     font_tables_t *tables, int quality, prj_ttf_reader_data_t *image_data,
+                                     prj_ttf_reader_font_t *font, float font_size_px,
+                                     int quality, prj_ttf_reader_data_t *image_data,
                                      float rotate,
-                                     float move_glyph_x, float move_glyph_y)
+                                     float move_glyph_x, float move_glyph_y,
+                                     int is_single_thread)
 {
     int ret;
-    uint16_t i;
-    uint16_t index_kern;
-    size_t offset = 0;
-
-    ret = otff_parse_offset_table(data, data_size, &offset, &tables->offsets);
-    if (ret) {
-        return ret;
-    }
-
-    ret = otff_parse_table_records(data, data_size, &offset, &tables->list_table_record, &tables->offsets);
-    if (ret) {
-        return ret;
-    }
+    font_tables_t *tables = &font->tables;
+    font_generate_t generate;
 
-    i = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "head");
-    if (UINT16_MAX == i) {
-        return EINVAL;
-    }
-
-    ret = head_parse_head_table(data, data_size, tables->list_table_record[i].offset, &tables->header_table);
-    if (ret) {
-        return ret;
-    }
-
-    i = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "maxp");
-    if (UINT16_MAX == i) {
-        return EINVAL;
+    font_handle_init_generate(font, &generate);
+    if (is_single_thread) {
+        generate.thread_count = 1;
     }
 
-    ret = maxp_parse_maximum_profile(data, data_size, tables->list_table_record[i].offset, &tables->max_profile);
+    ret = font_handle_load_tables(font, FONT_HANDLE_TABLE_CMAP | FONT_HANDLE_TABLE_LOCA | FONT_HANDLE_TABLE_HMTX);
     if (ret) {
         return ret;
     }
 
-    i = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "name");
-    if (UINT16_MAX == i) {
-        return EINVAL;
-    }
-
-    ret = name_parse_naming_table(data, data_size, tables->list_table_record[i].offset, &tables->name_table);
-    if (ret) {
-        return ret;
-    }
-
-    i = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "loca");
-    if (UINT16_MAX == i) {
-        return EINVAL;
-    }
-
-    if (tables->max_profile.glyphs_count == 0) {
-        return EINVAL;
+    ret = glyph_graph_generator_generate_graph(list_characters, list_characters_size,
+                                               font->file_data, font->file_data_size, font_size_px,
+                                               tables, &generate, quality, image_data,
+                                               &tables->hor_metrics_table, &tables->hor_header_table,
+                                               rotate, move_glyph_x, move_glyph_y);
+    if (!ret) {
+        ret = prj_ttf_reader_parse_kerning(font, font_size_px, image_data, &generate);
     }
-
-    ret = loca_parse(data, data_size, tables->list_table_record[i].offset, &tables->list_index_loc_to_tables,
-                     (uint16_t)(tables->max_profile.glyphs_count+1), tables->header_table.format);
+    font_handle_clear_generate(&generate);
     if (ret) {
         return ret;
     }
 
+#ifdef TIME_DEBUG
+    print_glyph_filler_times();
+#endif
+    return 0;
+}
 
-    i = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "cmap");
-    if (UINT16_MAX == i) {
-        return EINVAL;
-    }
-
-    ret = cmap_parse_character_to_glyph_index_mapping_table(data, data_size, tables->list_table_record[i].offset,
-                                                            &tables->character_to_glyph_index_table, &tables->corr_character_table);
-    if (ret) {
-        return ret;
-    }
-
-    i = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "hhea");
-    if (UINT16_MAX == i) {
-        return EINVAL;
+/*!
+ * \brief prj_ttf_reader_parse_data_chain
+ *
+ * generates the glyphs and kerning with the fonts of the chain, each
+ * character is generated with the first font that has the character
+ *
+ * \param list_characters
+ * \param list_characters_size
+ * \param chain
+ * \param font_size_px
+ * \param quality
+ * \param image_data
+ * \param rotate
+ * \param move_glyph_x
+ * \param move_glyph_y
+ * \return 0 on success
+ */
+static int prj_ttf_reader_parse_data_chain(const uint32_t *list_characters, uint32_t list_characters_size,
+                                           prj_ttf_reader_font_chain_t *chain, float font_size_px,
+                                           int quality, prj_ttf_reader_data_t *image_data,
+                                           float rotate, float move_glyph_x, float move_glyph_y)
+{
+    int ret;
+    uint32_t i;
+    uint32_t offset = 0;
+    uint32_t list_font_count = 0;
+    uint32_t *list_font_characters;
+    uint32_t *list_font_characters_size;
+    font_generate_t *list_generate;
+    glyph_graph_generator_font_t *list_font;
+    prj_ttf_reader_font_t *font;
+
+    list_font_characters_size = (uint32_t *)malloc(sizeof(uint32_t)*chain->list_font_count);
+    list_generate = (font_generate_t *)calloc(chain->list_font_count, sizeof(font_generate_t));
+    list_font = (glyph_graph_generator_font_t *)calloc(chain->list_font_count, sizeof(glyph_graph_generator_font_t));
+    if (!list_font_characters_size || !list_generate || !list_font) {
+        free(list_font_characters_size);
+        free(list_generate);
+        free(list_font);
+        return ENOMEM;
     }
 
-    ret = hhea_parse(data, data_size, tables->list_table_record[i].offset, &tables->hor_header_table);
+    ret = font_chain_split_characters(chain, list_characters, list_characters_size,
+                                      &list_font_characters, list_font_characters_size);
     if (ret) {
+        free(list_font_characters_size);
+        free(list_generate);
+        free(list_font);
         return ret;
     }
 
-    i = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "hmtx");
-    if (UINT16_MAX == i) {
-        return EINVAL;
+    // only fonts that have the requested characters are used
+    for (i=0;i<chain->list_font_count && !ret;i++) {
+        font = chain->list_font[i];
+        if (list_font_characters_size[i]) {
+            ret = font_handle_load_tables(font, FONT_HANDLE_TABLE_CMAP | FONT_HANDLE_TABLE_LOCA | FONT_HANDLE_TABLE_HMTX);
+            list_font[list_font_count].data = font->file_data;
+            list_font[list_font_count].data_size = font->file_data_size;
+            list_font[list_font_count].tables = &font->tables;
+            font_handle_init_generate(font, &list_generate[i]);
+            // glyphs of all fonts are drawn by the workers of the chain
+            list_generate[i].workers = &chain->workers;
+            list_font[list_font_count].generate = &list_generate[i];
+            list_font[list_font_count].hor_metrics_table = &font->tables.hor_metrics_table;
+            list_font[list_font_count].hor_header_table = &font->tables.hor_header_table;
+            list_font[list_font_count].list_characters = &list_font_characters[offset];
+            list_font[list_font_count].list_characters_size = list_font_characters_size[i];
+            list_font[list_font_count].font_index = i;
+            list_font_count++;
+        }
+        offset += list_font_characters_size[i];
     }
 
-
-    ret = hmtx_parse(data, data_size,
-                     &tables->hor_metrics_table, tables->list_table_record[i].offset,
-                     &tables->hor_header_table, &tables->max_profile);
-    if (ret) {
-        return ret;
+    if (!ret) {
+        ret = glyph_graph_generator_generate_graph_fonts(list_font, list_font_count, font_size_px, quality,
+                                                         image_data, rotate, move_glyph_x, move_glyph_y);
     }
 
-
-    ret = glyph_graph_generator_generate_graph(list_characters, list_characters_size,
-                                               data, data_size, font_size_px, tables, quality, image_data,
-                                               &tables->hor_metrics_table, &tables->hor_header_table,
-                                               rotate, move_glyph_x, move_glyph_y);
-    if (ret) {
-        return ret;
+    // the font has only the characters that the chain generates with it
+    for (i=0;i<list_font_count && !ret;i++) {
+        ret = prj_ttf_reader_parse_kerning(chain->list_font[list_font[i].font_index], font_size_px, image_data,
+                                           list_font[i].generate);
     }
 
-    index_kern = otff_get_table_record_index(tables->list_table_record, tables->offsets.num_tables, "kern");
-    //Kearning table
-    if (UINT16_MAX != index_kern) {
-        ret = kern_parse(data, data_size, tables->list_table_record[index_kern].offset,
-                         image_data, (float)font_size_px/tables->header_table.units_per_em,
-                         &tables->corr_character_table);
-        if (ret) {
-            return ret;
-        }
+    for (i=0;i<chain->list_font_count;i++) {
+        font_handle_clear_generate(&list_generate[i]);
     }
 
+    free(list_font_characters);
+    free(list_font_characters_size);
+    free(list_generate);
+    free(list_font);
 #ifdef TIME_DEBUG
     print_glyph_filler_times();
 #endif
-    return 0;
+    return ret;
 }
 
 /*!
@@ -588,26 +571,649 @@ void prj_ttf_reader_clear_supported_character(prj_ttf_reader_supported_character
  */
 int prj_ttf_reader_get_supported_characters(const char *font_file_name, prj_ttf_reader_supported_characters_t *supported_characters)
 {
-    font_tables_t tables;
-    memset(&tables, 0, sizeof(tables));
+    prj_ttf_reader_font_t *font;
+    int ret;
+
+    ret = font_handle_open(font_file_name, PRJ_TTF_READER_LOAD_MODE_READ, 0, &font);
+    if (ret) {
+        return ret;
+    }
+
+    ret = prj_ttf_reader_get_supported_characters_font(font, supported_characters);
+    font_handle_close(&font);
+    return ret;
+}
+
+/*!
+ * \brief prj_ttf_reader_open_font
+ *
+ * Opens the font file and parses the tables, the opened font
+ * can be used for many generate calls
+ *
+ * \param font_file_name [in] full filepath of ttf file
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font(const char *font_file_name, prj_ttf_reader_font_t **font)
+{
+    return prj_ttf_reader_open_font_mode(font_file_name, PRJ_TTF_READER_LOAD_MODE_MMAP, font);
+}
+
+/*!
+ * \brief prj_ttf_reader_open_font_mode
+ *
+ * Opens the font file with load mode and parses the tables
+ *
+ * \param font_file_name [in] full filepath of ttf file
+ * \param load_mode [in] PRJ_TTF_READER_LOAD_MODE_READ or PRJ_TTF_READER_LOAD_MODE_MMAP
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_mode(const char *font_file_name, int load_mode, prj_ttf_reader_font_t **font)
+{
+    if (!font_file_name || !font) {
+        return EINVAL;
+    }
+    if (load_mode != PRJ_TTF_READER_LOAD_MODE_READ && load_mode != PRJ_TTF_READER_LOAD_MODE_MMAP) {
+        *font = NULL;
+        return EINVAL;
+    }
+    return font_handle_open(font_file_name, load_mode, 0, font);
+}
+
+/*!
+ * \brief prj_ttf_reader_open_font_shared
+ *
+ * Gets the shared font from the process-wide font registry
+ *
+ * \param font_file_name [in] full filepath of ttf file
+ * \param font [out] shared font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_shared(const char *font_file_name, prj_ttf_reader_font_t **font)
+{
+    if (!font_file_name || !font) {
+        return EINVAL;
+    }
+    return font_registry_acquire(font_file_name, 0, PRJ_TTF_READER_LOAD_MODE_MMAP, font);
+}
+
+/*!
+ * \brief prj_ttf_reader_open_font_face
+ *
+ * Opens the face of the font collection (ttc) and parses the tables
+ *
+ * \param font_file_name [in] full filepath of ttf or ttc file
+ * \param face_index [in] index of the face in font collection, 0 if font is not a collection
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_face(const char *font_file_name, uint32_t face_index, prj_ttf_reader_font_t **font)
+{
+    if (!font_file_name || !font) {
+        return EINVAL;
+    }
+    return font_handle_open(font_file_name, PRJ_TTF_READER_LOAD_MODE_MMAP, face_index, font);
+}
+
+/*!
+ * \brief prj_ttf_reader_open_font_shared_face
+ *
+ * Gets the shared face of the font collection (ttc) from the
+ * process-wide font registry
+ *
+ * \param font_file_name [in] full filepath of ttf or ttc file
+ * \param face_index [in] index of the face in font collection, 0 if font is not a collection
+ * \param font [out] shared font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_shared_face(const char *font_file_name, uint32_t face_index, prj_ttf_reader_font_t **font)
+{
+    if (!font_file_name || !font) {
+        return EINVAL;
+    }
+    return font_registry_acquire(font_file_name, face_index, PRJ_TTF_READER_LOAD_MODE_MMAP, font);
+}
+
+/*!
+ * \brief prj_ttf_reader_open_other_face
+ *
+ * Opens other face of the same font collection
+ *
+ * \param font [in] opened font
+ * \param face_index [in] index of the face in font collection
+ * \param face [out] opened face, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_other_face(const prj_ttf_reader_font_t *font, uint32_t face_index, prj_ttf_reader_font_t **face)
+{
+    if (!font || !face) {
+        return EINVAL;
+    }
+    return font_handle_open_face(font->file, face_index, face);
+}
+
+/*!
+ * \brief prj_ttf_reader_get_face_count
+ *
+ * \param font [in] opened font
+ * \return number of faces in the font file, 1 if font is not a collection
+ */
+uint32_t prj_ttf_reader_get_face_count(const prj_ttf_reader_font_t *font)
+{
+    if (!font) {
+        return 0;
+    }
+    return font->file->face_count;
+}
+
+/*!
+ * \brief prj_ttf_reader_open_font_memory
+ *
+ * Opens the font from the memory and parses the tables
+ *
+ * \param font_data [in] font data, the content of ttf file
+ * \param font_data_size [in] size of font data in bytes
+ * \param memory_mode [in] PRJ_TTF_READER_MEMORY_MODE_COPY or PRJ_TTF_READER_MEMORY_MODE_BORROW
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_memory(const uint8_t *font_data, size_t font_data_size, int memory_mode, prj_ttf_reader_font_t **font)
+{
+    if (!font_data || !font_data_size || !font) {
+        return EINVAL;
+    }
+    if (memory_mode != PRJ_TTF_READER_MEMORY_MODE_COPY && memory_mode != PRJ_TTF_READER_MEMORY_MODE_BORROW) {
+        *font = NULL;
+        return EINVAL;
+    }
+    return font_handle_open_memory(font_data, font_data_size, memory_mode, font);
+}
+
+/*!
+ * \brief prj_ttf_reader_close_font
+ *
+ * Closes the font
+ * Call this function after prj_ttf_reader_font_t is no longer required to use
+ *
+ * \param font [in/out] sets font to NULL
+ */
+void prj_ttf_reader_close_font(prj_ttf_reader_font_t **font)
+{
+    if (!font || !*font) {
+        return;
+    }
+    if ((*font)->is_shared) {
+        font_registry_release(font);
+    } else {
+        font_handle_close(font);
+    }
+}
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8, but uses opened font
+ *
+ * \param utf8_text [in]
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_font(const char *utf8_text, prj_ttf_reader_font_t *font, float font_size_px, int quality, prj_ttf_reader_data_t *data)
+{
+    return prj_ttf_reader_generate_glyphs_utf8_rotate_font(utf8_text, font, font_size_px, quality, data, 0, 0, 0);
+}
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_rotate_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8_rotate, but uses opened font
+ *
+ * \param utf8_text [in]
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_rotate_font(const char *utf8_text, prj_ttf_reader_font_t *font, float font_size_px, int quality,
+    prj_ttf_reader_data_t *data, float rotate, float move_glyph_x, float move_glyph_y)
+{
+    if (!font
+        || move_glyph_x < 0 || (float)move_glyph_x >= (float)quality
+        || move_glyph_y < 0 || (float)move_glyph_y >= (float)quality
+        || rotate < 0 || rotate >= (float)(M_PI*2)) {
+        return EINVAL;
+    }
 
-    uint8_t *file_data;
-    size_t file_data_size;
     int ret;
+    uint32_t list_characters_size;
+    uint32_t *list_characters = parse_text_generate_list_characters(utf8_text, &list_characters_size, 0);
+    if (!list_characters || !list_characters_size) {
+        return EINVAL;
+    }
+
+    ret = prj_ttf_reader_parse_data(list_characters, list_characters_size,
+                                    font, font_size_px, quality,
+                                    data, rotate, move_glyph_x, move_glyph_y, 0);
+
+    free(list_characters);
+    return ret;
+}
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters, but uses opened font
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_font(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_t *font, float font_size_px, int quality, prj_ttf_reader_data_t *data)
+{
+    return prj_ttf_reader_generate_glyphs_list_characters_rotate_font(list_characters, list_characters_size, font, font_size_px, quality, data, 0, 0, 0);
+}
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_rotate_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters_rotate, but uses opened font
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_rotate_font(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_t *font, float font_size_px, int quality, prj_ttf_reader_data_t *data, float rotate, float move_glyph_x, float move_glyph_y)
+{
+    if (!font || !list_characters || !list_characters_size) {
+        return EINVAL;
+    }
+
+    return prj_ttf_reader_parse_data(list_characters, list_characters_size,
+                                     font, font_size_px, quality,
+                                     data, rotate, move_glyph_x, move_glyph_y, 0);
+}
+
+/*!
+ * \brief prj_ttf_reader_create_font_chain
+ *
+ * creates font fallback chain, fonts must be kept open
+ * until the chain is cleared
+ *
+ * \param list_font [in] fonts from prj_ttf_reader_open_font() in fallback order
+ * \param list_font_count [in] size of list_font
+ * \param chain [out] created chain, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_create_font_chain(prj_ttf_reader_font_t *const *list_font, uint32_t list_font_count, prj_ttf_reader_font_chain_t **chain)
+{
+    uint32_t i;
+
+    if (!chain) {
+        return EINVAL;
+    }
+    *chain = NULL;
+    if (!list_font || !list_font_count) {
+        return EINVAL;
+    }
+    for (i=0;i<list_font_count;i++) {
+        if (!list_font[i]) {
+            return EINVAL;
+        }
+    }
+
+    return font_chain_create(list_font, list_font_count, chain);
+}
+
+/*!
+ * \brief prj_ttf_reader_clear_font_chain
+ *
+ * clears the chain, fonts of the chain are not closed
+ *
+ * \param chain [in/out] sets chain to NULL
+ */
+void prj_ttf_reader_clear_font_chain(prj_ttf_reader_font_chain_t **chain)
+{
+    if (!chain) {
+        return;
+    }
+    font_chain_clear(chain);
+}
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8, but uses font chain,
+ * prj_ttf_reader_glyph_data_t font_index tells the font of the glyph
+ *
+ * \param utf8_text [in]
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_font_chain(const char *utf8_text, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality, prj_ttf_reader_data_t *data)
+{
+    return prj_ttf_reader_generate_glyphs_utf8_rotate_font_chain(utf8_text, chain, font_size_px, quality, data, 0, 0, 0);
+}
 
-    file_data = prj_ttf_reader_read_file(font_file_name, &file_data_size);
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_rotate_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8_rotate, but uses font chain
+ *
+ * \param utf8_text [in]
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_rotate_font_chain(const char *utf8_text, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality,
+    prj_ttf_reader_data_t *data, float rotate, float move_glyph_x, float move_glyph_y)
+{
+    if (!chain
+        || move_glyph_x < 0 || (float)move_glyph_x >= (float)quality
+        || move_glyph_y < 0 || (float)move_glyph_y >= (float)quality
+        || rotate < 0 || rotate >= (float)(M_PI*2)) {
+        return EINVAL;
+    }
 
-    if (!file_data) {
-        return 1;
+    int ret;
+    uint32_t list_characters_size;
+    uint32_t *list_characters = parse_text_generate_list_characters(utf8_text, &list_characters_size, 0);
+    if (!list_characters || !list_characters_size) {
+        return EINVAL;
     }
 
-    ret = prj_ttf_reader_parse_supported_characters(file_data, file_data_size, &tables, supported_characters);
+    ret = prj_ttf_reader_parse_data_chain(list_characters, list_characters_size,
+                                          chain, font_size_px, quality,
+                                          data, rotate, move_glyph_x, move_glyph_y);
 
-    free(file_data);
-    prj_ttf_reader_clear(&tables);
+    free(list_characters);
     return ret;
 }
 
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters, but uses font chain
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_font_chain(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality, prj_ttf_reader_data_t *data)
+{
+    return prj_ttf_reader_generate_glyphs_list_characters_rotate_font_chain(list_characters, list_characters_size, chain, font_size_px, quality, data, 0, 0, 0);
+}
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_rotate_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters_rotate, but uses font chain
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_rotate_font_chain(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality, prj_ttf_reader_data_t *data, float rotate, float move_glyph_x, float move_glyph_y)
+{
+    if (!chain || !list_characters || !list_characters_size) {
+        return EINVAL;
+    }
+
+    return prj_ttf_reader_parse_data_chain(list_characters, list_characters_size,
+                                           chain, font_size_px, quality,
+                                           data, rotate, move_glyph_x, move_glyph_y);
+}
+
+/*!
+ * \brief prj_ttf_reader_get_kerning_font
+ *
+ * Get kerning between characters directly from opened font,
+ * glyphs don't need to be generated
+ *
+ * \param left_character left character index, for example 'a' == 97
+ * \param right_character right character index, for example 'b' == 98
+ * \param font_size_px [in] font size's in px
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \return kerning
+ */
+float prj_ttf_reader_get_kerning_font(uint32_t left_character, uint32_t right_character, float font_size_px, prj_ttf_reader_font_t *font)
+{
+    table_view_t kern_view;
+    uint16_t left_glyph, right_glyph;
+    int16_t kerning;
+
+    if (!font || !left_character || !right_character) {
+        return 0;
+    }
+
+    if (otff_get_table(&font->tables.table_directory, OTFF_TABLE_KERN, &kern_view)) {
+        return 0;
+    }
+
+    if (font_handle_load_tables(font, FONT_HANDLE_TABLE_CMAP)) {
+        return 0;
+    }
+
+    if (cmap_get_glyph_index(&font->tables.character_to_glyph_index_table, left_character, &left_glyph)
+            || cmap_get_glyph_index(&font->tables.character_to_glyph_index_table, right_character, &right_glyph)) {
+        return 0;
+    }
+
+    if (kern_get_kerning(font->file_data, kern_view.offset + kern_view.length, kern_view.offset,
+                         left_glyph, right_glyph, &kerning)) {
+        return 0;
+    }
+
+    return (float)font_size_px/font->tables.header_table.units_per_em*(float)kerning;
+}
+
+/*!
+ * \brief prj_ttf_reader_get_supported_characters_font
+ *
+ * get supported characters from opened font
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param supported_characters [out] supported characters will be filled here
+ * \return 0 on success
+ */
+int prj_ttf_reader_get_supported_characters_font(prj_ttf_reader_font_t *font, prj_ttf_reader_supported_characters_t *supported_characters)
+{
+    int ret;
+
+    if (!font || !supported_characters) {
+        return EINVAL;
+    }
+
+    ret = font_handle_load_tables(font, FONT_HANDLE_TABLE_CMAP);
+    if (ret) {
+        return ret;
+    }
+
+    return prj_ttf_reader_parse_supported_characters(&font->tables, supported_characters);
+}
+
+/*!
+ * \brief prj_ttf_reader_get_coverage_font
+ *
+ * get coverage of the opened font, coverage is built on the first call
+ * and it's valid until the font is closed
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param coverage [out] coverage of the font
+ * \return 0 on success
+ */
+int prj_ttf_reader_get_coverage_font(prj_ttf_reader_font_t *font, const prj_ttf_reader_coverage_t **coverage)
+{
+    int ret;
+
+    if (!font || !coverage) {
+        return EINVAL;
+    }
+
+    ret = font_handle_load_tables(font, FONT_HANDLE_TABLE_COVERAGE);
+    if (ret) {
+        return ret;
+    }
+
+    *coverage = &font->coverage;
+    return 0;
+}
+
+/*!
+ * \brief prj_ttf_reader_set_glyph_cache_size_font
+ *
+ * sets max memory size of the glyph outline cache of the font,
+ * least recently used glyphs are removed immediately if cache is larger
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param max_memory_size max size in bytes, 0 disables the cache
+ * \return 0 on success
+ */
+int prj_ttf_reader_set_glyph_cache_size_font(prj_ttf_reader_font_t *font, size_t max_memory_size)
+{
+    if (!font) {
+        return EINVAL;
+    }
+
+    glyph_cache_set_max_memory_size(&font->glyph_cache, max_memory_size);
+    return 0;
+}
+
+/*!
+ * \brief prj_ttf_reader_get_glyph_cache_stats_font
+ *
+ * get counters of the glyph outline cache of the font
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param stats [out] counters of the cache
+ * \return 0 on success
+ */
+int prj_ttf_reader_get_glyph_cache_stats_font(prj_ttf_reader_font_t *font, prj_ttf_reader_glyph_cache_stats_t *stats)
+{
+    if (!font || !stats) {
+        return EINVAL;
+    }
+
+    glyph_cache_get_stats(&font->glyph_cache, stats);
+    return 0;
+}
+
+/*!
+ * \brief prj_ttf_reader_set_fill_mode_font
+ *
+ * sets how the glyphs of the font are filled, also
+ * when the font is used in the font chain
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param fill_mode PRJ_TTF_READER_FILL_MODE_FLOOD, PRJ_TTF_READER_FILL_MODE_SCANLINE,
+ * PRJ_TTF_READER_FILL_MODE_ANALYTIC or PRJ_TTF_READER_FILL_MODE_TILED
+ * \return 0 on success, EPERM if the font is shared
+ */
+int prj_ttf_reader_set_fill_mode_font(prj_ttf_reader_font_t *font, int fill_mode)
+{
+    if (!font || fill_mode < PRJ_TTF_READER_FILL_MODE_FLOOD || fill_mode > PRJ_TTF_READER_FILL_MODE_TILED) {
+        return EINVAL;
+    }
+
+    // option of the shared font would change the glyphs of every user of the font
+    if (font->is_shared) {
+        return EPERM;
+    }
+
+    pthread_mutex_lock(&font->lock);
+    font->fill_mode = fill_mode;
+    pthread_mutex_unlock(&font->lock);
+    return 0;
+}
+
+/*!
+ * \brief prj_ttf_reader_set_max_glyph_memory_size_font
+ *
+ * sets max memory size of the canvas (drawing) of single glyph,
+ * generating fails with ENOMEM if a glyph of the font needs more
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param max_memory_size max size in bytes, 0 is no limit (default)
+ * \return 0 on success, EPERM if the font is shared
+ */
+int prj_ttf_reader_set_max_glyph_memory_size_font(prj_ttf_reader_font_t *font, size_t max_memory_size)
+{
+    if (!font) {
+        return EINVAL;
+    }
+
+    if (font->is_shared) {
+        return EPERM;
+    }
+
+    pthread_mutex_lock(&font->lock);
+    font->max_glyph_memory_size = max_memory_size;
+    pthread_mutex_unlock(&font->lock);
+    return 0;
+}
+
+/*!
+ * \brief prj_ttf_reader_set_thread_count_font
+ *
+ * sets count of the threads that draw the glyphs of single generate call
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param thread_count count of the threads, 0 is the count of the processors (default)
+ * \return 0 on success, EPERM if the font is shared
+ */
+int prj_ttf_reader_set_thread_count_font(prj_ttf_reader_font_t *font, uint32_t thread_count)
+{
+    if (!font) {
+        return EINVAL;
+    }
+
+    if (font->is_shared) {
+        return EPERM;
+    }
+
+    pthread_mutex_lock(&font->lock);
+    font->thread_count = thread_count;
+    pthread_mutex_unlock(&font->lock);
+    return 0;
+}
+
 /**
  * \brief prj_ttf_reader_rotate_by_angle
  *
@@ -13,6 +13,7 @@
 #define PRJTTFREADER_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 /*!
  * \brief prj_ttf_reader_image
@@ -62,6 +63,9 @@ typedef struct prj_ttf_reader_glyph_data {
                                         // NOTE: This offset doesn't count possible rotate
     float image_pixel_bearing;          // how many pixel (x) moves to right or left side before the drawing
                                         // NOTE: This offset doesn't count possible rotate
+
+    uint32_t font_index;                // index of the font in the font chain that has generated the glyph,
+                                        // always 0 if the glyphs are generated with single font
 } prj_ttf_reader_glyph_data_t;
 
 /*!
@@ -121,6 +125,125 @@ typedef struct prj_ttf_reader_supported_characters {
     uint32_t *list_character;
 } prj_ttf_reader_supported_characters_t;
 
+/*!
+ * \brief prj_ttf_reader_coverage_range
+ *
+ * range of supported characters, both characters are included
+ */
+typedef struct prj_ttf_reader_coverage_range {
+    uint32_t first_character;
+    uint32_t last_character;
+} prj_ttf_reader_coverage_range_t;
+
+/*!
+ * \brief prj_ttf_reader_coverage
+ *
+ * characters that font can render, built once per opened font
+ * Use functions:
+ * prj_ttf_reader_get_coverage_font() to get the coverage of the font
+ * prj_ttf_reader_coverage_has_character() to check single character
+ * prj_ttf_reader_coverage_get_mask() to check list of characters
+ */
+typedef struct prj_ttf_reader_coverage {
+    prj_ttf_reader_coverage_range_t *list_range; // sorted by character
+    uint32_t list_range_count;
+    uint32_t character_count;   // count of characters in all ranges
+    uint64_t **list_block;      // internal bitset, bits of 4096 characters per block, NULL if block has no characters
+} prj_ttf_reader_coverage_t;
+
+/*!
+ * \brief prj_ttf_reader_font
+ *
+ * opened font, the font file is read and the tables are parsed only once
+ * and the same font can be used for many generate calls
+ * Use functions:
+ * - prj_ttf_reader_open_font() to open the font
+ * - prj_ttf_reader_generate_glyphs_utf8_font() (and other *_font functions) to generate data
+ * - prj_ttf_reader_close_font() to close the font after using
+ */
+typedef struct prj_ttf_reader_font prj_ttf_reader_font_t;
+
+/*!
+ * \brief prj_ttf_reader_glyph_cache_stats
+ *
+ * counters of the glyph outline cache of the font,
+ * use prj_ttf_reader_get_glyph_cache_stats_font() to get
+ */
+typedef struct prj_ttf_reader_glyph_cache_stats {
+    uint64_t hit_count;         // glyphs that were found from the cache
+    uint64_t miss_count;        // glyphs that were parsed from glyf table
+    uint64_t eviction_count;    // glyphs that were removed from the cache to keep memory size below the max
+    uint32_t glyph_count;       // glyphs in the cache
+    size_t memory_size;         // memory used by the cached glyphs (bytes)
+    size_t max_memory_size;     // max memory size of the cache (bytes)
+} prj_ttf_reader_glyph_cache_stats_t;
+
+/*!
+ * \brief prj_ttf_reader_font_chain
+ *
+ * ordered list of opened fonts, each character is generated with the
+ * first font that has the character and all glyphs are in the same image
+ * Use functions:
+ * - prj_ttf_reader_create_font_chain() to create the chain
+ * - prj_ttf_reader_generate_glyphs_utf8_font_chain() (and other *_font_chain functions) to generate data
+ * - prj_ttf_reader_clear_font_chain() to clear the chain after using
+ */
+typedef struct prj_ttf_reader_font_chain prj_ttf_reader_font_chain_t;
+
+/*!
+ * \brief load modes of prj_ttf_reader_open_font_mode()
+ *
+ * PRJ_TTF_READER_LOAD_MODE_READ reads the font file into the allocated memory
+ * PRJ_TTF_READER_LOAD_MODE_MMAP maps the font file read-only and shared,
+ * processes that use the same font file share the same page cache copy
+ * of the font file. If the mapping fails, the font file is read instead
+ * The mapped font file must not be truncated or rewritten in place while
+ * the font is opened: reading the truncated part raises SIGBUS and the
+ * rewritten data is not validated again. Replace the font file atomically
+ * (write a new file and rename it over the old one) or use
+ * PRJ_TTF_READER_LOAD_MODE_READ
+ */
+#define PRJ_TTF_READER_LOAD_MODE_READ   0
+#define PRJ_TTF_READER_LOAD_MODE_MMAP   1
+
+/*!
+ * \brief memory modes of prj_ttf_reader_open_font_memory()
+ *
+ * PRJ_TTF_READER_MEMORY_MODE_COPY copies the font data, the font data
+ * can be released after prj_ttf_reader_open_font_memory() returns
+ * PRJ_TTF_READER_MEMORY_MODE_BORROW uses the font data without copying,
+ * the font data must be kept unchanged until prj_ttf_reader_close_font()
+ */
+#define PRJ_TTF_READER_MEMORY_MODE_COPY     0
+#define PRJ_TTF_READER_MEMORY_MODE_BORROW   1
+
+/*!
+ * \brief default max memory size of the glyph outline cache of the font
+ *
+ * parsed glyph outlines are kept in the font between the generate calls,
+ * least recently used glyphs are removed when the max memory size is exceeded
+ */
+#define PRJ_TTF_READER_GLYPH_CACHE_DEFAULT_SIZE     (4*1024*1024)
+
+/*!
+ * \brief fill modes of prj_ttf_reader_set_fill_mode_font()
+ *
+ * PRJ_TTF_READER_FILL_MODE_FLOOD fills the drawn outline by enlarging the inner
+ * and outer areas until nothing changes, this is the default
+ * PRJ_TTF_READER_FILL_MODE_SCANLINE fills the outline row by row in a single pass
+ * with the non-zero winding rule
+ * PRJ_TTF_READER_FILL_MODE_ANALYTIC calculates the exact covered area of each pixel
+ * from the outline instead of counting quality*quality drawn pixels, quality
+ * is then only the unit of move_glyph_x and move_glyph_y
+ * PRJ_TTF_READER_FILL_MODE_TILED fills same as PRJ_TTF_READER_FILL_MODE_SCANLINE, but
+ * only the 64x64 pixel tiles that the outline touches are allocated and the tiles inside
+ * of the outline are only marked full, use this for large font sizes
+ */
+#define PRJ_TTF_READER_FILL_MODE_FLOOD      0
+#define PRJ_TTF_READER_FILL_MODE_SCANLINE   1
+#define PRJ_TTF_READER_FILL_MODE_ANALYTIC   2
+#define PRJ_TTF_READER_FILL_MODE_TILED      3
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -300,6 +423,423 @@ void prj_ttf_reader_clear_supported_character(prj_ttf_reader_supported_character
  */
 int prj_ttf_reader_get_supported_characters(const char *font_file_name, prj_ttf_reader_supported_characters_t *supported_characters);
 
+/*!
+ * \brief prj_ttf_reader_open_font
+ *
+ * Opens the font file and parses the tables, the opened font
+ * can be used for many generate calls
+ * The font file is mapped with PRJ_TTF_READER_LOAD_MODE_MMAP, so it must not
+ * be truncated or rewritten in place while the font is opened (truncating
+ * raises SIGBUS), use prj_ttf_reader_open_font_mode() with
+ * PRJ_TTF_READER_LOAD_MODE_READ for the font files that can change
+ *
+ * \param font_file_name [in] full filepath of ttf file
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font(const char *font_file_name, prj_ttf_reader_font_t **font);
+
+/*!
+ * \brief prj_ttf_reader_open_font_mode
+ *
+ * Same as prj_ttf_reader_open_font(), but the load mode of the font
+ * file can be selected
+ * The font file must not be modified while the font is opened
+ * with PRJ_TTF_READER_LOAD_MODE_MMAP, see PRJ_TTF_READER_LOAD_MODE_MMAP
+ *
+ * \param font_file_name [in] full filepath of ttf file
+ * \param load_mode [in] PRJ_TTF_READER_LOAD_MODE_READ or PRJ_TTF_READER_LOAD_MODE_MMAP
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_mode(const char *font_file_name, int load_mode, prj_ttf_reader_font_t **font);
+
+/*!
+ * \brief prj_ttf_reader_open_font_shared
+ *
+ * Same as prj_ttf_reader_open_font(), but the font is shared within
+ * the process: opening the same font file again returns the same
+ * font (with the same mapping and parsed tables) while it's opened,
+ * unless the font file has been changed (inode, modification time
+ * or size) in between. The font is closed by prj_ttf_reader_close_font()
+ * when the last reference is closed
+ * Shared font can be used from many threads at the same time
+ * The font file is mapped with PRJ_TTF_READER_LOAD_MODE_MMAP, so the font
+ * file must be replaced atomically (write a new file and rename it over
+ * the old one): the fonts that are already opened see the changes that
+ * are written into the same file and truncating it raises SIGBUS
+ * Options of the shared font can't be set (the setters return EPERM),
+ * open the font with prj_ttf_reader_open_font() to change them
+ *
+ * \param font_file_name [in] full filepath of ttf file
+ * \param font [out] shared font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_shared(const char *font_file_name, prj_ttf_reader_font_t **font);
+
+/*!
+ * \brief prj_ttf_reader_open_font_face
+ *
+ * Same as prj_ttf_reader_open_font(), but opens the face
+ * of the font collection (ttc or otc file)
+ * The font file is mapped like in prj_ttf_reader_open_font()
+ *
+ * \param font_file_name [in] full filepath of ttf or ttc file
+ * \param face_index [in] index of the face in font collection, 0 if font is not a collection
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_face(const char *font_file_name, uint32_t face_index, prj_ttf_reader_font_t **font);
+
+/*!
+ * \brief prj_ttf_reader_open_font_shared_face
+ *
+ * Same as prj_ttf_reader_open_font_shared(), but opens the face
+ * of the font collection (ttc or otc file)
+ * The shared faces of the same font file use the same mapping
+ *
+ * \param font_file_name [in] full filepath of ttf or ttc file
+ * \param face_index [in] index of the face in font collection, 0 if font is not a collection
+ * \param font [out] shared font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_shared_face(const char *font_file_name, uint32_t face_index, prj_ttf_reader_font_t **font);
+
+/*!
+ * \brief prj_ttf_reader_open_other_face
+ *
+ * Opens other face of the same font collection as the opened font.
+ * The faces use the same font data and the same parsed tables
+ * (such as common loca and hmtx), the font can be closed before the face
+ * Close the face with prj_ttf_reader_close_font()
+ *
+ * \param font [in] opened font
+ * \param face_index [in] index of the face in font collection
+ * \param face [out] opened face, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_other_face(const prj_ttf_reader_font_t *font, uint32_t face_index, prj_ttf_reader_font_t **face);
+
+/*!
+ * \brief prj_ttf_reader_get_face_count
+ *
+ * \param font [in] opened font
+ * \return number of faces in the font file, 1 if font is not a collection
+ */
+uint32_t prj_ttf_reader_get_face_count(const prj_ttf_reader_font_t *font);
+
+/*!
+ * \brief prj_ttf_reader_open_font_memory
+ *
+ * Same as prj_ttf_reader_open_font(), but the font is read from
+ * the memory (for example, font embedded in the binary)
+ *
+ * \param font_data [in] font data, the content of ttf file
+ * \param font_data_size [in] size of font data in bytes
+ * \param memory_mode [in] PRJ_TTF_READER_MEMORY_MODE_COPY or PRJ_TTF_READER_MEMORY_MODE_BORROW
+ * \param font [out] opened font, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_open_font_memory(const uint8_t *font_data, size_t font_data_size, int memory_mode, prj_ttf_reader_font_t **font);
+
+/*!
+ * \brief prj_ttf_reader_close_font
+ *
+ * Closes the font, shared font is closed when the last reference is closed
+ * Call this function after prj_ttf_reader_font_t is no longer required to use,
+ * drawing threads of the font are joined, so no generate call may use the font
+ *
+ * \param font [in/out] sets font to NULL
+ */
+void prj_ttf_reader_close_font(prj_ttf_reader_font_t **font);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8, but uses opened font
+ *
+ * \param utf8_text [in]
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_font(const char *utf8_text, prj_ttf_reader_font_t *font, float font_size_px, int quality, prj_ttf_reader_data_t *data);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_rotate_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8_rotate, but uses opened font
+ *
+ * \param utf8_text [in]
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_rotate_font(const char *utf8_text, prj_ttf_reader_font_t *font, float font_size_px, int quality, prj_ttf_reader_data_t *data,
+    float rotate, float move_glyph_x, float move_glyph_y);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters, but uses opened font
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_font(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_t *font, float font_size_px, int quality, prj_ttf_reader_data_t *data);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_rotate_font
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters_rotate, but uses opened font
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_rotate_font(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_t *font, float font_size_px, int quality, prj_ttf_reader_data_t *data, float rotate, float move_glyph_x, float move_glyph_y);
+
+/*!
+ * \brief prj_ttf_reader_get_kerning_font
+ *
+ * Get kerning between characters directly from opened font,
+ * glyphs don't need to be generated
+ *
+ * \param left_character left character index, for example 'a' == 97
+ * \param right_character right character index, for example 'b' == 98
+ * \param font_size_px [in] font size's in px
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \return kerning
+ */
+float prj_ttf_reader_get_kerning_font(uint32_t left_character, uint32_t right_character, float font_size_px, prj_ttf_reader_font_t *font);
+
+/*!
+ * \brief prj_ttf_reader_get_supported_characters_font
+ *
+ * get supported characters from opened font
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param supported_characters [out] supported characters will be filled here
+ * \return 0 on success
+ */
+int prj_ttf_reader_get_supported_characters_font(prj_ttf_reader_font_t *font, prj_ttf_reader_supported_characters_t *supported_characters);
+
+/*!
+ * \brief prj_ttf_reader_get_coverage_font
+ *
+ * get coverage of the opened font, coverage is built on the first call
+ * and it's valid until the font is closed
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param coverage [out] coverage of the font
+ * \return 0 on success
+ */
+int prj_ttf_reader_get_coverage_font(prj_ttf_reader_font_t *font, const prj_ttf_reader_coverage_t **coverage);
+
+/*!
+ * \brief prj_ttf_reader_coverage_has_character
+ *
+ * \param coverage [in] coverage from prj_ttf_reader_get_coverage_font()
+ * \param character [in] character, for example 'a' == 97
+ * \return 1 if font has glyph for the character, otherwise 0
+ */
+int prj_ttf_reader_coverage_has_character(const prj_ttf_reader_coverage_t *coverage, uint32_t character);
+
+/*!
+ * \brief prj_ttf_reader_coverage_get_mask
+ *
+ * check list of characters
+ *
+ * \param coverage [in] coverage from prj_ttf_reader_get_coverage_font()
+ * \param list_characters [in] list of characters
+ * \param list_characters_size [in] size of list_characters
+ * \param list_mask [out] 1 or 0 for each character of list_characters,
+ * size must be list_characters_size
+ * \return count of characters that font has
+ */
+uint32_t prj_ttf_reader_coverage_get_mask(const prj_ttf_reader_coverage_t *coverage, const uint32_t *list_characters,
+                                          uint32_t list_characters_size, uint8_t *list_mask);
+
+/*!
+ * \brief prj_ttf_reader_set_glyph_cache_size_font
+ *
+ * sets max memory size of the glyph outline cache of the font,
+ * least recently used glyphs are removed immediately if cache is larger
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param max_memory_size max size in bytes, 0 disables the cache
+ * \return 0 on success
+ */
+int prj_ttf_reader_set_glyph_cache_size_font(prj_ttf_reader_font_t *font, size_t max_memory_size);
+
+/*!
+ * \brief prj_ttf_reader_get_glyph_cache_stats_font
+ *
+ * get counters of the glyph outline cache of the font
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param stats [out] counters of the cache
+ * \return 0 on success
+ */
+int prj_ttf_reader_get_glyph_cache_stats_font(prj_ttf_reader_font_t *font, prj_ttf_reader_glyph_cache_stats_t *stats);
+
+/*!
+ * \brief prj_ttf_reader_set_fill_mode_font
+ *
+ * sets how the glyphs of the font are filled, also
+ * when the font is used in the font chain
+ *
+ * Option can be set while the font is used from other threads, it's used
+ * from the next generate call. Option of the shared font (prj_ttf_reader_open_font_shared())
+ * can't be set, because it would change the glyphs of every user of the font
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param fill_mode PRJ_TTF_READER_FILL_MODE_FLOOD, PRJ_TTF_READER_FILL_MODE_SCANLINE,
+ * PRJ_TTF_READER_FILL_MODE_ANALYTIC or PRJ_TTF_READER_FILL_MODE_TILED
+ * \return 0 on success, EPERM if the font is shared
+ */
+int prj_ttf_reader_set_fill_mode_font(prj_ttf_reader_font_t *font, int fill_mode);
+
+/*!
+ * \brief prj_ttf_reader_set_max_glyph_memory_size_font
+ *
+ * sets max memory size of the canvas (drawing) of single glyph,
+ * generating fails with ENOMEM if a glyph of the font needs more,
+ * PRJ_TTF_READER_FILL_MODE_TILED needs least memory for large glyphs
+ *
+ * Set like prj_ttf_reader_set_fill_mode_font(), not for the shared font
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param max_memory_size max size in bytes, 0 is no limit (default)
+ * \return 0 on success, EPERM if the font is shared
+ */
+int prj_ttf_reader_set_max_glyph_memory_size_font(prj_ttf_reader_font_t *font, size_t max_memory_size);
+
+/*!
+ * \brief prj_ttf_reader_set_thread_count_font
+ *
+ * sets count of the threads that draw the glyphs of single generate
+ * call in parallel, the generated image is same with any count of the threads.
+ * In the font chain the largest count of the fonts is used. The threads are
+ * kept by the font (or the chain) for the next calls and they are joined by
+ * prj_ttf_reader_close_font() (prj_ttf_reader_clear_font_chain()). Glyphs of
+ * the functions that take the font file name are drawn only in the calling thread
+ *
+ * Set like prj_ttf_reader_set_fill_mode_font(), not for the shared font
+ *
+ * \param font [in] font from prj_ttf_reader_open_font()
+ * \param thread_count count of the threads, 0 is the count of the processors (default)
+ * \return 0 on success, EPERM if the font is shared
+ */
+int prj_ttf_reader_set_thread_count_font(prj_ttf_reader_font_t *font, uint32_t thread_count);
+
+/*!
+ * \brief prj_ttf_reader_create_font_chain
+ *
+ * creates font fallback chain, fonts must be kept open
+ * until the chain is cleared
+ *
+ * \param list_font [in] fonts from prj_ttf_reader_open_font() in fallback order
+ * \param list_font_count [in] size of list_font
+ * \param chain [out] created chain, NULL on failure
+ * \return 0 on success
+ */
+int prj_ttf_reader_create_font_chain(prj_ttf_reader_font_t *const *list_font, uint32_t list_font_count, prj_ttf_reader_font_chain_t **chain);
+
+/*!
+ * \brief prj_ttf_reader_clear_font_chain
+ *
+ * clears the chain and joins its drawing threads, fonts of the chain are not closed
+ *
+ * \param chain [in/out] sets chain to NULL
+ */
+void prj_ttf_reader_clear_font_chain(prj_ttf_reader_font_chain_t **chain);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8, but uses font chain,
+ * prj_ttf_reader_glyph_data_t font_index tells the font of the glyph
+ *
+ * \param utf8_text [in]
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_font_chain(const char *utf8_text, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality, prj_ttf_reader_data_t *data);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_utf8_rotate_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_utf8_rotate, but uses font chain
+ *
+ * \param utf8_text [in]
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_utf8_rotate_font_chain(const char *utf8_text, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality,
+    prj_ttf_reader_data_t *data, float rotate, float move_glyph_x, float move_glyph_y);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters, but uses font chain
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_font_chain(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality, prj_ttf_reader_data_t *data);
+
+/*!
+ * \brief prj_ttf_reader_generate_glyphs_list_characters_rotate_font_chain
+ *
+ * same as prj_ttf_reader_generate_glyphs_list_characters_rotate, but uses font chain
+ *
+ * \param list_characters [in] list of characters, each character is uint32
+ * \param list_characters_size [in] size of list_characters
+ * \param chain [in] chain from prj_ttf_reader_create_font_chain()
+ * \param font_size_px [in] font size's in px
+ * \param quality [in] quality of the anti-aliasing, use 5 or 10 (5 is faster than 10)
+ * \param data [in/out] fills the prj_ttf_reader_data_t, this data was got from prj_ttf_reader_init_data
+ * \param rotate [in] glyph rotated angle, value must be >= 0 && < M_PI*2
+ * \param move_glyph_x [in] glyph drawing move in quality pixels (x), this must be >= 0 && < quality
+ * \param move_glyph_y [in] glyph drawing move in quality pixels (y), this must be >= 0 && < quality
+ * \return 0 on success
+ */
+int prj_ttf_reader_generate_glyphs_list_characters_rotate_font_chain(const uint32_t *list_characters, const uint32_t list_characters_size, prj_ttf_reader_font_chain_t *chain, float font_size_px, int quality, prj_ttf_reader_data_t *data, float rotate, float move_glyph_x, float move_glyph_y);
+
 /**
  * \brief prj_ttf_reader_rotate_by_angle
  *
@@ -27,18 +27,16 @@
  * \param data_size
  * \param offset
  * \param format4
- * \param corr_character_table
+ * \param arena subtable data is allocated from here
  * \return 0 on success
  */
 static int cmap_parse_character_to_glyph_index_mapping_table_subtable4(const uint8_t* data, size_t data_size, size_t offset,
-                                                         encoding_record_format4_t *format4,
-                                                         character_table_t *corr_character_table)
+                                                         encoding_record_format4_t *format4, arena_t *arena)
 {
     int ret;
     uint16_t i;
-    uint32_t f;
-    size_t range_start_offset;
-    size_t range_offset;
+    uint32_t seg_count;
+    uint32_t last_index;
 
     ret = parse_value_16u(data, data_size, &offset, &format4->length);
     if (ret) {
@@ -67,9 +65,9 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable4(const uin
     }
 
     if (format4->seg_count_x2) {
-        format4->end_code = (uint16_t *)malloc(sizeof(uint16_t)*format4->seg_count_x2/2);
+        format4->end_code = (uint16_t *)arena_alloc(arena, sizeof(uint16_t)*format4->seg_count_x2/2);
         if (!format4->end_code) {
-            return errno;
+            return ENOMEM;
         }
         for (i=0;i<format4->seg_count_x2/2;i++) {
             ret = parse_value_16u(data, data_size, &offset, &format4->end_code[i]);
@@ -85,9 +83,9 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable4(const uin
     }
 
     if (format4->seg_count_x2) {
-        format4->start_code = (uint16_t *)malloc(sizeof(uint16_t)*format4->seg_count_x2/2);
+        format4->start_code = (uint16_t *)arena_alloc(arena, sizeof(uint16_t)*format4->seg_count_x2/2);
         if (!format4->start_code) {
-            return errno;
+            return ENOMEM;
         }
         for (i=0;i<format4->seg_count_x2/2;i++) {
             ret = parse_value_16u(data, data_size, &offset, &format4->start_code[i]);
@@ -95,9 +93,9 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable4(const uin
                 return ret;
             }
         }
-        format4->id_delta = (uint16_t *)malloc(sizeof(uint16_t)*format4->seg_count_x2/2);
+        format4->id_delta = (uint16_t *)arena_alloc(arena, sizeof(uint16_t)*format4->seg_count_x2/2);
         if (!format4->id_delta) {
-            return errno;
+            return ENOMEM;
         }
         for (i=0;i<format4->seg_count_x2/2;i++) {
             ret = parse_value_16u(data, data_size, &offset, &format4->id_delta[i]);
@@ -106,10 +104,9 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable4(const uin
             }
         }
 
-        range_start_offset = offset;
-        format4->id_range_offset = (uint16_t *)malloc(sizeof(uint16_t)*format4->seg_count_x2/2);
+        format4->id_range_offset = (uint16_t *)arena_alloc(arena, sizeof(uint16_t)*format4->seg_count_x2/2);
         if (!format4->id_range_offset) {
-            return errno;
+            return ENOMEM;
         }
         for (i=0;i<format4->seg_count_x2/2;i++) {
             ret = parse_value_16u(data, data_size, &offset, &format4->id_range_offset[i]);
@@ -118,22 +115,33 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable4(const uin
             }
         }
 
-        for (i=0;i<format4->seg_count_x2/2;i++) {
-            if (!format4->id_range_offset[i]) {
-                for (f=format4->start_code[i];f<=format4->end_code[i];f++) {
-                    if (f <= UINT16_MAX) {
-                        format4->glyph_id_array[f] = (uint16_t)(f + format4->id_delta[i]);
-                        corr_character_table->character[ format4->glyph_id_array[f] ] = f;
-                    }
-                }
-            } else {
-                range_offset = range_start_offset + format4->id_range_offset[i] + sizeof(uint16_t)*i;
-                for (f=format4->start_code[i];f<=format4->end_code[i];f++) {
-                    ret = parse_value_16u(data, data_size, &range_offset, &format4->glyph_id_array[f]);
-                    if (ret) {
-                        return ret;
-                    }
-                    corr_character_table->character[ format4->glyph_id_array[f] ] = f;
+        // id_range_offset is byte offset from id_range_offset[i] to the
+        // glyph id array, only the referenced part of the array is parsed
+        seg_count = format4->seg_count_x2/2;
+        for (i=0;i<seg_count;i++) {
+            if (!format4->id_range_offset[i] || format4->start_code[i] > format4->end_code[i]
+                    || format4->id_range_offset[i]/2 + i < seg_count) {
+                continue;
+            }
+            last_index = format4->id_range_offset[i]/2 + i - seg_count
+                    + (uint32_t)(format4->end_code[i] - format4->start_code[i]);
+            if (last_index >= format4->glyph_id_array_count) {
+                format4->glyph_id_array_count = last_index + 1;
+            }
+        }
+
+        if (format4->glyph_id_array_count) {
+            if (offset + format4->glyph_id_array_count*sizeof(uint16_t) > data_size) {
+                return EIO;
+            }
+            format4->glyph_id_array = (uint16_t *)arena_alloc(arena, sizeof(uint16_t)*format4->glyph_id_array_count);
+            if (!format4->glyph_id_array) {
+                return ENOMEM;
+            }
+            for (last_index=0;last_index<format4->glyph_id_array_count;last_index++) {
+                ret = parse_value_16u(data, data_size, &offset, &format4->glyph_id_array[last_index]);
+                if (ret) {
+                    return ret;
                 }
             }
         }
@@ -152,12 +160,11 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable4(const uin
  * \param data_size
  * \param offset
  * \param format6
- * \param corr_character_table
+ * \param arena subtable data is allocated from here
  * \return 0 on success
  */
 static int cmap_parse_character_to_glyph_index_mapping_table_subtable6(const uint8_t* data, size_t data_size, size_t offset,
-                                                         encoding_record_format6_t *format6,
-                                                         character_table_t *corr_character_table)
+                                                         encoding_record_format6_t *format6, arena_t *arena)
 {
     uint16_t i;
     int ret;
@@ -186,9 +193,9 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable6(const uin
     }
 
     format6->entry_count /= (uint16_t)sizeof(uint16_t);
-    format6->glyph_id_array = (uint16_t *)calloc(format6->entry_count, sizeof(uint16_t));
+    format6->glyph_id_array = (uint16_t *)arena_calloc(arena, format6->entry_count, sizeof(uint16_t));
     if (!format6->glyph_id_array) {
-        return errno;
+        return ENOMEM;
     }
 
     for (i=0;i<format6->entry_count;i++) {
@@ -196,8 +203,6 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable6(const uin
         if (ret) {
             return ret;
         }
-
-        corr_character_table->character[ format6->glyph_id_array[i] ] = (uint32_t)(i+format6->first_code);
     }
 
     return 0;
@@ -213,15 +218,13 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable6(const uin
  * \param data_size
  * \param offset
  * \param format12
- * \param corr_character_table
+ * \param arena subtable data is allocated from here
  * \return 0 on success
  */
 static int cmap_parse_character_to_glyph_index_mapping_table_subtable12(const uint8_t* data, size_t data_size, size_t offset,
-                                                         encoding_record_format12_t *format12,
-                                                         character_table_t *corr_character_table)
+                                                         encoding_record_format12_t *format12, arena_t *arena)
 {
     uint32_t i;
-    uint32_t s;
     int ret;
     ret = parse_value_16u(data, data_size, &offset, &format12->reserved);
     if (ret) {
@@ -247,9 +250,17 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable12(const ui
         return ret;
     }
 
-    format12->groups = (sequential_map_group_t *)malloc(format12->numGroups*sizeof(sequential_map_group_t));
+    if (!format12->numGroups) {
+        return 0;
+    }
+    // each group is 3 * uint32_t in the font data
+    if (format12->numGroups > (data_size - offset)/(3*sizeof(uint32_t))) {
+        return EIO;
+    }
+
+    format12->groups = (sequential_map_group_t *)arena_alloc(arena, format12->numGroups*sizeof(sequential_map_group_t));
     if (!format12->groups) {
-        return errno;
+        return ENOMEM;
     }
 
     for (i=0;i<format12->numGroups;i++) {
@@ -265,13 +276,77 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable12(const ui
         if (ret) {
             return ret;
         }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief cmap_clear_encoding_record
+ *
+ * Removes the parsed subtable of the encoding record, the memory
+ * of subtable is released by cmap_clear()
+ *
+ * \param encoding_record
+ */
+static void cmap_clear_encoding_record(encoding_record_t *encoding_record)
+{
+    encoding_record->format4 = NULL;
+    encoding_record->format6 = NULL;
+    encoding_record->format12 = NULL;
+}
+
+/*!
+ * \brief cmap_parse_encoding_record_subtable
+ *
+ * parse format 4, 6 or 12 subtable of the encoding record,
+ * other formats are ignored
+ *
+ * \param data
+ * \param data_size
+ * \param offset offset of the subtable
+ * \param encoding_record
+ * \param arena subtable is allocated from here
+ * \return 0 on success
+ */
+static int cmap_parse_encoding_record_subtable(const uint8_t* data, size_t data_size, size_t offset,
+                                               encoding_record_t *encoding_record, arena_t *arena)
+{
+    int ret;
+    uint16_t format;
+
+    ret = parse_value_16u(data, data_size, &offset, &format);
+    if (ret) {
+        return ret;
+    }
 
-        for (s=0;s<=format12->groups[i].end_char_code-format12->groups[i].start_char_code;s++) {
-            if (format12->groups[i].start_glyph_id+s < UINT16_MAX
-                    && format12->groups[i].start_glyph_id+s < UINT16_MAX) {
-                corr_character_table->character[format12->groups[i].start_glyph_id+s] = format12->groups[i].start_char_code+s;
+    switch (format) {
+        case 4:
+            encoding_record->format4 = (encoding_record_format4_t *)arena_calloc(arena, 1, sizeof(encoding_record_format4_t));
+            if (!encoding_record->format4) {
+                return ENOMEM;
             }
-        }
+            encoding_record->format4->format = format;
+            return cmap_parse_character_to_glyph_index_mapping_table_subtable4(data, data_size, offset,
+                                                                               encoding_record->format4, arena);
+        case 6:
+            encoding_record->format6 = (encoding_record_format6_t *)arena_calloc(arena, 1, sizeof(encoding_record_format6_t));
+            if (!encoding_record->format6) {
+                return ENOMEM;
+            }
+            encoding_record->format6->format = format;
+            return cmap_parse_character_to_glyph_index_mapping_table_subtable6(data, data_size, offset,
+                                                                               encoding_record->format6, arena);
+        case 12:
+            encoding_record->format12 = (encoding_record_format12_t *)arena_calloc(arena, 1, sizeof(encoding_record_format12_t));
+            if (!encoding_record->format12) {
+                return ENOMEM;
+            }
+            encoding_record->format12->format = format;
+            return cmap_parse_character_to_glyph_index_mapping_table_subtable12(data, data_size, offset,
+                                                                                encoding_record->format12, arena);
+        default:
+            break;
     }
 
     return 0;
@@ -281,23 +356,25 @@ static int cmap_parse_character_to_glyph_index_mapping_table_subtable12(const ui
  * \brief cmap_parse_character_to_glyph_index_mapping_table
  *
  * https://docs.microsoft.com/en-us/typography/opentype/spec/cmap
+ * Subtables are kept as segments and groups, so the parsed table is
+ * small also for fonts having characters above U+FFFF. Encoding records
+ * pointing to already parsed subtable are not parsed again.
  *
  * \param data
  * \param data_size
  * \param offset
  * \param character_to_glyph_index_table
- * \param corr_character_table
  * \return 0 on success
  */
 int cmap_parse_character_to_glyph_index_mapping_table(const uint8_t* data, size_t data_size, size_t offset,
-                                                      character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
-                                                      character_table_t *corr_character_table)
+                                                      character_to_glyph_index_mapping_table_t *character_to_glyph_index_table)
 {
     int ret;
-    uint16_t i;
+    uint16_t i, j;
     size_t start_offset = offset;
-    size_t tmp_offset;
-    uint16_t format;
+    int has_format4 = 0;
+    encoding_record_t *encoding_record;
+
     ret = parse_value_16u(data, data_size, &offset, &character_to_glyph_index_table->version);
     if (ret) {
         return ret;
@@ -311,68 +388,53 @@ int cmap_parse_character_to_glyph_index_mapping_table(const uint8_t* data, size_
         return 0;
     }
 
-    character_to_glyph_index_table->list_encoding_record = (encoding_record_t *)malloc(sizeof(encoding_record_t)*character_to_glyph_index_table->num_tables);
+    // parsed subtables are not larger than the subtables in the font data,
+    // so the whole table fits usually into the first block of the arena
+    character_to_glyph_index_table->arena.block_size = (data_size > offset ? data_size - offset : 0)
+            + character_to_glyph_index_table->num_tables*(sizeof(encoding_record_t) + sizeof(encoding_record_format4_t)
+                                                          + 6*ARENA_ALIGNMENT);
+    character_to_glyph_index_table->list_encoding_record = (encoding_record_t *)arena_calloc(&character_to_glyph_index_table->arena,
+                                                                                             character_to_glyph_index_table->num_tables,
+                                                                                             sizeof(encoding_record_t));
     if (!character_to_glyph_index_table->list_encoding_record) {
-        return errno;
+        return ENOMEM;
     }
-    memset(character_to_glyph_index_table->list_encoding_record, 0, sizeof(encoding_record_t)*character_to_glyph_index_table->num_tables);
     for (i=0;i<character_to_glyph_index_table->num_tables;i++) {
-        ret = parse_value_16u(data, data_size, &offset, &character_to_glyph_index_table->list_encoding_record[i].platform_id);
+        encoding_record = &character_to_glyph_index_table->list_encoding_record[i];
+        ret = parse_value_16u(data, data_size, &offset, &encoding_record->platform_id);
         if (ret) {
             return ret;
         }
-        ret = parse_value_16u(data, data_size, &offset, &character_to_glyph_index_table->list_encoding_record[i].encoding_id);
+        ret = parse_value_16u(data, data_size, &offset, &encoding_record->encoding_id);
         if (ret) {
             return ret;
         }
-        ret = parse_value_32u(data, data_size, &offset, &character_to_glyph_index_table->list_encoding_record[i].offset);
+        ret = parse_value_32u(data, data_size, &offset, &encoding_record->offset);
         if (ret) {
             return ret;
         }
 
-        tmp_offset = start_offset + character_to_glyph_index_table->list_encoding_record[i].offset;
-        ret = parse_value_16u(data, data_size, &tmp_offset, &format);
-        if (ret) {
-            return ret;
+        for (j=0;j<i;j++) {
+            if (character_to_glyph_index_table->list_encoding_record[j].offset == encoding_record->offset) {
+                break;
+            }
+        }
+        if (j < i) {
+            continue;
         }
 
-        switch (format) {
-            case 4:
-                // format 4 is pretty good, so if it's format 4
-                // it's enough for cmap
-                character_to_glyph_index_table->list_encoding_record[i].format4 = (encoding_record_format4_t *)calloc(1, sizeof(encoding_record_format4_t));
-                if (!character_to_glyph_index_table->list_encoding_record[i].format4) {
-                    return errno;
-                }
-                character_to_glyph_index_table->list_encoding_record[i].format4->format = format;
-                return cmap_parse_character_to_glyph_index_mapping_table_subtable4(data, data_size, tmp_offset,
-                                                                                   character_to_glyph_index_table->list_encoding_record[i].format4,
-                                                                                   corr_character_table);
-            case 6:
-                character_to_glyph_index_table->list_encoding_record[i].format6 = (encoding_record_format6_t *)calloc(1, sizeof(encoding_record_format6_t));
-                if (!character_to_glyph_index_table->list_encoding_record[i].format6) {
-                    return errno;
-                }
-                character_to_glyph_index_table->list_encoding_record[i].format6->format = format;
-                ret = cmap_parse_character_to_glyph_index_mapping_table_subtable6(data, data_size, tmp_offset,
-                                                                                  character_to_glyph_index_table->list_encoding_record[i].format6,
-                                                                                  corr_character_table);
-                if (ret) {
-                    return ret;
-                }
-                break;
-            case 12:
-                character_to_glyph_index_table->list_encoding_record[i].format12 = (encoding_record_format12_t *)calloc(1, sizeof(encoding_record_format12_t));
-                character_to_glyph_index_table->list_encoding_record[i].format12->format = format;
-                ret = cmap_parse_character_to_glyph_index_mapping_table_subtable12(data, data_size, tmp_offset,
-                                                                                  character_to_glyph_index_table->list_encoding_record[i].format12,
-                                                                                  corr_character_table);
-                if (ret) {
-                    return ret;
-                }
-                break;
-            default:
-                break;
+        ret = cmap_parse_encoding_record_subtable(data, data_size, start_offset + encoding_record->offset,
+                                                  encoding_record, &character_to_glyph_index_table->arena);
+        if (ret) {
+            // format 4 is pretty good, so if it's already parsed
+            // broken subtables after it are only skipped
+            if (!has_format4) {
+                return ret;
+            }
+            cmap_clear_encoding_record(encoding_record);
+        }
+        if (encoding_record->format4) {
+            has_format4 = 1;
         }
     }
 
@@ -382,43 +444,250 @@ int cmap_parse_character_to_glyph_index_mapping_table(const uint8_t* data, size_
 /*!
  * \brief cmap_clear
  *
- * Clears the all values in character_to_glyph_index_table
+ * Clears the all values in character_to_glyph_index_table,
+ * the all subtables are released at once
  *
  * \param character_to_glyph_index_table
  */
 void cmap_clear(character_to_glyph_index_mapping_table_t *character_to_glyph_index_table)
+{
+    arena_clear(&character_to_glyph_index_table->arena);
+    character_to_glyph_index_table->list_encoding_record = NULL;
+    character_to_glyph_index_table->num_tables = 0;
+}
+
+/*!
+ * \brief cmap_get_glyph_index_format4_segment
+ *
+ * \param format4
+ * \param segment segment index that contains the character
+ * \param character
+ * \return glyph index, 0 if character is not in format4
+ */
+static uint16_t cmap_get_glyph_index_format4_segment(const encoding_record_format4_t *format4, uint32_t segment,
+                                                     uint32_t character)
+{
+    uint32_t index;
+    uint16_t glyph_index;
+
+    if (!format4->id_range_offset[segment]) {
+        return (uint16_t)(character + format4->id_delta[segment]);
+    }
+
+    if (format4->id_range_offset[segment]/2 + segment < (uint32_t)format4->seg_count_x2/2) {
+        return 0;
+    }
+    index = format4->id_range_offset[segment]/2 + segment - (uint32_t)format4->seg_count_x2/2
+            + character - format4->start_code[segment];
+    if (index >= format4->glyph_id_array_count) {
+        return 0;
+    }
+    glyph_index = format4->glyph_id_array[index];
+    if (!glyph_index) {
+        return 0;
+    }
+    return (uint16_t)(glyph_index + format4->id_delta[segment]);
+}
+
+/*!
+ * \brief cmap_get_glyph_index_format4
+ *
+ * binary search of the segment that contains the character
+ *
+ * \param format4
+ * \param character
+ * \return glyph index, 0 if character is not in format4
+ */
+static uint16_t cmap_get_glyph_index_format4(const encoding_record_format4_t *format4, uint32_t character)
+{
+    uint32_t first = 0;
+    uint32_t last = format4->seg_count_x2/2;
+    uint32_t middle;
+
+    if (character > UINT16_MAX || !format4->end_code || !format4->start_code) {
+        return 0;
+    }
+
+    // find the first segment which end_code >= character
+    while (first < last) {
+        middle = first + (last - first)/2;
+        if (format4->end_code[middle] < character) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    if (first == format4->seg_count_x2/2 || format4->start_code[first] > character) {
+        return 0;
+    }
+
+    return cmap_get_glyph_index_format4_segment(format4, first, character);
+}
+
+/*!
+ * \brief cmap_get_glyph_index_format6
+ *
+ * \param format6
+ * \param character
+ * \return glyph index, 0 if character is not in format6
+ */
+static uint16_t cmap_get_glyph_index_format6(const encoding_record_format6_t *format6, uint32_t character)
+{
+    if (!format6->glyph_id_array || character < format6->first_code
+            || character - format6->first_code >= format6->entry_count) {
+        return 0;
+    }
+    return format6->glyph_id_array[character - format6->first_code];
+}
+
+/*!
+ * \brief cmap_get_glyph_index_format12
+ *
+ * binary search of the group that contains the character
+ *
+ * \param format12
+ * \param character
+ * \return glyph index, 0 if character is not in format12
+ */
+static uint16_t cmap_get_glyph_index_format12(const encoding_record_format12_t *format12, uint32_t character)
+{
+    uint32_t first = 0;
+    uint32_t last = format12->numGroups;
+    uint32_t middle;
+    uint32_t glyph_index;
+
+    if (!format12->groups) {
+        return 0;
+    }
+
+    // find the first group which end_char_code >= character
+    while (first < last) {
+        middle = first + (last - first)/2;
+        if (format12->groups[middle].end_char_code < character) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    if (first == format12->numGroups || format12->groups[first].start_char_code > character) {
+        return 0;
+    }
+
+    glyph_index = format12->groups[first].start_glyph_id + character - format12->groups[first].start_char_code;
+    if (glyph_index > UINT16_MAX) {
+        return 0;
+    }
+    return (uint16_t)glyph_index;
+}
+
+/*!
+ * \brief cmap_get_glyph_index
+ *
+ * get glyph index of the character
+ * BMP characters are searched from the first format 4 subtable,
+ * other characters and fonts without format 4 use format 12 and format 6
+ *
+ * \param character_to_glyph_index_table
+ * \param character character, for example 'a' == 97
+ * \param glyph_index [out] glyph index of the character
+ * \return 0 on success, EINVAL if font doesn't have glyph for the character
+ */
+int cmap_get_glyph_index(const character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
+                         uint32_t character, uint16_t *glyph_index)
 {
     uint16_t i;
-    if (character_to_glyph_index_table->list_encoding_record) {
-        for (i=0;i<character_to_glyph_index_table->num_tables;i++) {
-            if (character_to_glyph_index_table->list_encoding_record[i].format4) {
-                if (character_to_glyph_index_table->list_encoding_record[i].format4->end_code) {
-                    free(character_to_glyph_index_table->list_encoding_record[i].format4->end_code);
-                }
-                if (character_to_glyph_index_table->list_encoding_record[i].format4->id_delta) {
-                    free(character_to_glyph_index_table->list_encoding_record[i].format4->id_delta);
-                }
-                if (character_to_glyph_index_table->list_encoding_record[i].format4->start_code) {
-                    free(character_to_glyph_index_table->list_encoding_record[i].format4->start_code);
-                }
-                if (character_to_glyph_index_table->list_encoding_record[i].format4->id_range_offset) {
-                    free(character_to_glyph_index_table->list_encoding_record[i].format4->id_range_offset);
+    const encoding_record_t *record;
+    const encoding_record_format4_t *format4 = NULL;
+    const encoding_record_format6_t *format6 = NULL;
+    const encoding_record_format12_t *format12 = NULL;
+
+    if (!character_to_glyph_index_table->list_encoding_record) {
+        return EINVAL;
+    }
+
+    for (i=0;i<character_to_glyph_index_table->num_tables;i++) {
+        record = &character_to_glyph_index_table->list_encoding_record[i];
+        if (record->format4 && !format4) {
+            format4 = record->format4;
+        }
+        if (record->format12 && !format12) {
+            format12 = record->format12;
+        }
+        if (record->format6 && !format6) {
+            format6 = record->format6;
+        }
+    }
+
+    *glyph_index = 0;
+    if (format4 && character <= UINT16_MAX) {
+        *glyph_index = cmap_get_glyph_index_format4(format4, character);
+        return *glyph_index ? 0 : EINVAL;
+    }
+    if (format12) {
+        *glyph_index = cmap_get_glyph_index_format12(format12, character);
+    }
+    if (!*glyph_index && !format4 && format6) {
+        *glyph_index = cmap_get_glyph_index_format6(format6, character);
+    }
+    return *glyph_index ? 0 : EINVAL;
+}
+
+/*!
+ * \brief cmap_fill_glyph_characters
+ *
+ * fill character of each glyph index, the subtables are walked in
+ * the encoding record order until the first format 4 subtable, so
+ * if many characters have same glyph, the last one of them is set
+ *
+ * \param character_to_glyph_index_table
+ * \param list_character [out] character of each glyph index, must be set to 0 by the caller
+ * \param list_character_count size of list_character, usually glyphs count
+ */
+void cmap_fill_glyph_characters(const character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
+                                uint32_t *list_character, uint32_t list_character_count)
+{
+    uint16_t i;
+    uint32_t segment, f, glyph_index;
+    const encoding_record_t *record;
+    const sequential_map_group_t *group;
+
+    if (!character_to_glyph_index_table->list_encoding_record) {
+        return;
+    }
+
+    for (i=0;i<character_to_glyph_index_table->num_tables;i++) {
+        record = &character_to_glyph_index_table->list_encoding_record[i];
+        if (record->format6 && record->format6->glyph_id_array) {
+            for (f=0;f<record->format6->entry_count;f++) {
+                if (record->format6->glyph_id_array[f] < list_character_count) {
+                    list_character[record->format6->glyph_id_array[f]] = f + record->format6->first_code;
                 }
-                free(character_to_glyph_index_table->list_encoding_record[i].format4);
             }
-            if (character_to_glyph_index_table->list_encoding_record[i].format6) {
-                if (character_to_glyph_index_table->list_encoding_record[i].format6->glyph_id_array) {
-                    free(character_to_glyph_index_table->list_encoding_record[i].format6->glyph_id_array);
+        }
+        if (record->format12 && record->format12->groups) {
+            for (segment=0;segment<record->format12->numGroups;segment++) {
+                group = &record->format12->groups[segment];
+                for (f=group->start_char_code;f<=group->end_char_code;f++) {
+                    glyph_index = group->start_glyph_id + f - group->start_char_code;
+                    if (glyph_index >= list_character_count || f == UINT32_MAX) {
+                        break;
+                    }
+                    list_character[glyph_index] = f;
                 }
-                free(character_to_glyph_index_table->list_encoding_record[i].format6);
             }
-            if (character_to_glyph_index_table->list_encoding_record[i].format12) {
-                if (character_to_glyph_index_table->list_encoding_record[i].format12->groups) {
-                    free(character_to_glyph_index_table->list_encoding_record[i].format12->groups);
+        }
+        if (record->format4 && record->format4->end_code) {
+            for (segment=0;segment<(uint32_t)record->format4->seg_count_x2/2;segment++) {
+                for (f=record->format4->start_code[segment];f<=record->format4->end_code[segment];f++) {
+                    glyph_index = cmap_get_glyph_index_format4_segment(record->format4, segment, f);
+                    if (glyph_index < list_character_count) {
+                        list_character[glyph_index] = f;
+                    }
                 }
-                free(character_to_glyph_index_table->list_encoding_record[i].format12);
             }
+            break;
         }
-        free(character_to_glyph_index_table->list_encoding_record);
     }
 }
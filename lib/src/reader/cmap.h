@@ -15,16 +15,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
-
-/*!
- * \brief The character_table_t struct
- *
- * This table is to help to get character by glyphIndex
- */
-typedef struct
-{
-    uint32_t character[UINT16_MAX];
-} character_table_t;
+#include "../arena.h"
 
 /*!
  * \brief The encoding_record_format4_t struct
@@ -48,7 +39,8 @@ typedef struct {
     uint16_t *start_code;
     uint16_t *id_delta;
     uint16_t *id_range_offset;
-    uint16_t glyph_id_array[UINT16_MAX+1];
+    uint16_t *glyph_id_array;           // glyph id array after id_range_offset
+    uint32_t glyph_id_array_count;      // entries referenced by the segments
 } encoding_record_format4_t;
 
 /*!
@@ -99,6 +91,9 @@ typedef struct {
 /*!
  * \brief The encoding_record_t struct
  * https://docs.microsoft.com/en-us/typography/opentype/spec/cmap
+ *
+ * subtable pointers are NULL if the format is not supported or
+ * the same subtable is already parsed by earlier encoding record
  */
 typedef struct {
     uint16_t platform_id;
@@ -118,12 +113,16 @@ typedef struct {
     uint16_t version;
     uint16_t num_tables;
     encoding_record_t *list_encoding_record;   // size is num_tables
+    arena_t arena;      // encoding records and subtables are allocated from here
 } character_to_glyph_index_mapping_table_t;
 
 int cmap_parse_character_to_glyph_index_mapping_table(const uint8_t* data, size_t data_size,
                                                       size_t offset,
-                                                      character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
-                                                      character_table_t *corr_character_table);
+                                                      character_to_glyph_index_mapping_table_t *character_to_glyph_index_table);
 void cmap_clear(character_to_glyph_index_mapping_table_t *character_to_glyph_index_table);
+int cmap_get_glyph_index(const character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
+                         uint32_t character, uint16_t *glyph_index);
+void cmap_fill_glyph_characters(const character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
+                                uint32_t *list_character, uint32_t list_character_count);
 
 #endif // CMAP_H
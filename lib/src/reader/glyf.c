@@ -23,6 +23,11 @@
 
 int glyf_parse_point(const uint8_t *data, size_t data_size, uint8_t *listFlags, int16_t *listPoint, uint16_t num_points, size_t *offset, uint8_t x);
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GLYF_PARSE_POINT_SSSE3
+#include <tmmintrin.h>
+#endif
+
 /*!
  * \brief glyf_is_off_curve
  *
@@ -57,197 +62,6 @@ static float f_2_dot_14(int16_t value)
     return dividend/divisor+(float)add;
 }
 
-/*!
- * \brief glyf_generate_contours
- *
- * Generates glyphs contours
- *
- * \param glyph
- * \return 0 on success
- */
-static int glyf_generate_contours(glyph_t *glyph)
-{
-    uint16_t i, index_contour;
-    uint16_t num_points;
-    float prev_point_x = 0;
-    float prev_point_y = 0;
-    int16_t x0;
-    int16_t y0;
-    int16_t x1;
-    int16_t y1;
-    uint16_t point_index0;
-    uint16_t point_index1;
-    uint16_t point_index2;
-    uint16_t point_index_last;
-    uint16_t num_points_per_contour;
-    uint16_t point_index_0;
-    uint16_t coutour_count_first_point = 0;
-    uint16_t current_contour_index = 0;
-    uint16_t num_points_list;
-    uint8_t is_curve0;
-    uint8_t is_curve1;
-    glyph_curve_t curve;
-    uint16_t **point_index;
-    uint16_t *listPointsPerContour;
-    uint16_t *contour_index;
-    glyph_curve_t *tmp;
-    const uint16_t u_num_contour = (uint16_t)glyph->num_contours;
-
-    point_index = (uint16_t **)(malloc((uint32_t)(u_num_contour*sizeof(uint16_t *))));
-    if (!point_index) {
-        return errno;
-    }
-    listPointsPerContour = (uint16_t *)malloc( (uint32_t)(sizeof(uint16_t)*u_num_contour));
-    if (!listPointsPerContour) {
-        return errno;
-    }
-
-    for (i=0;i<glyph->num_contours;i++) {
-        if (i == 0) {
-            num_points = (uint16_t)(glyph->list_end_points_contours[i] + 1);
-        } else {
-            num_points = (uint16_t)(glyph->list_end_points_contours[i] - glyph->list_end_points_contours[i-1]);
-        }
-
-        point_index[i] = (uint16_t *)(malloc((uint32_t)(num_points*sizeof(uint16_t))));
-        if (!point_index[i]) {
-            return errno;
-        }
-        listPointsPerContour[i] = num_points;
-    }
-
-    num_points_list = (uint16_t)(glyph->max_num_end_contours + 1);
-
-    glyph->list_path = (glyph_path_t *)malloc( (uint32_t)(sizeof(glyph_path_t)*u_num_contour) );
-    if (!glyph->list_path) {
-        return errno;
-    }
-    glyph->list_path_size = (uint32_t)glyph->num_contours;
-
-    contour_index = (uint16_t *)malloc( (uint32_t)(sizeof(uint16_t)*num_points_list) );
-    if (!contour_index) {
-        return errno;
-    }
-
-    for (i=0;i<num_points_list;i++) {
-        if (i > glyph->list_end_points_contours[current_contour_index]) {
-            current_contour_index++;
-            coutour_count_first_point = 0;
-        }
-
-        contour_index[i] = current_contour_index;
-        point_index[current_contour_index][coutour_count_first_point] = i;
-        coutour_count_first_point++;
-    }
-
-    for (i=0;i<glyph->num_contours;i++) {
-        num_points_per_contour = listPointsPerContour[i];
-        point_index_0 = point_index[i][0];
-
-        //If the first point is off curve
-        if (glyf_is_off_curve(glyph->list_flags[point_index_0])) {
-            point_index_last = point_index[i][num_points_per_contour - 1];
-            if (glyf_is_off_curve(glyph->list_flags[point_index_last])) {
-                prev_point_x = (float)(glyph->list_point_x[point_index_0]+glyph->list_point_x[point_index_last])/2.0f;
-                prev_point_y = (float)(glyph->list_point_y[point_index_0]+glyph->list_point_y[point_index_last])/2.0f;
-            }
-            else {
-                prev_point_x = (float)glyph->list_point_x[point_index_last];
-                prev_point_y = (float)glyph->list_point_y[point_index_last];
-            }
-        }
-
-        for (index_contour=0;index_contour<num_points_per_contour;index_contour++) {
-            point_index0 = point_index[i][index_contour % num_points_per_contour];
-            point_index1 = point_index[i][(index_contour + 1) % num_points_per_contour];
-
-            is_curve0 = glyf_is_off_curve(glyph->list_flags[point_index0]);
-            is_curve1 = glyf_is_off_curve(glyph->list_flags[point_index1]);
-
-            curve.is_curve = (is_curve0 || is_curve1);
-
-            x0 = glyph->list_point_x[point_index0];
-            y0 = glyph->list_point_y[point_index0];
-            x1 = glyph->list_point_x[point_index1];
-            y1 = glyph->list_point_y[point_index1];
-
-            if (is_curve0) {
-                curve.x0 = prev_point_x;
-                curve.y0 = prev_point_y;
-                curve.curve_x = x0;
-                curve.curve_y = y0;
-
-                if (is_curve1) {
-                    curve.x1 = (float)(x0 + x1)/2.0f;
-                    curve.y1 = (float)(y0 + y1)/2.0f;
-                    prev_point_x = curve.x1;
-                    prev_point_y = curve.y1;
-                } else {
-                    curve.x1 = x1;
-                    curve.y1 = y1;
-                }
-            }  else if (is_curve1) {
-                point_index2 = point_index[i][(index_contour + 2) % num_points_per_contour];
-
-                if (glyf_is_off_curve(glyph->list_flags[point_index2])) {
-                    curve.x0 = x0;
-                    curve.y0 = y0;
-                    curve.curve_x = x1;
-                    curve.curve_y = y1;
-                    curve.x1 = (float)(x1 + glyph->list_point_x[point_index2])/2.0f;
-                    curve.y1 = (float)(y1 + glyph->list_point_y[point_index2])/2.0f;
-                    prev_point_x = curve.x1;
-                    prev_point_y = curve.y1;
-                } else {
-                    curve.x0 = x0;
-                    curve.y0 = y0;
-                    curve.curve_x = x1;
-                    curve.curve_y = y1;
-                    curve.x1 = glyph->list_point_x[point_index2];
-                    curve.y1 = glyph->list_point_y[point_index2];
-                    prev_point_x = x0;
-                    prev_point_y = y0;
-               }
-            } else {
-                curve.x0 = x0;
-                curve.y0 = y0;
-                curve.x1 = x1;
-                curve.y1 = y1;
-                // it's line, curve points are ignored
-                curve.curve_x = 0;
-                curve.curve_y = 0;
-
-                prev_point_x = x0;
-                prev_point_y = y0;
-            }
-
-            if (index_contour == 0) {
-                glyph->list_path[i].list_glyph_curve_size = 1;
-                glyph->list_path[i].list_glyph_curve = (glyph_curve_t *)malloc( sizeof(glyph_curve_t) );
-                if (!glyph->list_path[i].list_glyph_curve) {
-                    return errno;
-                }
-            } else {
-                glyph->list_path[i].list_glyph_curve_size++;
-                tmp = (glyph_curve_t *)realloc(glyph->list_path[i].list_glyph_curve, sizeof(glyph_curve_t)*glyph->list_path[i].list_glyph_curve_size );
-                if (!tmp) {
-                    return errno;
-                }
-                glyph->list_path[i].list_glyph_curve = tmp;
-            }
-            glyph->list_path[i].list_glyph_curve[glyph->list_path[i].list_glyph_curve_size - 1] = curve;
-        }
-    }
-
-    for (i=0;i<glyph->num_contours;i++) {
-        free(point_index[i]);
-    }
-    free(point_index);
-    free(contour_index);
-    free(listPointsPerContour);
-    return 0;
-}
-
 /*!
  * \brief glyf_generate_glyph_from_transformation
  *
@@ -260,9 +74,10 @@ static int glyf_generate_contours(glyph_t *glyph)
  * \param in curve to transformation
  * \param ret new glyph curve here
  */
-static void glyf_generate_glyph_from_transformation(float transformation[6], const glyph_curve_t *in, glyph_curve_t *ret)
+static void glyf_generate_glyph_from_transformation(const float transformation[6], const glyph_curve_t *in, glyph_curve_t *ret)
 {
     ret->is_curve = in->is_curve;
+    ret->is_repeated = in->is_repeated;
 
     ret->x0 = in->x0*transformation[0] + in->y0*transformation[1] + transformation[4];
     ret->y0 = in->x0*transformation[2] + in->y0*transformation[3] + transformation[5];
@@ -281,168 +96,326 @@ static void glyf_generate_glyph_from_transformation(float transformation[6], con
 }
 
 /*!
- * \brief glyf_generate_compositive_glyph
+ * \brief glyf_parse_component
  *
- * Generates composite glyph such as "ä"
+ * Parses single component of composite glyph
  *
  * \param data
  * \param data_size
- * \param index_glyph
- * \param list_glyph
- * \param glyf_offset
- * \param list_index_to_loc_table
- * \param profile
- * \param offset
+ * \param offset [in/out] offset of the component, moved to next component
+ * \param composite_glyph_flags [out] flags of the component
+ * \param index_composite_glyph [out] glyph index of the component
+ * \param transformation [out] transformation of the component
+ * \param composite_equal [out] 1 if the component is not transformed
  * \return 0 on success
  */
-static int glyf_generate_compositive_glyph(const uint8_t *data, size_t data_size, uint16_t index_glyph,
-               glyph_t *list_glyph, size_t glyf_offset,
-               index_to_loc_table_t *list_index_to_loc_table, const maximum_profile_t *profile, size_t offset)
+static int glyf_parse_component(const uint8_t *data, size_t data_size, size_t *offset,
+                                uint16_t *composite_glyph_flags, uint16_t *index_composite_glyph,
+                                float transformation[6], uint8_t *composite_equal)
 {
-    int16_t i;
     int j;
     int ret;
-    float transformation[6];
-    uint16_t index_composite_glyph;
-    uint32_t index_composite_path;
-    uint32_t index_composite_curve;
-    uint16_t composite_glyph_flags;
     int16_t args_i16[2];
     int8_t args_i8[2];
     uint8_t is_word_value;
     int16_t tmp_value;
     uint16_t instructions_size;
-    uint8_t composite_equal;
-    glyph_path_t *tmp;
 
-    for (i=0;i<-list_glyph[index_glyph].num_contours;i++) {
-        while (1) {
-            ret = parse_value_16u(data, data_size, &offset, &composite_glyph_flags);
+    ret = parse_value_16u(data, data_size, offset, composite_glyph_flags);
+    if (ret) {
+        return ret;
+    }
+
+    ret = parse_value_16u(data, data_size, offset, index_composite_glyph);
+    if (ret) {
+        return ret;
+    }
+
+    if (*composite_glyph_flags & ARG_1_AND_2_ARE_WORDS) {
+        for (j=0;j<2;j++) {
+            ret = parse_value_16i(data, data_size, offset, &args_i16[j]);
             if (ret) {
                 return ret;
             }
+        }
+        is_word_value = 1;
 
-            ret = parse_value_16u(data, data_size, &offset, &index_composite_glyph);
+    } else {
+        for (j=0;j<2;j++) {
+            ret = parse_value_8i(data, data_size, offset, &args_i8[j]);
             if (ret) {
                 return ret;
             }
+        }
+        is_word_value = 0;
+    }
 
-            if (composite_glyph_flags & ARG_1_AND_2_ARE_WORDS) {
-                for (j=0;j<2;j++) {
-                    ret = parse_value_16i(data, data_size, &offset, &args_i16[j]);
-                    if (ret) {
-                        return ret;
-                    }
-                }
-                is_word_value = 1;
+    transformation[0] = 1.0f;
+    transformation[1] = 0.0f;
+    transformation[2] = 0.0f;
+    transformation[3] = 1.0f;
+    transformation[4] = 0.0f;
+    transformation[5] = 0.0f;
+    *composite_equal = 1;
 
-            } else {
-                for (j=0;j<2;j++) {
-                    ret = parse_value_8i(data, data_size, &offset, &args_i8[j]);
-                    if (ret) {
-                        return ret;
-                    }
-                }
-                is_word_value = 0;
+    if (*composite_glyph_flags & WE_HAVE_A_SCALE) {
+        ret = parse_value_16i(data, data_size, offset, &tmp_value);
+        if (ret) {
+            return ret;
+        }
+        transformation[0] = f_2_dot_14(tmp_value);
+        transformation[3] = f_2_dot_14(tmp_value);
+        *composite_equal = 0;
+    } else if (*composite_glyph_flags & WE_HAVE_AN_X_AND_Y_SCALE) {
+        ret = parse_value_16i(data, data_size, offset, &tmp_value);
+        if (ret) {
+            return ret;
+        }
+        transformation[0] = f_2_dot_14(tmp_value);
+        ret = parse_value_16i(data, data_size, offset, &tmp_value);
+        if (ret) {
+            return ret;
+        }
+        transformation[3] = f_2_dot_14(tmp_value);
+        *composite_equal = 0;
+    } else if (*composite_glyph_flags & WE_HAVE_A_TWO_BY_TWO) {
+        for (j=0;j<4;j++) {
+            ret = parse_value_16i(data, data_size, offset, &tmp_value);
+            if (ret) {
+                return ret;
             }
+            transformation[j] = f_2_dot_14(tmp_value);
+        }
+        *composite_equal = 0;
+    }
 
-            transformation[0] = 1.0f;
-            transformation[1] = 0.0f;
-            transformation[2] = 0.0f;
-            transformation[3] = 1.0f;
-            transformation[4] = 0.0f;
-            transformation[5] = 0.0f;
-            composite_equal = 1;
+    if (*composite_glyph_flags & ARGS_ARE_XY_VALUES) {
+        *composite_equal = 0;
+        transformation[4] = is_word_value ? args_i16[0] : args_i8[0];
+        transformation[5] = is_word_value ? args_i16[1] : args_i8[1];
+        if (*composite_glyph_flags & SCALED_COMPONENT_OFFSET) {
+            transformation[4] *= transformation[0];
+            transformation[5] *= transformation[3];
+        }
+    }
 
-            if (composite_glyph_flags & WE_HAVE_A_SCALE) {
-                ret = parse_value_16i(data, data_size, &offset, &tmp_value);
-                if (ret) {
-                    return ret;
-                }
-                transformation[0] = f_2_dot_14(tmp_value);
-                transformation[3] = f_2_dot_14(tmp_value);
-                composite_equal = 0;
-            } else if (composite_glyph_flags & WE_HAVE_AN_X_AND_Y_SCALE) {
-                ret = parse_value_16i(data, data_size, &offset, &tmp_value);
+    //Skip instructions
+    if (*composite_glyph_flags & WE_HAVE_INSTRUCTIONS) {
+        instructions_size = 0;
+        ret = parse_value_16u(data, data_size, offset, &instructions_size);
+        if (ret) {
+            return ret;
+        }
+        *offset += instructions_size;
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief glyf_generate_compositive_glyph
+ *
+ * Generates composite glyph such as "ä"
+ * Components are parsed first to get the count of components, and
+ * then the components are added as references to the component glyphs,
+ * so the outline of the component is not copied
+ *
+ * \param data
+ * \param data_size
+ * \param index_glyph
+ * \param list_glyph
+ * \param glyf_offset
+ * \param list_index_to_loc_table
+ * \param profile
+ * \param offset
+ * \param arena glyph data is allocated from here
+ * \return 0 on success
+ */
+static int glyf_generate_compositive_glyph(const uint8_t *data, size_t data_size, uint16_t index_glyph,
+               glyph_t *list_glyph, size_t glyf_offset,
+               index_to_loc_table_t *list_index_to_loc_table, const maximum_profile_t *profile, size_t offset,
+               arena_t *arena)
+{
+    int16_t i;
+    int ret;
+    int copy;
+    float transformation[6];
+    uint16_t index_composite_glyph;
+    uint16_t composite_glyph_flags;
+    uint8_t composite_equal;
+    const size_t components_offset = offset;
+    const glyph_t *composite_glyph;
+    glyph_component_t *component;
+    glyph_outline_t *outline = &list_glyph[index_glyph].outline;
+
+    // components that are being parsed (glyph is component of itself)
+    // are skipped, so they are empty as component
+    list_glyph[index_glyph].parsing = 1;
+
+    // first round parses the components and counts them,
+    // second round adds the references of components
+    for (copy=0;copy<2;copy++) {
+        offset = components_offset;
+        if (copy) {
+            if (!outline->component_count) {
+                break;
+            }
+            outline->list_component = (glyph_component_t *)arena_alloc(arena, sizeof(glyph_component_t)*outline->component_count);
+            if (!outline->list_component) {
+                return ENOMEM;
+            }
+            outline->component_count = 0;
+        }
+
+        for (i=0;i<-list_glyph[index_glyph].num_contours;i++) {
+            while (1) {
+                ret = glyf_parse_component(data, data_size, &offset, &composite_glyph_flags, &index_composite_glyph,
+                                           transformation, &composite_equal);
                 if (ret) {
                     return ret;
                 }
-                transformation[0] = f_2_dot_14(tmp_value);
-                ret = parse_value_16i(data, data_size, &offset, &tmp_value);
-                if (ret) {
-                    return ret;
+                if (index_composite_glyph >= profile->glyphs_count) {
+                    return EIO;
                 }
-                transformation[3] = f_2_dot_14(tmp_value);
-                composite_equal = 0;
-            } else if (composite_glyph_flags & WE_HAVE_A_TWO_BY_TWO) {
-                for (j=0;j<4;j++) {
-                    ret = parse_value_16i(data, data_size, &offset, &tmp_value);
+
+                if (list_glyph[index_composite_glyph].loaded == 0) {
+                    ret = glyf_parse(data, data_size, index_composite_glyph,
+                                   list_glyph, glyf_offset,
+                                   list_index_to_loc_table, profile, arena);
                     if (ret) {
                         return ret;
                     }
-                    transformation[j] = f_2_dot_14(tmp_value);
                 }
-                composite_equal = 0;
-            }
 
-            if (composite_glyph_flags & ARGS_ARE_XY_VALUES) {
-                composite_equal = 0;
-                transformation[4] = is_word_value ? args_i16[0] : args_i8[0];
-                transformation[5] = is_word_value ? args_i16[1] : args_i8[1];
-                if (composite_glyph_flags & SCALED_COMPONENT_OFFSET) {
-                    transformation[4] *= transformation[0];
-                    transformation[5] *= transformation[3];
+                composite_glyph = &list_glyph[index_composite_glyph];
+                if (!composite_glyph->parsing
+                        && (composite_glyph->outline.contour_count || composite_glyph->outline.component_count)) {
+                    if (composite_glyph->outline.component_depth >= GLYF_MAX_COMPONENT_DEPTH
+                            || outline->component_count == 0xFFFF) {
+                        return EIO;
+                    }
+                    if (copy) {
+                        component = &outline->list_component[outline->component_count];
+                        component->glyph_index = index_composite_glyph;
+                        component->glyph = composite_glyph;
+                        memcpy(component->transformation, transformation, sizeof(component->transformation));
+                        component->composite_equal = composite_equal;
+                    }
+                    if (outline->component_depth <= composite_glyph->outline.component_depth) {
+                        outline->component_depth = (uint8_t)(composite_glyph->outline.component_depth + 1);
+                    }
+                    outline->component_count++;
                 }
-            }
 
-            //Skip instructions
-            if (composite_glyph_flags & WE_HAVE_INSTRUCTIONS) {
-                instructions_size = 0;
-                ret = parse_value_16u(data, data_size, &offset, &instructions_size);
-                if (ret) {
-                    return ret;
+                if ((composite_glyph_flags & MORE_COMPONENTS) == 0) {
+                    break;
                 }
-                offset += instructions_size;
             }
+        }
+    }
 
-            if (list_glyph[index_composite_glyph].loaded == 0) {
-                ret = glyf_parse(data, data_size, index_composite_glyph,
-                               list_glyph, glyf_offset,
-                               list_index_to_loc_table, profile);
-                if (ret) {
-                    return ret;
-                }
+    list_glyph[index_glyph].parsing = 0;
+    return 0;
+}
+
+/*!
+ * \brief glyf_parse_flags
+ *
+ * parses the flags of the points, repeated flags are set at once
+ *
+ * \param data
+ * \param data_size
+ * \param list_flags [out] list of flags
+ * \param num_points number of points (or flags)
+ * \param offset
+ * \return 0 == success
+ */
+#ifndef TEST_CASE
+static
+#endif
+int glyf_parse_flags(const uint8_t *data, size_t data_size, uint8_t *list_flags, uint16_t num_points, size_t *offset)
+{
+    uint32_t i = 0;
+    uint32_t count;
+    uint8_t flag;
+
+    while (i < num_points) {
+        if (*offset >= data_size) {
+            return EIO;
+        }
+        flag = data[*offset];
+        *offset += 1;
+        count = 1;
+        if (flag & REPEAT_FLAG) {
+            if (*offset >= data_size) {
+                return EIO;
             }
+            count += data[*offset];
+            *offset += 1;
+        }
+        if (count > num_points - i) {
+            count = num_points - i;
+        }
+        memset(&list_flags[i], flag, count);
+        i += count;
+    }
 
-            for (index_composite_path=0;index_composite_path<list_glyph[index_composite_glyph].list_path_size;index_composite_path++) {
-                list_glyph[index_glyph].list_path_size++;
-                tmp = (glyph_path_t *)realloc(list_glyph[index_glyph].list_path, sizeof(glyph_path_t)*list_glyph[index_glyph].list_path_size );
-                if (!tmp) {
-                    return errno;
-                }
-                list_glyph[index_glyph].list_path = tmp;
+    return 0;
+}
 
-                list_glyph[index_glyph].list_path[ list_glyph[index_glyph].list_path_size - 1 ].list_glyph_curve = (glyph_curve_t *)malloc( sizeof(glyph_curve_t)*list_glyph[index_composite_glyph].list_path[index_composite_path].list_glyph_curve_size);
-                if (!list_glyph[index_glyph].list_path[ list_glyph[index_glyph].list_path_size - 1 ].list_glyph_curve) {
-                    return errno;
-                }
-                list_glyph[index_glyph].list_path[ list_glyph[index_glyph].list_path_size - 1 ].list_glyph_curve_size = list_glyph[index_composite_glyph].list_path[index_composite_path].list_glyph_curve_size;
+/*!
+ * \brief glyf_parse_point_scalar
+ *
+ * parse x or y points one by one, starting from first_point
+ *
+ * \param data
+ * \param data_size
+ * \param listFlags list of flags
+ * \param listPoint list of points (x or y), points before first_point are already parsed
+ * \param first_point index of first point to parse
+ * \param num_points number of points (or flags)
+ * \param offset
+ * \param x 1 == x, 0 == y
+ * \return 0 == success
+ */
+#ifndef TEST_CASE
+static
+#endif
+int glyf_parse_point_scalar(const uint8_t *data, size_t data_size, const uint8_t *listFlags, int16_t *listPoint,
+                            uint16_t first_point, uint16_t num_points, size_t *offset, uint8_t x)
+{
+    int ret;
+    uint32_t i;
+    uint8_t is_same_or_positive_short_vector = x ? X_IS_SAME_OR_POSITIVE_X_SHORT_VECTOR : Y_IS_SAME_OR_POSITIVE_Y_SHORT_VECTOR;
+    uint8_t short_vector = x ? X_SHORT_VECTOR : Y_SHORT_VECTOR;
 
-                if (composite_equal == 0) {
-                    for (index_composite_curve=0;index_composite_curve<list_glyph[index_composite_glyph].list_path[index_composite_path].list_glyph_curve_size;index_composite_curve++) {
-                        glyf_generate_glyph_from_transformation(transformation,
-                                                                &list_glyph[index_composite_glyph].list_path[index_composite_path].list_glyph_curve[index_composite_curve],
-                                                                &list_glyph[index_glyph].list_path[ list_glyph[index_glyph].list_path_size - 1 ].list_glyph_curve[index_composite_curve]);
-                    }
-                } else {
-                    for (index_composite_curve= 0;index_composite_curve<list_glyph[index_composite_glyph].list_path[index_composite_path].list_glyph_curve_size;index_composite_curve++) {
-                        list_glyph[index_glyph].list_path[ list_glyph[index_glyph].list_path_size - 1 ].list_glyph_curve[index_composite_curve] = list_glyph[index_composite_glyph].list_path[index_composite_path].list_glyph_curve[index_composite_curve];
-                    }
+    for (i=first_point;i<num_points;i++) {
+        if (listFlags[i] & is_same_or_positive_short_vector
+                && (listFlags[i] & short_vector) == 0) {
+            if (i > 0) {
+                listPoint[i] = listPoint[i-1];
+            } else {
+                listPoint[i] = 0;
+            }
+        } else {
+            if (listFlags[i] & short_vector) {
+                if (*offset >= data_size) {
+                    return EIO;
+                }
+                listPoint[i] = data[*offset];
+                *offset += 1;
+                if ((listFlags[i] & is_same_or_positive_short_vector) == 0) {
+                    listPoint[i] = (int16_t)(listPoint[i]*-1);
+                }
+            } else {
+                ret = parse_value_16i(data, data_size, offset, &listPoint[i]);
+                if (ret) {
+                    return ret;
                 }
             }
 
-            if ((composite_glyph_flags & MORE_COMPONENTS) == 0) {
-                break;
+            if (i != 0) {
+                listPoint[i] = (int16_t)(listPoint[i-1] + listPoint[i]);
             }
         }
     }
@@ -450,6 +423,149 @@ static int glyf_generate_compositive_glyph(const uint8_t *data, size_t data_size
     return 0;
 }
 
+#ifdef GLYF_PARSE_POINT_SSSE3
+/*!
+ * \brief glyf_parse_point_ssse3
+ *
+ * parse x or y points, 8 points at once
+ * Size of each delta (0, 1 or 2 bytes) is got from the flags, data offsets of
+ * the deltas are the prefix sum of the sizes, deltas are gathered from data
+ * by shuffle and points are the prefix sum of the deltas
+ * Last points (and the points near the end of data) are parsed by
+ * glyf_parse_point_scalar(), so the result is same as with it
+ *
+ * \param data
+ * \param data_size
+ * \param listFlags list of flags
+ * \param listPoint list of points (x or y)
+ * \param num_points number of points (or flags)
+ * \param offset
+ * \param x 1 == x, 0 == y
+ * \return 0 == success
+ */
+#ifndef TEST_CASE
+static
+#endif
+__attribute__((target("ssse3")))
+int glyf_parse_point_ssse3(const uint8_t *data, size_t data_size, const uint8_t *listFlags, int16_t *listPoint,
+                           uint16_t num_points, size_t *offset, uint8_t x)
+{
+    uint16_t i = 0;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i two = _mm_set1_epi16(2);
+    const __m128i is_same_or_positive_short_vector = _mm_set1_epi16(x ? X_IS_SAME_OR_POSITIVE_X_SHORT_VECTOR : Y_IS_SAME_OR_POSITIVE_Y_SHORT_VECTOR);
+    const __m128i short_vector = _mm_set1_epi16(x ? X_SHORT_VECTOR : Y_SHORT_VECTOR);
+    const __m128i no_byte = _mm_set1_epi16(0x80);
+    __m128i flags, is_short, is_same, size, data_offset, low_index, high_index, negate, delta;
+    __m128i previous = zero;
+
+    // 8 points use 16 bytes of data at most
+    while (i + 8 <= num_points && *offset + 16 <= data_size) {
+        flags = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(const void *)(listFlags + i)), zero);
+        is_short = _mm_cmpeq_epi16(_mm_and_si128(flags, short_vector), short_vector);
+        is_same = _mm_cmpeq_epi16(_mm_and_si128(flags, is_same_or_positive_short_vector), is_same_or_positive_short_vector);
+
+        // size: short vector == 1, same == 0, else 2
+        size = _mm_or_si128(_mm_and_si128(is_short, one), _mm_andnot_si128(_mm_or_si128(is_short, is_same), two));
+
+        // offsets of the deltas in 16 bytes of data (exclusive prefix sum of sizes)
+        data_offset = _mm_add_epi16(size, _mm_slli_si128(size, 2));
+        data_offset = _mm_add_epi16(data_offset, _mm_slli_si128(data_offset, 4));
+        data_offset = _mm_add_epi16(data_offset, _mm_slli_si128(data_offset, 8));
+        data_offset = _mm_sub_epi16(data_offset, size);
+
+        // 16 bit delta is big endian, 8 bit delta is the low byte
+        low_index = _mm_sub_epi16(data_offset, _mm_cmpeq_epi16(size, two));
+        low_index = _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi16(size, zero), low_index),
+                                 _mm_andnot_si128(_mm_cmpgt_epi16(size, zero), no_byte));
+        high_index = _mm_or_si128(_mm_and_si128(_mm_cmpeq_epi16(size, two), data_offset),
+                                  _mm_andnot_si128(_mm_cmpeq_epi16(size, two), no_byte));
+        delta = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(const void *)(data + *offset)),
+                                 _mm_or_si128(low_index, _mm_slli_epi16(high_index, 8)));
+
+        // negative 8 bit delta
+        negate = _mm_andnot_si128(is_same, is_short);
+        delta = _mm_sub_epi16(_mm_xor_si128(delta, negate), negate);
+
+        // points are prefix sum of deltas
+        delta = _mm_add_epi16(delta, _mm_slli_si128(delta, 2));
+        delta = _mm_add_epi16(delta, _mm_slli_si128(delta, 4));
+        delta = _mm_add_epi16(delta, _mm_slli_si128(delta, 8));
+        delta = _mm_add_epi16(delta, previous);
+        _mm_storeu_si128((__m128i *)(void *)(listPoint + i), delta);
+        previous = _mm_shufflehi_epi16(_mm_unpackhi_epi64(delta, delta), 0xFF);
+        previous = _mm_unpackhi_epi64(previous, previous);
+
+        *offset += (size_t)(uint16_t)_mm_extract_epi16(_mm_add_epi16(data_offset, size), 7);
+        i = (uint16_t)(i + 8);
+    }
+
+    return glyf_parse_point_scalar(data, data_size, listFlags, listPoint, i, num_points, offset, x);
+}
+#endif
+
+/*!
+ * \brief glyf_parse_header
+ *
+ * parses the number of contours and the bounding box of the glyph
+ *
+ * \param data
+ * \param data_size
+ * \param glyph [out] num_contours, min_x, min_y, max_x and max_y are set
+ * \param offset [in/out] offset of the glyph, moved after the header
+ * \return 0 on success
+ */
+static int glyf_parse_header(const uint8_t *data, size_t data_size, glyph_t *glyph, size_t *offset)
+{
+    int ret;
+
+    ret = parse_value_16i(data, data_size, offset, &glyph->num_contours);
+    if (ret) {
+        return ret;
+    }
+
+    ret = parse_value_16i(data, data_size, offset, &glyph->min_x);
+    if (ret) {
+        return ret;
+    }
+
+    ret = parse_value_16i(data, data_size, offset, &glyph->min_y);
+    if (ret) {
+        return ret;
+    }
+
+    ret = parse_value_16i(data, data_size, offset, &glyph->max_x);
+    if (ret) {
+        return ret;
+    }
+
+    return parse_value_16i(data, data_size, offset, &glyph->max_y);
+}
+
+/*!
+ * \brief glyf_parse_bounding_box
+ *
+ * parses only the header of the glyph, the outline is not parsed
+ * This can be used to get the size of the glyph before glyf_parse()
+ *
+ * \param data
+ * \param data_size
+ * \param index_glyph this is index of glyph on the table
+ * \param glyf_offset
+ * \param list_index_to_loc_table
+ * \param glyph [out] glyph_index, num_contours and bounding box are set, glyph is not loaded
+ * \return 0 on success
+ */
+int glyf_parse_bounding_box(const uint8_t *data, size_t data_size, uint16_t index_glyph, size_t glyf_offset,
+                            const index_to_loc_table_t *list_index_to_loc_table, glyph_t *glyph)
+{
+    size_t offset = glyf_offset + (size_t)list_index_to_loc_table[index_glyph].offset;
+
+    glyph->glyph_index = index_glyph;
+    return glyf_parse_header(data, data_size, glyph, &offset);
+}
+
 /*!
  * \brief glyf_parse
  *
@@ -462,15 +578,19 @@ static int glyf_generate_compositive_glyph(const uint8_t *data, size_t data_size
  * \param glyf_offset
  * \param list_index_to_loc_table
  * \param profile
+ * \param arena glyph data is allocated from here, released by glyf_clear()
  * \return
  */
 int glyf_parse(const uint8_t *data, size_t data_size, uint16_t index_glyph,
                glyph_t *list_glyph, size_t glyf_offset,
-               index_to_loc_table_t *list_index_to_loc_table, const maximum_profile_t *profile) {
+               index_to_loc_table_t *list_index_to_loc_table, const maximum_profile_t *profile,
+               arena_t *arena) {
     int ret;
     int16_t i;
     uint16_t num_points;
-    uint8_t repeat;
+    uint8_t *list_flags;
+    int16_t *list_point_x;
+    int16_t *list_point_y;
 
     if (list_glyph[index_glyph].loaded) {
         return 0;
@@ -479,32 +599,11 @@ int glyf_parse(const uint8_t *data, size_t data_size, uint16_t index_glyph,
     glyph_t *glyph = &list_glyph[index_glyph];
     glyph->glyph_index = index_glyph;
 
-    glyph->list_path = NULL;
-    glyph->list_path_size = 0;
+    memset(&glyph->outline, 0, sizeof(glyph->outline));
 
     size_t offset = glyf_offset + (size_t)list_index_to_loc_table[index_glyph].offset;
 
-    ret = parse_value_16i(data, data_size, &offset, &glyph->num_contours);
-    if (ret) {
-        return ret;
-    }
-
-    ret = parse_value_16i(data, data_size, &offset, &glyph->min_x);
-    if (ret) {
-        return ret;
-    }
-
-    ret = parse_value_16i(data, data_size, &offset, &glyph->min_y);
-    if (ret) {
-        return ret;
-    }
-
-    ret = parse_value_16i(data, data_size, &offset, &glyph->max_x);
-    if (ret) {
-        return ret;
-    }
-
-    ret = parse_value_16i(data, data_size, &offset, &glyph->max_y);
+    ret = glyf_parse_header(data, data_size, glyph, &offset);
     if (ret) {
         return ret;
     }
@@ -513,18 +612,18 @@ int glyf_parse(const uint8_t *data, size_t data_size, uint16_t index_glyph,
 
     if (glyph->num_contours > 0) {
         const uint16_t u_num_contours = (uint16_t)glyph->num_contours;
-        glyph->max_num_end_contours = 0;
-        glyph->list_end_points_contours = (uint16_t *)malloc((uint32_t)(sizeof(uint16_t)*u_num_contours));
-        if (!glyph->list_end_points_contours) {
-            return errno;
+        uint16_t *list_end_points = (uint16_t *)arena_alloc(arena, sizeof(uint16_t)*u_num_contours);
+        if (!list_end_points) {
+            return ENOMEM;
         }
+        // points of the contour are after the end point of previous contour
         for (i=0;i<glyph->num_contours;i++) {
-            ret = parse_value_16u(data, data_size, &offset, &glyph->list_end_points_contours[i]);
+            ret = parse_value_16u(data, data_size, &offset, &list_end_points[i]);
             if (ret) {
                 return ret;
             }
-            if (glyph->max_num_end_contours < glyph->list_end_points_contours[i]) {
-                glyph->max_num_end_contours = glyph->list_end_points_contours[i];
+            if ((i && list_end_points[i] <= list_end_points[i-1]) || list_end_points[i] == 0xFFFF) {
+                return EIO;
             }
         }
 
@@ -538,55 +637,45 @@ int glyf_parse(const uint8_t *data, size_t data_size, uint16_t index_glyph,
                 return EIO;
             }
 
-            glyph->list_instructions = (uint8_t *)malloc(sizeof(uint8_t)*glyph->instruction_size);
+            glyph->list_instructions = (uint8_t *)arena_alloc(arena, sizeof(uint8_t)*glyph->instruction_size);
             if (!glyph->list_instructions) {
-                return errno;
+                return ENOMEM;
             }
             memcpy(glyph->list_instructions, data+offset, glyph->instruction_size);
             offset += glyph->instruction_size;
         }
 
-        num_points = (uint16_t)(glyph->max_num_end_contours + 1);
-        repeat = 0;
+        num_points = (uint16_t)(list_end_points[u_num_contours-1] + 1);
 
-        glyph->list_flags = (uint8_t *)malloc(sizeof(uint8_t)*num_points);
-        if (!glyph->list_flags) {
-            return errno;
-        }
-        glyph->list_point_x = (int16_t *)malloc(sizeof(int16_t)*num_points);
-        if (!glyph->list_point_x) {
-            return errno;
-        }
-        glyph->list_point_y = (int16_t *)malloc(sizeof(int16_t)*num_points);
-        if (!glyph->list_point_y) {
-            return errno;
+        list_flags = (uint8_t *)arena_alloc(arena, sizeof(uint8_t)*num_points);
+        list_point_x = (int16_t *)arena_alloc(arena, sizeof(int16_t)*num_points);
+        list_point_y = (int16_t *)arena_alloc(arena, sizeof(int16_t)*num_points);
+        if (!list_flags || !list_point_x || !list_point_y) {
+            return ENOMEM;
         }
 
-        for (i=0;i<num_points;i++) {
-            if (repeat == 0) {
-                glyph->list_flags[i] = data[offset];
-                offset++;
-                if (glyph->list_flags[i] & REPEAT_FLAG) {
-                    repeat = data[offset];
-                    offset++;
-                }
-            } else {
-                glyph->list_flags[i] = glyph->list_flags[i-1];
-                repeat--;
-            }
+        ret = glyf_parse_flags(data, data_size, list_flags, num_points, &offset);
+        if (ret) {
+            return ret;
         }
 
-        ret = glyf_parse_point(data, data_size, glyph->list_flags, glyph->list_point_x, num_points, &offset, 1);
+        ret = glyf_parse_point(data, data_size, list_flags, list_point_x, num_points, &offset, 1);
         if (ret) {
             return ret;
         }
 
-        ret = glyf_parse_point(data, data_size, glyph->list_flags, glyph->list_point_y, num_points, &offset, 0);
+        ret = glyf_parse_point(data, data_size, list_flags, list_point_y, num_points, &offset, 0);
         if (ret) {
             return ret;
         }
 
-        return glyf_generate_contours(glyph);
+        glyph->outline.list_point_x = list_point_x;
+        glyph->outline.list_point_y = list_point_y;
+        glyph->outline.list_flags = list_flags;
+        glyph->outline.list_end_points = list_end_points;
+        glyph->outline.point_count = num_points;
+        glyph->outline.contour_count = u_num_contours;
+        return 0;
     }
 
     // number of contours is negative (or 0), this means
@@ -594,13 +683,14 @@ int glyf_parse(const uint8_t *data, size_t data_size, uint16_t index_glyph,
     // which contains a and two dots
     return glyf_generate_compositive_glyph(data, data_size, index_glyph,
                                            list_glyph, glyf_offset,
-                                           list_index_to_loc_table, profile, offset);
+                                           list_index_to_loc_table, profile, offset, arena);
 }
 
 /*!
  * \brief glyf_parse_point
  *
  * parse x or y point?
+ * SSSE3 is used if the processor supports it
  *
  * \param data
  * \param data_size
@@ -613,43 +703,12 @@ int glyf_parse(const uint8_t *data, size_t data_size, uint16_t index_glyph,
  */
 int glyf_parse_point(const uint8_t *data, size_t data_size, uint8_t *listFlags, int16_t *listPoint, uint16_t num_points, size_t *offset, uint8_t x)
 {
-    int ret;
-    int16_t i;
-    uint8_t is_same_or_positive_short_vector = x ? X_IS_SAME_OR_POSITIVE_X_SHORT_VECTOR : Y_IS_SAME_OR_POSITIVE_Y_SHORT_VECTOR;
-    uint8_t short_vector = x ? X_SHORT_VECTOR : Y_SHORT_VECTOR;
-
-    for (i=0;i<num_points;i++) {
-        if (listFlags[i] & is_same_or_positive_short_vector
-                && (listFlags[i] & short_vector) == 0) {
-            if (i > 0) {
-                listPoint[i] = listPoint[i-1];
-            } else {
-                listPoint[i] = 0;
-            }
-        } else {
-            if (listFlags[i] & short_vector) {
-                if (*offset >= data_size) {
-                    return EIO;
-                }
-                listPoint[i] = data[*offset];
-                *offset += 1;
-                if ((listFlags[i] & is_same_or_positive_short_vector) == 0) {
-                    listPoint[i] = (int16_t)(listPoint[i]*-1);
-                }
-            } else {
-                ret = parse_value_16i(data, data_size, offset, &listPoint[i]);
-                if (ret) {
-                    return ret;
-                }
-            }
-
-            if (i != 0) {
-                listPoint[i] = (int16_t)(listPoint[i-1] + listPoint[i]);
-            }
-        }
+#ifdef GLYF_PARSE_POINT_SSSE3
+    if (__builtin_cpu_supports("ssse3")) {
+        return glyf_parse_point_ssse3(data, data_size, listFlags, listPoint, num_points, offset, x);
     }
-
-    return 0;
+#endif
+    return glyf_parse_point_scalar(data, data_size, listFlags, listPoint, 0, num_points, offset, x);
 }
 
 /*!
@@ -674,40 +733,207 @@ int glyf_alloc(glyph_t **list_glyph, const maximum_profile_t *profile)
 /*!
  * \brief glyf_clear
  *
- * clears the list of glyphs
+ * clears the list of glyphs, the data of glyphs
+ * is released at once by clearing the arena
  *
  * \param list_glyph
- * \param profile is required for glyphs_count
+ * \param arena arena of glyf_parse()
  */
-void glyf_clear(glyph_t **list_glyph, const maximum_profile_t *profile)
+void glyf_clear(glyph_t **list_glyph, arena_t *arena)
 {
-    uint16_t i;
-    size_t i2;
-    if (*list_glyph) {
-        for (i=0;i<profile->glyphs_count;i++) {
-            if ((*list_glyph)[i].list_end_points_contours) {
-                free((*list_glyph)[i].list_end_points_contours);
-            }
+    free(*list_glyph);
+    *list_glyph = NULL;
+    arena_clear(arena);
+}
 
-            if ((*list_glyph)[i].list_instructions) {
-                free((*list_glyph)[i].list_instructions);
-            }
-            if ((*list_glyph)[i].list_flags) {
-                free((*list_glyph)[i].list_flags);
-            }
-            if ((*list_glyph)[i].list_point_x) {
-                free((*list_glyph)[i].list_point_x);
-            }
-            if ((*list_glyph)[i].list_point_y) {
-                free((*list_glyph)[i].list_point_y);
-            }
+/*!
+ * \brief glyf_outline_iterator_init
+ *
+ * initializes the iterator to the first curve of the outline
+ *
+ * \param iterator
+ * \param outline outline to iterate, outline and its components must be valid while iterating
+ */
+void glyf_outline_iterator_init(glyf_outline_iterator_t *iterator, const glyph_outline_t *outline)
+{
+    iterator->list_outline[0] = outline;
+    iterator->list_component[0] = 0;
+    iterator->depth = 0;
+    iterator->contour = 0;
+    iterator->index_contour = 0;
+    iterator->prev_point_x = 0;
+    iterator->prev_point_y = 0;
+}
 
-            for (i2=0;i2<(*list_glyph)[i].list_path_size;i2++) {
-                free((*list_glyph)[i].list_path[i2].list_glyph_curve);
+/*!
+ * \brief glyf_outline_iterator_next_contour
+ *
+ * moves the iterator into the outline that has next contour,
+ * components of composite glyph are iterated in order
+ *
+ * \param iterator
+ * \return outline of next contour, NULL if there are no more contours
+ */
+static const glyph_outline_t *glyf_outline_iterator_next_contour(glyf_outline_iterator_t *iterator)
+{
+    const glyph_outline_t *outline;
+
+    while (1) {
+        outline = iterator->list_outline[iterator->depth];
+        if (outline->component_count == 0) {
+            if (iterator->contour < outline->contour_count) {
+                return outline;
             }
-            free((*list_glyph)[i].list_path);
+        } else if (iterator->list_component[iterator->depth] < outline->component_count
+                   && iterator->depth < GLYF_MAX_COMPONENT_DEPTH) {
+            iterator->list_outline[iterator->depth+1] = &outline->list_component[iterator->list_component[iterator->depth]].glyph->outline;
+            iterator->depth++;
+            iterator->list_component[iterator->depth] = 0;
+            iterator->contour = 0;
+            iterator->index_contour = 0;
+            continue;
+        }
+
+        // outline is ready, continue from next component of parent
+        if (iterator->depth == 0) {
+            return NULL;
         }
-        free(*list_glyph);
-        *list_glyph = NULL;
+        iterator->depth--;
+        iterator->list_component[iterator->depth]++;
     }
 }
+
+/*!
+ * \brief glyf_outline_iterator_next
+ *
+ * Generates next line or curve of the outline, each point
+ * of the contour generates one curve, transformations of
+ * components are applied into the generated curve
+ *
+ * \param iterator
+ * \param curve [out] next line or curve
+ * \return 1 if curve was generated, 0 if there are no more curves
+ */
+int glyf_outline_iterator_next(glyf_outline_iterator_t *iterator, glyph_curve_t *curve)
+{
+    uint8_t depth;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+    uint16_t point_index0;
+    uint16_t point_index1;
+    uint16_t point_index2;
+    uint16_t point_index_last;
+    uint16_t point_index_0;
+    uint16_t num_points_per_contour;
+    uint8_t is_curve0;
+    uint8_t is_curve1;
+    glyph_curve_t tmp;
+    const glyph_component_t *component;
+    const glyph_outline_t *outline = glyf_outline_iterator_next_contour(iterator);
+
+    if (!outline) {
+        return 0;
+    }
+
+    // points of the contour are after the end point of previous contour
+    point_index_0 = iterator->contour ? (uint16_t)(outline->list_end_points[iterator->contour-1] + 1) : 0;
+    point_index_last = outline->list_end_points[iterator->contour];
+    num_points_per_contour = (uint16_t)(point_index_last - point_index_0 + 1);
+
+    //If the first point is off curve
+    if (iterator->index_contour == 0 && glyf_is_off_curve(outline->list_flags[point_index_0])) {
+        if (glyf_is_off_curve(outline->list_flags[point_index_last])) {
+            iterator->prev_point_x = (float)(outline->list_point_x[point_index_0]+outline->list_point_x[point_index_last])/2.0f;
+            iterator->prev_point_y = (float)(outline->list_point_y[point_index_0]+outline->list_point_y[point_index_last])/2.0f;
+        }
+        else {
+            iterator->prev_point_x = (float)outline->list_point_x[point_index_last];
+            iterator->prev_point_y = (float)outline->list_point_y[point_index_last];
+        }
+    }
+
+    point_index0 = (uint16_t)(point_index_0 + iterator->index_contour % num_points_per_contour);
+    point_index1 = (uint16_t)(point_index_0 + (iterator->index_contour + 1) % num_points_per_contour);
+
+    is_curve0 = glyf_is_off_curve(outline->list_flags[point_index0]);
+    is_curve1 = glyf_is_off_curve(outline->list_flags[point_index1]);
+
+    curve->is_curve = (is_curve0 || is_curve1);
+    curve->is_repeated = 0;
+
+    x0 = outline->list_point_x[point_index0];
+    y0 = outline->list_point_y[point_index0];
+    x1 = outline->list_point_x[point_index1];
+    y1 = outline->list_point_y[point_index1];
+
+    if (is_curve0) {
+        curve->x0 = iterator->prev_point_x;
+        curve->y0 = iterator->prev_point_y;
+        curve->curve_x = x0;
+        curve->curve_y = y0;
+
+        if (is_curve1) {
+            curve->x1 = (float)(x0 + x1)/2.0f;
+            curve->y1 = (float)(y0 + y1)/2.0f;
+            iterator->prev_point_x = curve->x1;
+            iterator->prev_point_y = curve->y1;
+            // on-curve point before this point generated the curve to the middle point
+            point_index2 = (uint16_t)(point_index_0 + (iterator->index_contour + num_points_per_contour - 1) % num_points_per_contour);
+            curve->is_repeated = !glyf_is_off_curve(outline->list_flags[point_index2]);
+        } else {
+            curve->x1 = x1;
+            curve->y1 = y1;
+            // on-curve point before this point generated the same curve
+            point_index2 = (uint16_t)(point_index_0 + (iterator->index_contour + num_points_per_contour - 1) % num_points_per_contour);
+            curve->is_repeated = !glyf_is_off_curve(outline->list_flags[point_index2]);
+        }
+    }  else if (is_curve1) {
+        point_index2 = (uint16_t)(point_index_0 + (iterator->index_contour + 2) % num_points_per_contour);
+
+        curve->x0 = x0;
+        curve->y0 = y0;
+        curve->curve_x = x1;
+        curve->curve_y = y1;
+        if (glyf_is_off_curve(outline->list_flags[point_index2])) {
+            curve->x1 = (float)(x1 + outline->list_point_x[point_index2])/2.0f;
+            curve->y1 = (float)(y1 + outline->list_point_y[point_index2])/2.0f;
+            iterator->prev_point_x = curve->x1;
+            iterator->prev_point_y = curve->y1;
+        } else {
+            curve->x1 = outline->list_point_x[point_index2];
+            curve->y1 = outline->list_point_y[point_index2];
+            iterator->prev_point_x = x0;
+            iterator->prev_point_y = y0;
+        }
+    } else {
+        curve->x0 = x0;
+        curve->y0 = y0;
+        curve->x1 = x1;
+        curve->y1 = y1;
+        // it's line, curve points are ignored
+        curve->curve_x = 0;
+        curve->curve_y = 0;
+
+        iterator->prev_point_x = x0;
+        iterator->prev_point_y = y0;
+    }
+
+    // transformation of the innermost component is applied first
+    for (depth=iterator->depth;depth>0;depth--) {
+        component = &iterator->list_outline[depth-1]->list_component[iterator->list_component[depth-1]];
+        if (component->composite_equal == 0) {
+            tmp = *curve;
+            glyf_generate_glyph_from_transformation(component->transformation, &tmp, curve);
+        }
+    }
+
+    iterator->index_contour++;
+    if (iterator->index_contour >= num_points_per_contour) {
+        iterator->index_contour = 0;
+        iterator->contour++;
+    }
+
+    return 1;
+}
@@ -17,52 +17,92 @@
 #include <stddef.h>
 #include "loca.h"
 #include "maxp.h"
+#include "../arena.h"
 
 /*!
  * \brief The glyph_curve_t struct
  *
- * Lines and curves of the glyph "line"
+ * Line or curve of the glyph, these are generated
+ * from the outline by glyf_outline_iterator_next()
  */
 typedef struct {
     float x0, y0;
     float x1, y1;
     float curve_x, curve_y; // curve points, only used when is_curve == 1
     uint8_t is_curve : 1;
+    uint8_t is_repeated : 1;    // same curve was generated by the previous point, so the
+                                // curves form closed contours only if this is skipped
 } glyph_curve_t;
 
+#define GLYF_MAX_COMPONENT_DEPTH    8
+
+struct glyph;
+
 /*!
- * \brief The glyph_path_t struct
+ * \brief The glyph_component_t struct
  *
- * paths of the curves and lines
+ * component of composite glyph, outline of the component glyph
+ * is not copied but it's transformed while it's drawn
  */
 typedef struct {
-    glyph_curve_t *list_glyph_curve;
-    uint32_t list_glyph_curve_size;
-} glyph_path_t;
+    uint16_t glyph_index;
+    const struct glyph *glyph;  // parsed (or cached) component glyph
+    float transformation[6];
+    uint8_t composite_equal;    // 1 if the component is not transformed
+} glyph_component_t;
 
 /*!
- * \brief The glyph_t struct
+ * \brief The glyph_outline_t struct
  *
- * glyph struct, this contains all
+ * Outline of the glyph as TrueType points in font units, the points
+ * of contour i are from list_end_points[i-1]+1 to list_end_points[i]
+ * Composite glyph has no points, it has only the list of components
+ */
+typedef struct {
+    int16_t *list_point_x;          // list size = point_count
+    int16_t *list_point_y;          // list size = point_count
+    uint8_t *list_flags;            // list size = point_count, ON_CURVE_POINT is used
+    uint16_t *list_end_points;      // list size = contour_count
+    uint32_t point_count;
+    uint16_t contour_count;
+    glyph_component_t *list_component;  // list size = component_count
+    uint16_t component_count;
+    uint8_t component_depth;        // 0 == simple glyph, max GLYF_MAX_COMPONENT_DEPTH
+} glyph_outline_t;
+
+/*!
+ * \brief The glyf_outline_iterator_t struct
  *
+ * generates the lines and curves of the outline,
+ * components of composite glyphs are walked as a stack
  */
 typedef struct {
+    const glyph_outline_t *list_outline[GLYF_MAX_COMPONENT_DEPTH+1];    // list_outline[0] is the iterated outline
+    uint16_t list_component[GLYF_MAX_COMPONENT_DEPTH+1];    // current component of list_outline
+    uint8_t depth;
+    uint16_t contour;
+    uint16_t index_contour;
+    float prev_point_x, prev_point_y;
+} glyf_outline_iterator_t;
+
+/*!
+ * \brief The glyph_t struct
+ *
+ * glyph struct, this contains all
+ * the lists are allocated from the arena of glyf_parse()
+ */
+typedef struct glyph {
     uint16_t glyph_index;
-    glyph_path_t *list_path;
-    uint32_t list_path_size;
     int16_t min_x;
     int16_t min_y;
     int16_t max_x;
     int16_t max_y;
     int16_t num_contours;
-    uint16_t *list_end_points_contours;   // list size = num_contours
-    uint16_t max_num_end_contours;    // biggest number of list_end_points_contours
     uint16_t instruction_size;
     uint8_t *list_instructions;
-    uint8_t  *list_flags;   // list size = glyph.max_num_end_contours + 1
-    int16_t *list_point_x;  // list size = glyph.max_num_end_contours + 1
-    int16_t *list_point_y;  // list size = glyph.max_num_end_contours + 1
+    glyph_outline_t outline;
     uint8_t loaded : 1;
+    uint8_t parsing : 1;    // components of the glyph are being parsed
 } glyph_t;
 
 /*!
@@ -92,8 +132,13 @@ typedef struct {
 
 int glyf_parse(const uint8_t *data, size_t data_size, uint16_t index_glyph,
                glyph_t *list_glyph, size_t glyf_offset,
-               index_to_loc_table_t *list_index_to_loc_table, const maximum_profile_t *profile);
+               index_to_loc_table_t *list_index_to_loc_table, const maximum_profile_t *profile,
+               arena_t *arena);
+int glyf_parse_bounding_box(const uint8_t *data, size_t data_size, uint16_t index_glyph, size_t glyf_offset,
+                            const index_to_loc_table_t *list_index_to_loc_table, glyph_t *glyph);
 int glyf_alloc(glyph_t **list_glyph, const maximum_profile_t *profile);
-void glyf_clear(glyph_t **list_glyph, const maximum_profile_t *profile);
+void glyf_clear(glyph_t **list_glyph, arena_t *arena);
+void glyf_outline_iterator_init(glyf_outline_iterator_t *iterator, const glyph_outline_t *outline);
+int glyf_outline_iterator_next(glyf_outline_iterator_t *iterator, glyph_curve_t *curve);
 
 #endif // GLYF_H
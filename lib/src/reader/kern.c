@@ -13,28 +13,106 @@
 #include "kern.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include "glyf.h"
 #include "parse_value.h"
+#include "../arena.h"
 
-static int kern_add_kerning(prj_ttf_reader_data_t *image_data, uint32_t left_character, uint32_t right_character, float kerning);
+/*!
+ * \brief The kern_pairs_t struct
+ *
+ * kerning pairs are walked twice, first round counts the pairs
+ * of each left character and second round adds the pairs into
+ * the lists, that are allocated with exact sizes
+ */
+typedef struct {
+    uint32_t *list_left_index;          // index in list_kerning_left_character of each glyph character, UINT32_MAX if not set
+    uint32_t *list_right_count;         // count of right characters to add for each left character
+    uint32_t *list_new_left_character;  // left characters that are not in image_data before this kern_parse
+    uint32_t left_count;                // count of left characters after this kern_parse
+} kern_pairs_t;
 
 /*!
- * \brief kern_parse
+ * \brief kern_get_left_index
+ *
+ * get index of the left character in list_kerning_left_character,
+ * new left character gets the next index
+ *
+ * \param image_data
+ * \param pairs
+ * \param left_character
+ * \return index of the left character
+ */
+static uint32_t kern_get_left_index(const prj_ttf_reader_data_t *image_data, kern_pairs_t *pairs, uint32_t left_character)
+{
+    uint32_t i_left;
+    const uint32_t old_count = image_data->list_kerning_left_character_count;
+
+    for (i_left=0;i_left<old_count;i_left++) {
+        if (image_data->list_kerning_left_character[i_left].left_character == left_character) {
+            return i_left;
+        }
+    }
+    for (i_left=old_count;i_left<pairs->left_count;i_left++) {
+        if (pairs->list_new_left_character[i_left-old_count] == left_character) {
+            return i_left;
+        }
+    }
+    pairs->list_new_left_character[pairs->left_count-old_count] = left_character;
+    return pairs->left_count++;
+}
+
+/*!
+ * \brief kern_find_glyph
+ *
+ * \param list_glyph_character characters sorted by glyph index
+ * \param list_glyph_character_count
+ * \param glyph_index
+ * \return index of the first character of the glyph, list_glyph_character_count if not found
+ */
+static uint32_t kern_find_glyph(const glyph_character_t *list_glyph_character, uint32_t list_glyph_character_count,
+                                uint16_t glyph_index)
+{
+    uint32_t first = 0;
+    uint32_t last = list_glyph_character_count;
+    uint32_t middle;
+
+    while (first < last) {
+        middle = first + (last - first)/2;
+        if (list_glyph_character[middle].glyph_index < glyph_index) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    if (first < list_glyph_character_count && list_glyph_character[first].glyph_index == glyph_index) {
+        return first;
+    }
+    return list_glyph_character_count;
+}
+
+/*!
+ * \brief kern_walk_pairs
  *
  * https://docs.microsoft.com/en-us/typography/opentype/spec/kern
+ * walks the kerning pairs of the characters
  *
  * \param data
  * \param data_size
  * \param offset
  * \param image_data
  * \param rate
- * \param corr_character_table
- * \return
+ * \param list_glyph_character generated characters sorted by glyph index
+ * \param list_glyph_character_count size of list_glyph_character
+ * \param pairs [in/out]
+ * \param add 0 counts the pairs, 1 adds the pairs into image_data
+ * \return 0 on success
  */
-int kern_parse(const uint8_t *data, size_t data_size, size_t offset,
-               prj_ttf_reader_data_t *image_data, float rate,
-               character_table_t *corr_character_table)
+static int kern_walk_pairs(const uint8_t *data, size_t data_size, size_t offset,
+                           prj_ttf_reader_data_t *image_data, float rate,
+                           const glyph_character_t *list_glyph_character, uint32_t list_glyph_character_count,
+                           kern_pairs_t *pairs, int add)
 {
     int ret;
     uint16_t version;
@@ -50,6 +128,9 @@ int kern_parse(const uint8_t *data, size_t data_size, size_t offset,
     uint16_t kern_pair_left;
     uint16_t kern_pair_right;
     int16_t kern_pair_value;
+    uint32_t i_left;
+    uint32_t i_glyph_left, i_glyph_right, i_first_right;
+    prj_ttf_reader_kerning_left_character_t *left_character;
 
     ret = parse_value_16u(data, data_size, &offset, &version);
     if (ret) {
@@ -111,14 +192,34 @@ int kern_parse(const uint8_t *data, size_t data_size, size_t offset,
                 return ret;
             }
 
-            if (corr_character_table->character[kern_pair_right]
-                    && corr_character_table->character[kern_pair_left]
-                    && kern_pair_value) {
-                ret = kern_add_kerning(image_data, corr_character_table->character[kern_pair_left],
-                                       corr_character_table->character[kern_pair_right],
-                                       rate*(float)kern_pair_value);
-                if (ret) {
-                    return ret;
+            if (!kern_pair_value) {
+                continue;
+            }
+            i_glyph_left = kern_find_glyph(list_glyph_character, list_glyph_character_count, kern_pair_left);
+            i_first_right = kern_find_glyph(list_glyph_character, list_glyph_character_count, kern_pair_right);
+            if (i_glyph_left == list_glyph_character_count || i_first_right == list_glyph_character_count) {
+                continue;
+            }
+
+            // the glyph can be the glyph of many characters
+            for (;i_glyph_left<list_glyph_character_count
+                 && list_glyph_character[i_glyph_left].glyph_index == kern_pair_left;i_glyph_left++) {
+                if (pairs->list_left_index[i_glyph_left] == UINT32_MAX) {
+                    pairs->list_left_index[i_glyph_left] = kern_get_left_index(image_data, pairs,
+                                                                               list_glyph_character[i_glyph_left].character);
+                }
+                i_left = pairs->list_left_index[i_glyph_left];
+
+                for (i_glyph_right=i_first_right;i_glyph_right<list_glyph_character_count
+                     && list_glyph_character[i_glyph_right].glyph_index == kern_pair_right;i_glyph_right++) {
+                    if (!add) {
+                        pairs->list_right_count[i_left]++;
+                        continue;
+                    }
+                    left_character = &image_data->list_kerning_left_character[i_left];
+                    left_character->list_right_character[left_character->list_right_character_count].right_character = list_glyph_character[i_glyph_right].character;
+                    left_character->list_right_character[left_character->list_right_character_count].kerning = rate*(float)kern_pair_value;
+                    left_character->list_right_character_count++;
                 }
             }
         }
@@ -128,62 +229,171 @@ int kern_parse(const uint8_t *data, size_t data_size, size_t offset,
 }
 
 /*!
- * \brief kern_add_kerning_right
+ * \brief kern_parse
  *
- * add right characters into left_character list
+ * https://docs.microsoft.com/en-us/typography/opentype/spec/kern
+ * Kerning pairs of the generated characters are added into image_data,
+ * the lists of image_data are allocated once with the exact sizes
  *
- * \param left_character
- * \param right_character
- * \param kerning
+ * \param data
+ * \param data_size
+ * \param offset
+ * \param image_data
+ * \param rate
+ * \param list_glyph_character generated characters sorted by glyph index
+ * (see font_generate_t), the same glyph can have many characters
+ * \param list_glyph_character_count size of list_glyph_character
  * \return 0 on success
  */
-static int kern_add_kerning_right(prj_ttf_reader_kerning_left_character_t *left_character, uint32_t right_character, float kerning)
+int kern_parse(const uint8_t *data, size_t data_size, size_t offset,
+               prj_ttf_reader_data_t *image_data, float rate,
+               const glyph_character_t *list_glyph_character, uint32_t list_glyph_character_count)
 {
-    prj_ttf_reader_kerning_right_character_t *tmp;
-    tmp = (prj_ttf_reader_kerning_right_character_t *)realloc(left_character->list_right_character,
-                                                              sizeof(prj_ttf_reader_kerning_right_character_t)*(left_character->list_right_character_count+1));
-    if (!tmp) {
-        return errno;
+    int ret;
+    uint32_t i_left;
+    arena_t arena;
+    kern_pairs_t pairs;
+    prj_ttf_reader_kerning_left_character_t *tmp;
+    prj_ttf_reader_kerning_right_character_t *tmp_right;
+    const uint32_t old_count = image_data->list_kerning_left_character_count;
+
+    if (!list_glyph_character_count) {
+        return 0;
     }
 
-    left_character->list_right_character = tmp;
-    left_character->list_right_character[left_character->list_right_character_count].right_character = right_character;
-    left_character->list_right_character[left_character->list_right_character_count].kerning = kerning;
-    left_character->list_right_character_count++;
-    return 0;
+    memset(&arena, 0, sizeof(arena));
+    pairs.left_count = old_count;
+    pairs.list_left_index = (uint32_t *)arena_alloc(&arena, sizeof(uint32_t)*list_glyph_character_count);
+    pairs.list_new_left_character = (uint32_t *)arena_alloc(&arena, sizeof(uint32_t)*list_glyph_character_count);
+    pairs.list_right_count = (uint32_t *)arena_calloc(&arena, (size_t)old_count + list_glyph_character_count, sizeof(uint32_t));
+    if (!pairs.list_left_index || !pairs.list_new_left_character || !pairs.list_right_count) {
+        arena_clear(&arena);
+        return ENOMEM;
+    }
+    memset(pairs.list_left_index, 0xff, sizeof(uint32_t)*list_glyph_character_count);
+
+    ret = kern_walk_pairs(data, data_size, offset, image_data, rate, list_glyph_character, list_glyph_character_count,
+                          &pairs, 0);
+    if (ret) {
+        arena_clear(&arena);
+        return ret;
+    }
+
+    if (pairs.left_count > old_count) {
+        tmp = (prj_ttf_reader_kerning_left_character_t *)realloc(image_data->list_kerning_left_character,
+                                                                 sizeof(prj_ttf_reader_kerning_left_character_t)*pairs.left_count);
+        if (!tmp) {
+            arena_clear(&arena);
+            return errno;
+        }
+        image_data->list_kerning_left_character = tmp;
+        for (i_left=old_count;i_left<pairs.left_count;i_left++) {
+            image_data->list_kerning_left_character[i_left].left_character = pairs.list_new_left_character[i_left-old_count];
+            image_data->list_kerning_left_character[i_left].list_right_character = NULL;
+            image_data->list_kerning_left_character[i_left].list_right_character_count = 0;
+        }
+        image_data->list_kerning_left_character_count = pairs.left_count;
+    }
+
+    for (i_left=0;i_left<pairs.left_count;i_left++) {
+        if (!pairs.list_right_count[i_left]) {
+            continue;
+        }
+        tmp_right = (prj_ttf_reader_kerning_right_character_t *)realloc(image_data->list_kerning_left_character[i_left].list_right_character,
+                                                                        sizeof(prj_ttf_reader_kerning_right_character_t)
+                                                                        *(image_data->list_kerning_left_character[i_left].list_right_character_count
+                                                                          + pairs.list_right_count[i_left]));
+        if (!tmp_right) {
+            arena_clear(&arena);
+            return errno;
+        }
+        image_data->list_kerning_left_character[i_left].list_right_character = tmp_right;
+    }
+
+    ret = kern_walk_pairs(data, data_size, offset, image_data, rate, list_glyph_character, list_glyph_character_count,
+                          &pairs, 1);
+    arena_clear(&arena);
+    return ret;
 }
 
 /*!
- * \brief kern_add_kerning
+ * \brief kern_get_kerning
  *
- * add kerning for left and and right characters
+ * Get kerning value of single glyph pair without collecting all the
+ * kerning pairs, the kerning pairs are sorted by left and right glyph
+ * so binary search is used
+ * https://docs.microsoft.com/en-us/typography/opentype/spec/kern
  *
- * \param image_data
- * \param left_character
- * \param right_character
- * \param kerning
+ * \param data
+ * \param data_size
+ * \param offset
+ * \param left_glyph glyph index of left character
+ * \param right_glyph glyph index of right character
+ * \param kerning [out] kerning value in FUnits, 0 if the pair is not found
  * \return 0 on success
  */
-static int kern_add_kerning(prj_ttf_reader_data_t *image_data, uint32_t left_character, uint32_t right_character, float kerning) {
-    uint32_t i_left = 0;
-    prj_ttf_reader_kerning_left_character_t *tmp;
+int kern_get_kerning(const uint8_t *data, size_t data_size, size_t offset,
+                     uint16_t left_glyph, uint16_t right_glyph, int16_t *kerning)
+{
+    int ret;
+    uint16_t version;
+    uint16_t index_sub_table, num_sub_tables;
+    uint16_t num_kern_pairs;
+    uint32_t pair_min, pair_max, pair_middle;
+    uint32_t key, pair_key;
+    size_t pair_offset;
+    uint16_t kern_pair_left;
+    uint16_t kern_pair_right;
 
-    for (i_left=0;i_left<image_data->list_kerning_left_character_count;i_left++) {
-        if (image_data->list_kerning_left_character[i_left].left_character == left_character) {
-            return kern_add_kerning_right(&image_data->list_kerning_left_character[i_left], right_character, kerning);
-        }
+    *kerning = 0;
+    key = ((uint32_t)left_glyph << 16) | right_glyph;
+
+    ret = parse_value_16u(data, data_size, &offset, &version);
+    if (ret) {
+        return ret;
     }
 
-    tmp = (prj_ttf_reader_kerning_left_character_t *)realloc(image_data->list_kerning_left_character,
-                                                             sizeof(prj_ttf_reader_kerning_left_character_t)*(image_data->list_kerning_left_character_count+1));
-    if (!tmp) {
-        return errno;
+    ret = parse_value_16u(data, data_size, &offset, &num_sub_tables);
+    if (ret) {
+        return ret;
+    }
+
+    for (index_sub_table=0;index_sub_table<num_sub_tables;index_sub_table++) {
+        // skip version, length and coverage
+        offset += 6;
+        ret = parse_value_16u(data, data_size, &offset, &num_kern_pairs);
+        if (ret) {
+            return ret;
+        }
+        // skip search_range, entry_selector and range_shift
+        offset += 6;
+
+        pair_min = 0;
+        pair_max = num_kern_pairs;
+        while (pair_min < pair_max) {
+            pair_middle = (pair_min + pair_max)/2;
+            pair_offset = offset + pair_middle*6;
+            ret = parse_value_16u(data, data_size, &pair_offset, &kern_pair_left);
+            if (ret) {
+                return ret;
+            }
+            ret = parse_value_16u(data, data_size, &pair_offset, &kern_pair_right);
+            if (ret) {
+                return ret;
+            }
+            pair_key = ((uint32_t)kern_pair_left << 16) | kern_pair_right;
+            if (pair_key == key) {
+                return parse_value_16i(data, data_size, &pair_offset, kerning);
+            }
+            if (pair_key < key) {
+                pair_min = pair_middle + 1;
+            } else {
+                pair_max = pair_middle;
+            }
+        }
+
+        offset += (size_t)num_kern_pairs*6;
     }
 
-    image_data->list_kerning_left_character = tmp;
-    image_data->list_kerning_left_character_count++;
-    image_data->list_kerning_left_character[i_left].left_character = left_character;
-    image_data->list_kerning_left_character[i_left].list_right_character = NULL;
-    image_data->list_kerning_left_character[i_left].list_right_character_count = 0;
-    return kern_add_kerning_right(&image_data->list_kerning_left_character[i_left], right_character, kerning);
+    return 0;
 }
@@ -16,10 +16,12 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "../prj-ttf-reader.h"
-#include "cmap.h"
+#include "../font_tables.h"
 
 int kern_parse(const uint8_t *data, size_t data_size, size_t offset,
                prj_ttf_reader_data_t *image_data, float rate,
-               character_table_t *corr_character_table);
+               const glyph_character_t *list_glyph_character, uint32_t list_glyph_character_count);
+int kern_get_kerning(const uint8_t *data, size_t data_size, size_t offset,
+                     uint16_t left_glyph, uint16_t right_glyph, int16_t *kerning);
 
 #endif // KERN_H
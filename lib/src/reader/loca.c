@@ -26,14 +26,14 @@
  * \param data_size
  * \param offset
  * \param list_tables list of tables
- * \param table_count count of tables (max_profile.glyphs_count+1)
+ * \param table_count count of tables (max_profile.glyphs_count+1, up to 65536)
  * \param format
  * \return 0 on success
  */
-int loca_parse(const uint8_t* data, size_t data_size, size_t offset, index_to_loc_table_t **list_tables, uint16_t table_count, int16_t format)
+int loca_parse(const uint8_t* data, size_t data_size, size_t offset, index_to_loc_table_t **list_tables, uint32_t table_count, int16_t format)
 {
     int ret;
-    uint16_t i;
+    uint32_t i;
     uint16_t val;
     *list_tables = (index_to_loc_table_t *)malloc(sizeof(index_to_loc_table_t)*table_count);
     if (!*list_tables ) {
@@ -27,7 +27,7 @@ typedef struct {
     uint32_t offset;
 } index_to_loc_table_t;
 
-int loca_parse(const uint8_t* data, size_t data_size, size_t offset, index_to_loc_table_t **list_tables, uint16_t table_count, int16_t format);
+int loca_parse(const uint8_t* data, size_t data_size, size_t offset, index_to_loc_table_t **list_tables, uint32_t table_count, int16_t format);
 void loca_clear(index_to_loc_table_t **list_tables);
 
 #endif // LOCA_H
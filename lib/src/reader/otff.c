@@ -27,10 +27,30 @@
  * \return UINT16_MAX if tag not found, index otherwise
  */
 uint16_t otff_get_table_record_index(table_record_t *list_table_record, uint16_t list_table_record_count, const char *tag)
+{
+    if (strlen(tag) != TABLE_TAG_STRING_SIZE) {
+        return UINT16_MAX;
+    }
+
+    return otff_get_table_record_index_by_tag(list_table_record, list_table_record_count,
+                                              OTFF_TAG(tag[0], tag[1], tag[2], tag[3]));
+}
+
+/*!
+ * \brief otff_get_table_record_index_by_tag
+ *
+ * get index of 32-bit tag in list_table_record
+ *
+ * \param list_table_record
+ * \param list_table_record_count
+ * \param tag table tag, for example OTFF_TAG_GLYF
+ * \return UINT16_MAX if tag not found, index otherwise
+ */
+uint16_t otff_get_table_record_index_by_tag(const table_record_t *list_table_record, uint16_t list_table_record_count, uint32_t tag)
 {
     uint16_t i;
     for (i=0;i<list_table_record_count;i++) {
-        if (!strcmp(list_table_record[i].table_tag_string, tag)) {
+        if (list_table_record[i].table_tag == tag) {
             return i;
         }
     }
@@ -38,6 +58,90 @@ uint16_t otff_get_table_record_index(table_record_t *list_table_record, uint16_t
     return UINT16_MAX;
 }
 
+/*!
+ * \brief otff_get_table_id
+ *
+ * get table_id_t of 32-bit tag
+ *
+ * \param tag
+ * \return table_id_t, OTFF_TABLE_COUNT if table is not in table_directory_t
+ */
+static table_id_t otff_get_table_id(uint32_t tag)
+{
+    switch (tag) {
+        case OTFF_TAG_HEAD: return OTFF_TABLE_HEAD;
+        case OTFF_TAG_MAXP: return OTFF_TABLE_MAXP;
+        case OTFF_TAG_CMAP: return OTFF_TABLE_CMAP;
+        case OTFF_TAG_GLYF: return OTFF_TABLE_GLYF;
+        case OTFF_TAG_LOCA: return OTFF_TABLE_LOCA;
+        case OTFF_TAG_HMTX: return OTFF_TABLE_HMTX;
+        case OTFF_TAG_HHEA: return OTFF_TABLE_HHEA;
+        case OTFF_TAG_KERN: return OTFF_TABLE_KERN;
+        case OTFF_TAG_NAME: return OTFF_TABLE_NAME;
+        case OTFF_TAG_GPOS: return OTFF_TABLE_GPOS;
+        case OTFF_TAG_GSUB: return OTFF_TABLE_GSUB;
+        default:
+            break;
+    }
+    return OTFF_TABLE_COUNT;
+}
+
+/*!
+ * \brief otff_parse_table_directory
+ *
+ * Resolves the table records into table directory, tables
+ * that are outside of the font data are not added into directory
+ * and the table length is limited to the end of font data
+ *
+ * \param list_table_record
+ * \param list_table_record_count
+ * \param data_size size of the font data
+ * \param directory [out]
+ */
+void otff_parse_table_directory(const table_record_t *list_table_record, uint16_t list_table_record_count, size_t data_size,
+                               table_directory_t *directory)
+{
+    uint16_t i;
+    table_id_t id;
+
+    memset(directory, 0, sizeof(table_directory_t));
+    for (i=0;i<list_table_record_count;i++) {
+        id = otff_get_table_id(list_table_record[i].table_tag);
+        // if the same tag is twice, the first one is used as in otff_get_table_record_index()
+        if (id == OTFF_TABLE_COUNT || directory->list_found[id]) {
+            continue;
+        }
+        if (list_table_record[i].offset >= data_size) {
+            continue;
+        }
+        directory->list_view[id].offset = list_table_record[i].offset;
+        directory->list_view[id].length = list_table_record[i].length;
+        if (directory->list_view[id].length > data_size - directory->list_view[id].offset) {
+            directory->list_view[id].length = data_size - directory->list_view[id].offset;
+        }
+        directory->list_found[id] = 1;
+    }
+}
+
+/*!
+ * \brief otff_get_table
+ *
+ * get table view from table directory
+ *
+ * \param directory
+ * \param table
+ * \param view [out] offset and length of the table
+ * \return 0 on success, EINVAL if font doesn't have the table
+ */
+int otff_get_table(const table_directory_t *directory, table_id_t table, table_view_t *view)
+{
+    if (table >= OTFF_TABLE_COUNT || !directory->list_found[table]) {
+        return EINVAL;
+    }
+    *view = directory->list_view[table];
+    return 0;
+}
+
 /*!
  * \brief otff_parse_table_single_record
  *
@@ -109,6 +213,95 @@ int otff_parse_table_records(const uint8_t* data, size_t data_size, size_t *offs
     return 0;
 }
 
+/*!
+ * \brief otff_get_face_count
+ *
+ * Gets the number of fonts (faces) in the font data
+ * https://docs.microsoft.com/en-us/typography/opentype/spec/otff#collections
+ *
+ * \param data
+ * \param data_size
+ * \param face_count [out] number of faces in TTC header, 1 if font data is not a collection
+ * \return 0 on success, EINVAL if the offsets of the faces are not in font data
+ */
+int otff_get_face_count(const uint8_t* data, size_t data_size, uint32_t *face_count)
+{
+    int ret;
+    uint32_t tag;
+    size_t offset = 0;
+
+    ret = parse_value_32u(data, data_size, &offset, &tag);
+    if (ret) {
+        return ret;
+    }
+    if (tag != OTFF_TAG_TTCF) {
+        *face_count = 1;
+        return 0;
+    }
+
+    // skip majorVersion and minorVersion, the version 2.0 adds
+    // only the DSIG fields after the offsets
+    offset += 4;
+    ret = parse_value_32u(data, data_size, &offset, face_count);
+    if (ret) {
+        return ret;
+    }
+    // numFonts is not trusted, all the offsets must be in font data
+    if (!*face_count || *face_count > (data_size - offset)/4) {
+        return EINVAL;
+    }
+    return 0;
+}
+
+/*!
+ * \brief otff_get_face_offset
+ *
+ * Gets the offset of the offset table of the face in the font data,
+ * table offsets of the faces are from the beginning of the font data,
+ * so all faces of the collection use the same font data
+ *
+ * \param data
+ * \param data_size
+ * \param face_index index of the face, 0 if font data is not a collection
+ * \param face_offset [out] offset of the offset table of the face
+ * \return 0 on success, EINVAL if face_index is not in font data
+ */
+int otff_get_face_offset(const uint8_t* data, size_t data_size, uint32_t face_index, size_t *face_offset)
+{
+    int ret;
+    uint32_t tag, face_count, value;
+    size_t offset = 0;
+
+    ret = parse_value_32u(data, data_size, &offset, &tag);
+    if (ret) {
+        return ret;
+    }
+    if (tag != OTFF_TAG_TTCF) {
+        if (face_index) {
+            return EINVAL;
+        }
+        *face_offset = 0;
+        return 0;
+    }
+
+    ret = otff_get_face_count(data, data_size, &face_count);
+    if (ret) {
+        return ret;
+    }
+    if (face_index >= face_count) {
+        return EINVAL;
+    }
+
+    // ttcTag, majorVersion, minorVersion and numFonts are before the offsets
+    offset = 12 + (size_t)face_index*4;
+    ret = parse_value_32u(data, data_size, &offset, &value);
+    if (ret) {
+        return ret;
+    }
+    *face_offset = value;
+    return 0;
+}
+
 /*!
  * \brief otff_parse_offset_table
  *
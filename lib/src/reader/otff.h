@@ -53,8 +53,81 @@ typedef struct
     uint32_t length;
 } table_record_t;
 
+/*!
+ * \brief OTFF_TAG
+ *
+ * table tag as 32-bit value, for example OTFF_TAG('g', 'l', 'y', 'f')
+ * is same as table_tag of "glyf" table record
+ */
+#define OTFF_TAG(a, b, c, d) ((uint32_t)(((uint32_t)(uint8_t)(a) << 24) | ((uint32_t)(uint8_t)(b) << 16) \
+                                        | ((uint32_t)(uint8_t)(c) << 8) | (uint32_t)(uint8_t)(d)))
+
+#define OTFF_TAG_HEAD   OTFF_TAG('h', 'e', 'a', 'd')
+#define OTFF_TAG_MAXP   OTFF_TAG('m', 'a', 'x', 'p')
+#define OTFF_TAG_CMAP   OTFF_TAG('c', 'm', 'a', 'p')
+#define OTFF_TAG_GLYF   OTFF_TAG('g', 'l', 'y', 'f')
+#define OTFF_TAG_LOCA   OTFF_TAG('l', 'o', 'c', 'a')
+#define OTFF_TAG_HMTX   OTFF_TAG('h', 'm', 't', 'x')
+#define OTFF_TAG_HHEA   OTFF_TAG('h', 'h', 'e', 'a')
+#define OTFF_TAG_KERN   OTFF_TAG('k', 'e', 'r', 'n')
+#define OTFF_TAG_NAME   OTFF_TAG('n', 'a', 'm', 'e')
+#define OTFF_TAG_GPOS   OTFF_TAG('G', 'P', 'O', 'S')
+#define OTFF_TAG_GSUB   OTFF_TAG('G', 'S', 'U', 'B')
+#define OTFF_TAG_TTCF   OTFF_TAG('t', 't', 'c', 'f')
+
+/*!
+ * \brief The table_id_t enum
+ *
+ * index of the table in table_directory_t
+ */
+typedef enum
+{
+    OTFF_TABLE_HEAD = 0,
+    OTFF_TABLE_MAXP,
+    OTFF_TABLE_CMAP,
+    OTFF_TABLE_GLYF,
+    OTFF_TABLE_LOCA,
+    OTFF_TABLE_HMTX,
+    OTFF_TABLE_HHEA,
+    OTFF_TABLE_KERN,
+    OTFF_TABLE_NAME,
+    OTFF_TABLE_GPOS,
+    OTFF_TABLE_GSUB,
+    OTFF_TABLE_COUNT,
+} table_id_t;
+
+/*!
+ * \brief The table_view_t struct
+ *
+ * Bounded byte view of the table in the font data,
+ * offset + length is never over the size of font data
+ */
+typedef struct
+{
+    size_t offset;  // offset of the table in font data
+    size_t length;  // length of the table in bytes
+} table_view_t;
+
+/*!
+ * \brief The table_directory_t struct
+ *
+ * Table records indexed by table_id_t, resolved once by
+ * otff_parse_table_directory()
+ */
+typedef struct
+{
+    table_view_t list_view[OTFF_TABLE_COUNT];
+    uint8_t list_found[OTFF_TABLE_COUNT];   // 1 if font has the table
+} table_directory_t;
+
 uint16_t otff_get_table_record_index(table_record_t *list_table_record, uint16_t list_table_record_count, const char *tag);
+uint16_t otff_get_table_record_index_by_tag(const table_record_t *list_table_record, uint16_t list_table_record_count, uint32_t tag);
+void otff_parse_table_directory(const table_record_t *list_table_record, uint16_t list_table_record_count, size_t data_size,
+                                table_directory_t *directory);
+int otff_get_table(const table_directory_t *directory, table_id_t table, table_view_t *view);
 int otff_parse_table_records(const uint8_t* data, size_t data_size, size_t *offset, table_record_t **list_records, const offset_table_t *offsets);
+int otff_get_face_count(const uint8_t* data, size_t data_size, uint32_t *face_count);
+int otff_get_face_offset(const uint8_t* data, size_t data_size, uint32_t face_index, size_t *face_offset);
 int otff_parse_offset_table(const uint8_t* data, size_t data_size, size_t *offset, offset_table_t *offsets);
 void otff_clear(table_record_t **list_table_record);
 
@@ -0,0 +1,306 @@
+/*!
+ * \file
+ * \brief file coverage.c
+ *
+ * Coverage of the characters that font has
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "coverage.h"
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+
+/*!
+ * \brief coverage_sort_ranges
+ *
+ * qsort compare function of prj_ttf_reader_coverage_range_t
+ */
+static int coverage_sort_ranges(const void *a, const void *b)
+{
+    const prj_ttf_reader_coverage_range_t *range_a = (const prj_ttf_reader_coverage_range_t *)a;
+    const prj_ttf_reader_coverage_range_t *range_b = (const prj_ttf_reader_coverage_range_t *)b;
+
+    if (range_a->first_character != range_b->first_character) {
+        return range_a->first_character < range_b->first_character ? -1 : 1;
+    }
+    return 0;
+}
+
+/*!
+ * \brief coverage_add_range
+ *
+ * add candidate range of characters, range is limited to COVERAGE_MAX_CHARACTER
+ *
+ * \param list_range [in/out] list of ranges, reallocated when required
+ * \param list_range_count [in/out] count of ranges
+ * \param list_range_allocated [in/out] allocated count of ranges
+ * \param first_character
+ * \param last_character
+ * \return 0 on success
+ */
+static int coverage_add_range(prj_ttf_reader_coverage_range_t **list_range, uint32_t *list_range_count,
+                              uint32_t *list_range_allocated, uint32_t first_character, uint32_t last_character)
+{
+    prj_ttf_reader_coverage_range_t *new_list_range;
+
+    if (first_character > last_character || first_character > COVERAGE_MAX_CHARACTER) {
+        return 0;
+    }
+    if (last_character > COVERAGE_MAX_CHARACTER) {
+        last_character = COVERAGE_MAX_CHARACTER;
+    }
+
+    if (*list_range_count == *list_range_allocated) {
+        *list_range_allocated = *list_range_allocated ? *list_range_allocated*2 : 64;
+        new_list_range = (prj_ttf_reader_coverage_range_t *)realloc(*list_range, sizeof(prj_ttf_reader_coverage_range_t)*(*list_range_allocated));
+        if (!new_list_range) {
+            return errno;
+        }
+        *list_range = new_list_range;
+    }
+
+    (*list_range)[*list_range_count].first_character = first_character;
+    (*list_range)[*list_range_count].last_character = last_character;
+    (*list_range_count)++;
+    return 0;
+}
+
+/*!
+ * \brief coverage_get_candidate_ranges
+ *
+ * get ranges of the cmap subtables, the ranges can have characters
+ * that are not in the font, so each character is still checked
+ *
+ * \param character_to_glyph_index_table
+ * \param list_range [out] allocated list of ranges, sorted by first character
+ * \param list_range_count [out] count of ranges
+ * \return 0 on success
+ */
+static int coverage_get_candidate_ranges(const character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
+                                         prj_ttf_reader_coverage_range_t **list_range, uint32_t *list_range_count)
+{
+    int ret;
+    uint16_t i;
+    uint32_t j;
+    uint32_t list_range_allocated = 0;
+    const encoding_record_t *record;
+
+    *list_range = NULL;
+    *list_range_count = 0;
+
+    for (i=0;i<character_to_glyph_index_table->num_tables;i++) {
+        record = &character_to_glyph_index_table->list_encoding_record[i];
+        if (record->format4 && record->format4->end_code) {
+            for (j=0;j<(uint32_t)record->format4->seg_count_x2/2;j++) {
+                ret = coverage_add_range(list_range, list_range_count, &list_range_allocated,
+                                         record->format4->start_code[j], record->format4->end_code[j]);
+                if (ret) {
+                    return ret;
+                }
+            }
+        }
+        if (record->format6 && record->format6->entry_count) {
+            ret = coverage_add_range(list_range, list_range_count, &list_range_allocated,
+                                     record->format6->first_code,
+                                     (uint32_t)record->format6->first_code + record->format6->entry_count - 1);
+            if (ret) {
+                return ret;
+            }
+        }
+        if (record->format12 && record->format12->groups) {
+            for (j=0;j<record->format12->numGroups;j++) {
+                ret = coverage_add_range(list_range, list_range_count, &list_range_allocated,
+                                         record->format12->groups[j].start_char_code,
+                                         record->format12->groups[j].end_char_code);
+                if (ret) {
+                    return ret;
+                }
+            }
+        }
+    }
+
+    if (*list_range_count) {
+        qsort(*list_range, *list_range_count, sizeof(prj_ttf_reader_coverage_range_t), coverage_sort_ranges);
+    }
+    return 0;
+}
+
+/*!
+ * \brief coverage_add_character
+ *
+ * add character to coverage, characters must be added in increasing order
+ *
+ * \param coverage
+ * \param character
+ * \param list_range_allocated [in/out] allocated count of coverage->list_range
+ * \return 0 on success
+ */
+static int coverage_add_character(prj_ttf_reader_coverage_t *coverage, uint32_t character, uint32_t *list_range_allocated)
+{
+    uint32_t block = character >> COVERAGE_BLOCK_SHIFT;
+    uint32_t bit = character & ((1 << COVERAGE_BLOCK_SHIFT) - 1);
+
+    if (!coverage->list_block[block]) {
+        coverage->list_block[block] = (uint64_t *)calloc(COVERAGE_BLOCK_WORD_COUNT, sizeof(uint64_t));
+        if (!coverage->list_block[block]) {
+            return errno;
+        }
+    }
+    coverage->list_block[block][bit/64] |= (uint64_t)1 << (bit%64);
+    coverage->character_count++;
+
+    if (coverage->list_range_count
+            && coverage->list_range[coverage->list_range_count-1].last_character + 1 == character) {
+        coverage->list_range[coverage->list_range_count-1].last_character = character;
+        return 0;
+    }
+    return coverage_add_range(&coverage->list_range, &coverage->list_range_count, list_range_allocated,
+                              character, character);
+}
+
+/*!
+ * \brief coverage_build
+ *
+ * builds coverage of the characters from the cmap, character is
+ * covered if it has glyph index that is smaller than glyphs count
+ *
+ * \param character_to_glyph_index_table
+ * \param glyphs_count
+ * \param coverage [out] coverage, clear with coverage_clear()
+ * \return 0 on success
+ */
+int coverage_build(const character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
+                   uint16_t glyphs_count, prj_ttf_reader_coverage_t *coverage)
+{
+    int ret = 0;
+    uint32_t i;
+    uint32_t character;
+    uint32_t next_character = 0;
+    uint32_t list_range_allocated = 0;
+    uint16_t glyph_index;
+    prj_ttf_reader_coverage_range_t *list_candidate_range;
+    uint32_t list_candidate_range_count;
+    prj_ttf_reader_coverage_range_t *new_list_range;
+
+    memset(coverage, 0, sizeof(prj_ttf_reader_coverage_t));
+    coverage->list_block = (uint64_t **)calloc(COVERAGE_BLOCK_COUNT, sizeof(uint64_t *));
+    if (!coverage->list_block) {
+        return errno;
+    }
+
+    ret = coverage_get_candidate_ranges(character_to_glyph_index_table, &list_candidate_range, &list_candidate_range_count);
+    if (ret) {
+        free(list_candidate_range);
+        return ret;
+    }
+
+    for (i=0;i<list_candidate_range_count;i++) {
+        character = list_candidate_range[i].first_character;
+        if (character < next_character) {
+            // overlapping range, already checked characters are skipped
+            if (list_candidate_range[i].last_character < next_character) {
+                continue;
+            }
+            character = next_character;
+        }
+        for (;character<=list_candidate_range[i].last_character;character++) {
+            if (cmap_get_glyph_index(character_to_glyph_index_table, character, &glyph_index)
+                    || glyph_index >= glyphs_count) {
+                continue;
+            }
+            ret = coverage_add_character(coverage, character, &list_range_allocated);
+            if (ret) {
+                free(list_candidate_range);
+                return ret;
+            }
+        }
+        next_character = list_candidate_range[i].last_character + 1;
+    }
+    free(list_candidate_range);
+
+    if (coverage->list_range_count && coverage->list_range_count != list_range_allocated) {
+        new_list_range = (prj_ttf_reader_coverage_range_t *)realloc(coverage->list_range, sizeof(prj_ttf_reader_coverage_range_t)*coverage->list_range_count);
+        if (new_list_range) {
+            coverage->list_range = new_list_range;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief coverage_clear
+ *
+ * Clears the all values in coverage
+ *
+ * \param coverage
+ */
+void coverage_clear(prj_ttf_reader_coverage_t *coverage)
+{
+    uint32_t i;
+
+    if (coverage->list_block) {
+        for (i=0;i<COVERAGE_BLOCK_COUNT;i++) {
+            if (coverage->list_block[i]) {
+                free(coverage->list_block[i]);
+            }
+        }
+        free(coverage->list_block);
+    }
+    if (coverage->list_range) {
+        free(coverage->list_range);
+    }
+    memset(coverage, 0, sizeof(prj_ttf_reader_coverage_t));
+}
+
+/*!
+ * \brief prj_ttf_reader_coverage_has_character
+ *
+ * \param coverage [in] coverage from prj_ttf_reader_get_coverage_font()
+ * \param character [in] character, for example 'a' == 97
+ * \return 1 if font has glyph for the character, otherwise 0
+ */
+int prj_ttf_reader_coverage_has_character(const prj_ttf_reader_coverage_t *coverage, uint32_t character)
+{
+    const uint64_t *block;
+    uint32_t bit;
+
+    if (character > COVERAGE_MAX_CHARACTER || !coverage->list_block) {
+        return 0;
+    }
+    block = coverage->list_block[character >> COVERAGE_BLOCK_SHIFT];
+    if (!block) {
+        return 0;
+    }
+    bit = character & ((1 << COVERAGE_BLOCK_SHIFT) - 1);
+    return (block[bit/64] >> (bit%64)) & 1 ? 1 : 0;
+}
+
+/*!
+ * \brief prj_ttf_reader_coverage_get_mask
+ *
+ * check list of characters
+ *
+ * \param coverage [in] coverage from prj_ttf_reader_get_coverage_font()
+ * \param list_characters [in] list of characters
+ * \param list_characters_size [in] size of list_characters
+ * \param list_mask [out] 1 or 0 for each character of list_characters,
+ * size must be list_characters_size
+ * \return count of characters that font has
+ */
+uint32_t prj_ttf_reader_coverage_get_mask(const prj_ttf_reader_coverage_t *coverage, const uint32_t *list_characters,
+                                          uint32_t list_characters_size, uint8_t *list_mask)
+{
+    uint32_t i;
+    uint32_t count = 0;
+
+    for (i=0;i<list_characters_size;i++) {
+        list_mask[i] = (uint8_t)prj_ttf_reader_coverage_has_character(coverage, list_characters[i]);
+        count += list_mask[i];
+    }
+    return count;
+}
@@ -0,0 +1,29 @@
+/*!
+ * \file
+ * \brief file coverage.h
+ *
+ * Coverage of the characters that font has
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef COVERAGE_H
+#define COVERAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../prj-ttf-reader.h"
+#include "../reader/cmap.h"
+
+#define COVERAGE_MAX_CHARACTER      0x10FFFF
+#define COVERAGE_BLOCK_SHIFT        12          // 4096 characters per block
+#define COVERAGE_BLOCK_WORD_COUNT   ((1 << COVERAGE_BLOCK_SHIFT)/64)
+#define COVERAGE_BLOCK_COUNT        ((COVERAGE_MAX_CHARACTER >> COVERAGE_BLOCK_SHIFT) + 1)
+
+int coverage_build(const character_to_glyph_index_mapping_table_t *character_to_glyph_index_table,
+                   uint16_t glyphs_count, prj_ttf_reader_coverage_t *coverage);
+void coverage_clear(prj_ttf_reader_coverage_t *coverage);
+
+#endif // COVERAGE_H
@@ -16,6 +16,6 @@
 #include <stddef.h>
 #include "../font_tables.h"
 
-int prj_ttf_reader_parse_supported_characters(const uint8_t *data, size_t data_size, font_tables_t *tables, prj_ttf_reader_supported_characters_t *supported_characters);
+int prj_ttf_reader_parse_supported_characters(const font_tables_t *tables, prj_ttf_reader_supported_characters_t *supported_characters);
 
 #endif // READ_SUPPORTED_CHARACTERS_H
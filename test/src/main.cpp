@@ -17,6 +17,21 @@
 #include "tst_glyph_image_positions.h"
 #include "tst_glyph_graph_generator.h"
 #include "tst_parse_text.h"
+#include "tst_otff.h"
+#include "tst_cmap.h"
+#include "tst_coverage.h"
+#include "tst_glyph_cache.h"
+#include "tst_arena.h"
+#include "tst_glyf.h"
+#include "tst_kern.h"
+#include "tst_loca.h"
+#include "tst_glyph_scanline.h"
+#include "tst_glyph_flatten.h"
+#include "tst_glyph_area.h"
+#include "tst_glyph_tiles.h"
+#include "tst_font_handle.h"
+#include "tst_font_registry.h"
+#include "tst_font_chain.h"
 
 TEST(ParseFont, Test) {
     EXPECT_EQ(tst_parse_text_generate_list_characters(), 0);
@@ -25,6 +40,9 @@ TEST(ParseFont, Test) {
 TEST(GlyphGraphGenerator, Test) {
     EXPECT_EQ(tst_glyph_graph_generator_min_value(), 0);
     EXPECT_EQ(tst_glyph_graph_generator_max_value(), 0);
+    EXPECT_EQ(tst_glyph_graph_generator_quadratic_min_max(), 0);
+    EXPECT_EQ(tst_glyph_graph_generator_thread_count(), 0);
+    EXPECT_EQ(tst_glyph_graph_generator_max_memory_retry(), 0);
 }
 
 
@@ -36,6 +54,87 @@ TEST(GlyphDrawer, Test) {
     EXPECT_EQ(tst_fillInnerAreaInImageFiles(), 0);
 }
 
+TEST(GlyphDrawer, PaintCurve) {
+    EXPECT_EQ(tst_glyph_drawer_paint_curve(), 0);
+}
+
+TEST(GlyphDrawer, DrawLine) {
+    EXPECT_EQ(tst_glyph_drawer_draw_line(), 0);
+}
+
+TEST(GlyphDrawer, Pool) {
+    EXPECT_EQ(tst_glyph_drawer_pool(), 0);
+}
+
+TEST(GlyphScanline, Test) {
+    EXPECT_EQ(tst_glyph_scanline_fill(), 0);
+}
+
+TEST(GlyphFlatten, Test) {
+    EXPECT_EQ(tst_glyph_flatten_points(), 0);
+}
+
+TEST(GlyphTiles, Test) {
+    EXPECT_EQ(tst_glyph_tiles_fill(), 0);
+}
+
+TEST(GlyphArea, Test) {
+    EXPECT_EQ(tst_glyph_area_coverage(), 0);
+}
+
+TEST(Otff, Test) {
+    EXPECT_EQ(tst_otff_table_directory(), 0);
+    EXPECT_EQ(tst_otff_collection(), 0);
+    EXPECT_EQ(tst_otff_collection_truncated(), 0);
+}
+
+TEST(Cmap, Test) {
+    EXPECT_EQ(tst_cmap_get_glyph_index_format4(), 0);
+    EXPECT_EQ(tst_cmap_get_glyph_index_format6_format12(), 0);
+}
+
+TEST(Coverage, Test) {
+    EXPECT_EQ(tst_coverage_build(), 0);
+}
+
+TEST(GlyphCache, Test) {
+    EXPECT_EQ(tst_glyph_cache_lru(), 0);
+}
+
+TEST(FontHandle, Test) {
+    EXPECT_EQ(tst_font_handle_open_close(), 0);
+    EXPECT_EQ(tst_font_handle_open_mmap_fallback(), 0);
+    EXPECT_EQ(tst_font_handle_open_memory_copy_borrow(), 0);
+    EXPECT_EQ(tst_font_handle_lazy_tables(), 0);
+    EXPECT_EQ(tst_font_handle_options_shared(), 0);
+}
+
+TEST(FontRegistry, Test) {
+    EXPECT_EQ(tst_font_registry_acquire_release(), 0);
+    EXPECT_EQ(tst_font_registry_acquire_threads(), 0);
+}
+
+TEST(FontChain, Test) {
+    EXPECT_EQ(tst_font_chain_split_characters(), 0);
+}
+
+TEST(Arena, Test) {
+    EXPECT_EQ(tst_arena_alloc_reset(), 0);
+}
+
+TEST(Glyf, Test) {
+    EXPECT_EQ(tst_glyf_parse_flags_and_points(), 0);
+    EXPECT_EQ(tst_glyf_outline_iterator_closed(), 0);
+}
+
+TEST(Kern, Test) {
+    EXPECT_EQ(tst_kern_parse_generated_characters(), 0);
+}
+
+TEST(Loca, Test) {
+    EXPECT_EQ(tst_loca_parse_max_glyphs(), 0);
+}
+
 TEST(TestLoader, Test) {
     EXPECT_EQ(tst_test_loader_rotate(), 0);
 }
@@ -0,0 +1,208 @@
+/*!
+* \file
+* \brief file test_font.cpp
+*
+* Writes the font data of the unit tests
+*
+* Copyright of Timo Hannukkala, All rights reserved.
+*
+* \author Timo Hannukkala <timohannukkala@hotmail.com>
+*/
+#include "test_font.h"
+#include <stdio.h>
+#include <string.h>
+#include "../../lib/src/reader/glyf.h"
+
+/*!
+ * \brief test_font_put
+ *
+ * writes big-endian value into data
+ *
+ * \param data
+ * \param offset [in/out]
+ * \param value
+ * \param size 2 or 4 bytes
+ */
+void test_font_put(uint8_t *data, size_t *offset, uint32_t value, int size)
+{
+    int i;
+
+    for (i=size-1;i>=0;i--) {
+        data[(*offset)++] = (uint8_t)(value >> (8*i));
+    }
+}
+
+/*!
+ * \brief test_font_write
+ *
+ * writes font with cmap, glyf, head, hhea, hmtx, loca and maxp tables.
+ * Outer contour of each glyph starts with two off-curve points and
+ * the inner contour is a square hole, glyphs grow with the glyph index
+ *
+ * \param data [out] at least TEST_FONT_MAX_SIZE bytes
+ * \return size of the font
+ */
+size_t test_font_write(uint8_t *data)
+{
+    const char *list_tag[] = { "cmap", "glyf", "head", "hhea", "hmtx", "loca", "maxp" };
+    size_t list_table_offset[8];
+    size_t list_loca[TEST_FONT_GLYPHS + 2];
+    size_t offset = 12 + 7*16;
+    size_t directory_offset = 0;
+    int i, j;
+    int size;
+    uint16_t glyphs_count = TEST_FONT_GLYPHS + 1;
+    const uint8_t list_flags[] = { 0, 0, ON_CURVE_POINT, 0, 0, ON_CURVE_POINT,
+                                   ON_CURVE_POINT, ON_CURVE_POINT, ON_CURVE_POINT, ON_CURVE_POINT };
+    int list_x[10];
+    int list_y[10];
+
+    memset(data, 0, TEST_FONT_MAX_SIZE);
+    test_font_put(data, &directory_offset, 0x00010000, 4);
+    test_font_put(data, &directory_offset, 7, 2);
+    directory_offset += 6;
+
+    // cmap: format 4 segment 'A'.. and the last segment 0xFFFF
+    list_table_offset[0] = offset;
+    test_font_put(data, &offset, 0, 2);
+    test_font_put(data, &offset, 1, 2);
+    test_font_put(data, &offset, 3, 2);
+    test_font_put(data, &offset, 1, 2);
+    test_font_put(data, &offset, 12, 4);
+    test_font_put(data, &offset, 4, 2);
+    test_font_put(data, &offset, 32, 2);
+    test_font_put(data, &offset, 0, 2);
+    test_font_put(data, &offset, 4, 2);
+    test_font_put(data, &offset, 4, 2);
+    test_font_put(data, &offset, 1, 2);
+    test_font_put(data, &offset, 0, 2);
+    test_font_put(data, &offset, 'A' + TEST_FONT_GLYPHS - 1, 2);
+    test_font_put(data, &offset, 0xFFFF, 2);
+    test_font_put(data, &offset, 0, 2);
+    test_font_put(data, &offset, 'A', 2);
+    test_font_put(data, &offset, 0xFFFF, 2);
+    test_font_put(data, &offset, (uint16_t)(1 - 'A'), 2);
+    test_font_put(data, &offset, 1, 2);
+    test_font_put(data, &offset, 0, 4);
+
+    // glyf: glyph 0 is empty
+    list_table_offset[1] = offset;
+    list_loca[0] = 0;
+    list_loca[1] = 0;
+    for (i=1;i<glyphs_count;i++) {
+        size = 300 + 40*i;
+        list_x[0] = 0;      list_y[0] = size;
+        list_x[1] = size;   list_y[1] = size;
+        list_x[2] = size;   list_y[2] = size/2;
+        list_x[3] = size;   list_y[3] = 0;
+        list_x[4] = 0;      list_y[4] = 0;
+        list_x[5] = 0;      list_y[5] = size/2;
+        list_x[6] = size/4;     list_y[6] = size/4;
+        list_x[7] = size*3/4;   list_y[7] = size/4;
+        list_x[8] = size*3/4;   list_y[8] = size*3/4;
+        list_x[9] = size/4;     list_y[9] = size*3/4;
+
+        test_font_put(data, &offset, 2, 2);
+        test_font_put(data, &offset, 0, 2);
+        test_font_put(data, &offset, 0, 2);
+        test_font_put(data, &offset, (uint32_t)size, 2);
+        test_font_put(data, &offset, (uint32_t)size, 2);
+        test_font_put(data, &offset, 5, 2);
+        test_font_put(data, &offset, 9, 2);
+        test_font_put(data, &offset, 0, 2);
+        for (j=0;j<10;j++) {
+            data[offset++] = list_flags[j];
+        }
+        // coordinates are deltas of int16
+        for (j=0;j<10;j++) {
+            test_font_put(data, &offset, (uint16_t)(list_x[j] - (j ? list_x[j-1] : 0)), 2);
+        }
+        for (j=0;j<10;j++) {
+            test_font_put(data, &offset, (uint16_t)(list_y[j] - (j ? list_y[j-1] : 0)), 2);
+        }
+        list_loca[i+1] = offset - list_table_offset[1];
+    }
+
+    // head: units per em 1000 and long loca offsets
+    list_table_offset[2] = offset;
+    data[offset + 18] = 1000 >> 8;
+    data[offset + 19] = 1000 & 0xFF;
+    data[offset + 51] = 1;
+    offset += 56;
+
+    // hhea: number of hmetrics
+    list_table_offset[3] = offset;
+    data[offset + 1] = 1;
+    data[offset + 35] = (uint8_t)glyphs_count;
+    offset += 36;
+
+    // hmtx: advance width 1000 of each glyph
+    list_table_offset[4] = offset;
+    for (i=0;i<glyphs_count;i++) {
+        test_font_put(data, &offset, 1000, 2);
+        test_font_put(data, &offset, 0, 2);
+    }
+
+    list_table_offset[5] = offset;
+    for (i=0;i<=glyphs_count;i++) {
+        test_font_put(data, &offset, (uint32_t)list_loca[i], 4);
+    }
+
+    // maxp version 0.5
+    list_table_offset[6] = offset;
+    test_font_put(data, &offset, 0x00005000, 4);
+    test_font_put(data, &offset, glyphs_count, 2);
+    offset += 2;
+    list_table_offset[7] = offset;
+
+    for (i=0;i<7;i++) {
+        memcpy(&data[directory_offset], list_tag[i], 4);
+        directory_offset += 8;
+        test_font_put(data, &directory_offset, (uint32_t)list_table_offset[i], 4);
+        test_font_put(data, &directory_offset, (uint32_t)(list_table_offset[i+1] - list_table_offset[i]), 4);
+    }
+    return offset;
+}
+
+/*!
+ * \brief test_font_write_file
+ *
+ * writes the font of test_font_write() into the file
+ *
+ * \param file_name
+ * \return 0 on success
+ */
+int test_font_write_file(const char *file_name)
+{
+    uint8_t data[TEST_FONT_MAX_SIZE];
+    size_t data_size = test_font_write(data);
+    size_t written;
+    FILE *fp = fopen(file_name, "wb");
+
+    if (!fp) {
+        return 1;
+    }
+    written = fwrite(data, 1, data_size, fp);
+    fclose(fp);
+    return written == data_size ? 0 : 1;
+}
+
+/*!
+ * \brief test_font_get_table_record
+ *
+ * \param data font of test_font_write()
+ * \param tag table tag, for example "hmtx"
+ * \return offset of the table record in the table directory, 0 if not found
+ */
+size_t test_font_get_table_record(const uint8_t *data, const char *tag)
+{
+    size_t offset;
+    size_t table_count = (size_t)((data[4] << 8) | data[5]);
+
+    for (offset=12;offset<12+16*table_count;offset+=16) {
+        if (!memcmp(&data[offset], tag, 4)) {
+            return offset;
+        }
+    }
+    return 0;
+}
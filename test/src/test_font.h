@@ -0,0 +1,34 @@
+/*!
+* \file
+* \brief file test_font.h
+*
+* Writes the font data of the unit tests
+*
+* Copyright of Timo Hannukkala, All rights reserved.
+*
+* \author Timo Hannukkala <timohannukkala@hotmail.com>
+*/
+
+#ifndef TEST_FONT_H
+#define TEST_FONT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \brief glyphs of test_font_write(), characters
+ * from 'A' are mapped to glyphs from 1, glyph 0 is empty
+ */
+#define TEST_FONT_GLYPHS    12
+
+/*!
+ * \brief max size of the font of test_font_write()
+ */
+#define TEST_FONT_MAX_SIZE  4096
+
+void test_font_put(uint8_t *data, size_t *offset, uint32_t value, int size);
+size_t test_font_write(uint8_t *data);
+int test_font_write_file(const char *file_name);
+size_t test_font_get_table_record(const uint8_t *data, const char *tag);
+
+#endif // TEST_FONT_H
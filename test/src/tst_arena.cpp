@@ -0,0 +1,70 @@
+/*!
+ * \file
+ * \brief file tst_arena.cpp
+ *
+ * test arena.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../lib/src/arena.h"
+
+/*!
+ * \brief tst_arena_alloc_reset
+ *
+ * tests that allocations are aligned and don't overlap, larger
+ * allocation than block size gets own block and reset keeps
+ * only the largest block
+ *
+ * \return 0 on success
+ */
+int tst_arena_alloc_reset()
+{
+    int ret = 0;
+    uint8_t *a, *b, *c;
+    uint8_t *large;
+    arena_t arena;
+
+    memset(&arena, 0, sizeof(arena));
+    arena.block_size = 64;
+
+    a = static_cast<uint8_t *>(arena_alloc(&arena, 3));
+    b = static_cast<uint8_t *>(arena_calloc(&arena, 5, 2));
+    if (!a || !b || b != a + ARENA_ALIGNMENT || reinterpret_cast<uintptr_t>(b) % ARENA_ALIGNMENT) {
+        arena_clear(&arena);
+        return 1;
+    }
+    for (c=b;c<b+10;c++) {
+        if (*c) {
+            ret = 2;
+        }
+    }
+
+    large = static_cast<uint8_t *>(arena_alloc(&arena, 1000));
+    if (!large || arena.first == arena.current || arena.current->size != 1000) {
+        ret = 3;
+    }
+    memset(large, 0xff, 1000);
+
+    arena_reset(&arena);
+    if (!arena.first || arena.first != arena.current || arena.first->next
+            || arena.first->size != 1000 || arena.first->used) {
+        ret = 4;
+    }
+    // reused block
+    if (arena_alloc(&arena, 1000) != large) {
+        ret = 5;
+    }
+
+    arena_clear(&arena);
+    if (arena.first || arena.current) {
+        ret = 6;
+    }
+    return ret;
+}
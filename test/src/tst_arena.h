@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_arena.h
+ *
+ * test arena.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_ARENA_H
+#define TST_ARENA_H
+
+int tst_arena_alloc_reset();
+
+#endif // TST_ARENA_H
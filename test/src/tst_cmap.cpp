@@ -0,0 +1,198 @@
+/*!
+ * \file
+ * \brief file tst_cmap.cpp
+ *
+ * test cmap.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_cmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../lib/src/reader/cmap.h"
+
+/*!
+ * \brief tst_cmap_write_16
+ *
+ * writes big-endian 16-bit value into data
+ */
+static void tst_cmap_write_16(uint8_t *data, size_t *offset, uint16_t value)
+{
+    data[(*offset)++] = static_cast<uint8_t>(value >> 8);
+    data[(*offset)++] = static_cast<uint8_t>(value);
+}
+
+/*!
+ * \brief tst_cmap_write_32
+ *
+ * writes big-endian 32-bit value into data
+ */
+static void tst_cmap_write_32(uint8_t *data, size_t *offset, uint32_t value)
+{
+    tst_cmap_write_16(data, offset, static_cast<uint16_t>(value >> 16));
+    tst_cmap_write_16(data, offset, static_cast<uint16_t>(value));
+}
+
+/*!
+ * \brief tst_cmap_get_glyph_index
+ *
+ * \return glyph index of the character, 0 if not found
+ */
+static uint16_t tst_cmap_get_glyph_index(const character_to_glyph_index_mapping_table_t *table, uint32_t character)
+{
+    uint16_t glyph_index = 0;
+    if (cmap_get_glyph_index(table, character, &glyph_index)) {
+        return 0;
+    }
+    return glyph_index;
+}
+
+/*!
+ * \brief tst_cmap_get_glyph_index_format4
+ *
+ * tests cmap_get_glyph_index with format 4 subtable
+ * segments: 'A'-'C' with delta, 'a'-'b' with glyph id array, 0xFFFF end segment
+ *
+ * \return 0 on success
+ */
+int tst_cmap_get_glyph_index_format4()
+{
+    uint8_t data[128];
+    size_t offset = 0;
+    int ret = 0;
+    uint32_t list_character[64];
+    character_to_glyph_index_mapping_table_t table;
+
+    memset(data, 0, sizeof(data));
+    memset(&table, 0, sizeof(table));
+    // cmap header and single encoding record
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_16(data, &offset, 1);
+    tst_cmap_write_16(data, &offset, 3);
+    tst_cmap_write_16(data, &offset, 1);
+    tst_cmap_write_32(data, &offset, 12);
+    // format 4, 3 segments
+    tst_cmap_write_16(data, &offset, 4);
+    tst_cmap_write_16(data, &offset, 48);
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_16(data, &offset, 6);
+    tst_cmap_write_16(data, &offset, 4);
+    tst_cmap_write_16(data, &offset, 1);
+    tst_cmap_write_16(data, &offset, 2);
+    // end codes
+    tst_cmap_write_16(data, &offset, 'C');
+    tst_cmap_write_16(data, &offset, 'b');
+    tst_cmap_write_16(data, &offset, 0xFFFF);
+    tst_cmap_write_16(data, &offset, 0);
+    // start codes
+    tst_cmap_write_16(data, &offset, 'A');
+    tst_cmap_write_16(data, &offset, 'a');
+    tst_cmap_write_16(data, &offset, 0xFFFF);
+    // id deltas
+    tst_cmap_write_16(data, &offset, static_cast<uint16_t>(10 - 'A'));
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_16(data, &offset, 1);
+    // id range offsets, second segment points after the id range offsets
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_16(data, &offset, 4);
+    tst_cmap_write_16(data, &offset, 0);
+    // glyph id array
+    tst_cmap_write_16(data, &offset, 20);
+    tst_cmap_write_16(data, &offset, 21);
+
+    if (cmap_parse_character_to_glyph_index_mapping_table(data, offset, 0, &table)) {
+        ret = 1;
+    } else if (tst_cmap_get_glyph_index(&table, 'A') != 10 || tst_cmap_get_glyph_index(&table, 'C') != 12) {
+        ret = 2;
+    } else if (tst_cmap_get_glyph_index(&table, 'a') != 20 || tst_cmap_get_glyph_index(&table, 'b') != 21) {
+        ret = 3;
+    } else if (tst_cmap_get_glyph_index(&table, '@') || tst_cmap_get_glyph_index(&table, 'D')
+               || tst_cmap_get_glyph_index(&table, 'c') || tst_cmap_get_glyph_index(&table, 0xFFFF)
+               || tst_cmap_get_glyph_index(&table, 0x10000)) {
+        ret = 4;
+    } else {
+        memset(list_character, 0, sizeof(list_character));
+        cmap_fill_glyph_characters(&table, list_character, 32);
+        if (list_character[10] != 'A' || list_character[12] != 'C' || list_character[20] != 'a'
+                || list_character[21] != 'b' || list_character[0] != 0xFFFF || list_character[13]) {
+            ret = 5;
+        }
+    }
+
+    cmap_clear(&table);
+    return ret;
+}
+
+/*!
+ * \brief tst_cmap_get_glyph_index_format6_format12
+ *
+ * tests cmap_get_glyph_index with format 6 and format 12 subtables,
+ * format 12 is used first
+ *
+ * \return 0 on success
+ */
+int tst_cmap_get_glyph_index_format6_format12()
+{
+    uint8_t data[128];
+    size_t offset = 0;
+    int ret = 0;
+    uint32_t list_character[64];
+    character_to_glyph_index_mapping_table_t table;
+
+    memset(data, 0, sizeof(data));
+    memset(&table, 0, sizeof(table));
+    // cmap header and two encoding records
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_16(data, &offset, 2);
+    tst_cmap_write_16(data, &offset, 1);
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_32(data, &offset, 20);
+    tst_cmap_write_16(data, &offset, 3);
+    tst_cmap_write_16(data, &offset, 10);
+    tst_cmap_write_32(data, &offset, 34);
+    // format 6, 'x' and 'y' (entry count is parsed as bytes)
+    tst_cmap_write_16(data, &offset, 6);
+    tst_cmap_write_16(data, &offset, 14);
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_16(data, &offset, 'x');
+    tst_cmap_write_16(data, &offset, 4);
+    tst_cmap_write_16(data, &offset, 30);
+    tst_cmap_write_16(data, &offset, 31);
+    // format 12, two groups
+    tst_cmap_write_16(data, &offset, 12);
+    tst_cmap_write_16(data, &offset, 0);
+    tst_cmap_write_32(data, &offset, 40);
+    tst_cmap_write_32(data, &offset, 0);
+    tst_cmap_write_32(data, &offset, 2);
+    tst_cmap_write_32(data, &offset, 'x');
+    tst_cmap_write_32(data, &offset, 'x');
+    tst_cmap_write_32(data, &offset, 40);
+    tst_cmap_write_32(data, &offset, 0x20000);
+    tst_cmap_write_32(data, &offset, 0x20010);
+    tst_cmap_write_32(data, &offset, 50);
+
+    if (cmap_parse_character_to_glyph_index_mapping_table(data, offset, 0, &table)) {
+        ret = 1;
+    } else if (tst_cmap_get_glyph_index(&table, 'x') != 40 || tst_cmap_get_glyph_index(&table, 'y') != 31) {
+        ret = 2;
+    } else if (tst_cmap_get_glyph_index(&table, 0x20000) != 50 || tst_cmap_get_glyph_index(&table, 0x20010) != 66) {
+        ret = 3;
+    } else if (tst_cmap_get_glyph_index(&table, 'w') || tst_cmap_get_glyph_index(&table, 'z')
+               || tst_cmap_get_glyph_index(&table, 0x20011) || tst_cmap_get_glyph_index(&table, 0x1FFFF)) {
+        ret = 4;
+    } else {
+        memset(list_character, 0, sizeof(list_character));
+        cmap_fill_glyph_characters(&table, list_character, 64);
+        if (list_character[30] != 'x' || list_character[31] != 'y' || list_character[40] != 'x'
+                || list_character[50] != 0x20000 || list_character[63] != 0x2000D || list_character[0]) {
+            ret = 5;
+        }
+    }
+
+    cmap_clear(&table);
+    return ret;
+}
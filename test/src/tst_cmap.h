@@ -0,0 +1,18 @@
+/*!
+ * \file
+ * \brief file tst_cmap.h
+ *
+ * test cmap.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_CMAP_H
+#define TST_CMAP_H
+
+int tst_cmap_get_glyph_index_format4();
+int tst_cmap_get_glyph_index_format6_format12();
+
+#endif // TST_CMAP_H
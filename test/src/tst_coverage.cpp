@@ -0,0 +1,81 @@
+/*!
+ * \file
+ * \brief file tst_coverage.cpp
+ *
+ * test coverage.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_coverage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../lib/src/supported_characters/coverage.h"
+
+/*!
+ * \brief tst_coverage_build
+ *
+ * tests coverage_build with format 12 subtable that has
+ * overlapping groups, groups above U+FFFF and glyph indexes
+ * above glyphs count
+ *
+ * \return 0 on success
+ */
+int tst_coverage_build()
+{
+    int ret = 0;
+    uint32_t i;
+    encoding_record_format12_t format12;
+    encoding_record_t encoding_record;
+    character_to_glyph_index_mapping_table_t table;
+    prj_ttf_reader_coverage_t coverage;
+    sequential_map_group_t groups[4] = {
+        { 'A', 'C', 1 },
+        { 'D', 'F', 4 },
+        { 0x1F600, 0x1F601, 10 },
+        { 0x20000, 0x20001, 99 },   // glyph indexes above glyphs count
+    };
+    const uint32_t list_characters[6] = { 'A', 'F', 'G', 0x1F601, 0x20000, 0x110000 };
+    const uint8_t list_expected_mask[6] = { 1, 1, 0, 1, 0, 0 };
+    uint8_t list_mask[6];
+
+    memset(&format12, 0, sizeof(format12));
+    memset(&encoding_record, 0, sizeof(encoding_record));
+    memset(&table, 0, sizeof(table));
+    format12.format = 12;
+    format12.numGroups = 4;
+    format12.groups = groups;
+    encoding_record.platform_id = 3;
+    encoding_record.encoding_id = 10;
+    encoding_record.format12 = &format12;
+    table.num_tables = 1;
+    table.list_encoding_record = &encoding_record;
+
+    if (coverage_build(&table, 20, &coverage)) {
+        return 1;
+    }
+
+    if (coverage.list_range_count != 2 || coverage.character_count != 8) {
+        ret = 2;
+    } else if (coverage.list_range[0].first_character != 'A' || coverage.list_range[0].last_character != 'F'
+               || coverage.list_range[1].first_character != 0x1F600 || coverage.list_range[1].last_character != 0x1F601) {
+        ret = 3;
+    } else if (prj_ttf_reader_coverage_get_mask(&coverage, list_characters, 6, list_mask) != 3) {
+        ret = 4;
+    } else {
+        for (i=0;i<6;i++) {
+            if (list_mask[i] != list_expected_mask[i]) {
+                ret = 5;
+            }
+        }
+    }
+
+    coverage_clear(&coverage);
+    if (coverage.list_block || coverage.list_range) {
+        ret = 6;
+    }
+    return ret;
+}
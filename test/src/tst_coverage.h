@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_coverage.h
+ *
+ * test coverage.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_COVERAGE_H
+#define TST_COVERAGE_H
+
+int tst_coverage_build();
+
+#endif // TST_COVERAGE_H
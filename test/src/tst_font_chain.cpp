@@ -0,0 +1,138 @@
+/*!
+ * \file
+ * \brief file tst_font_chain.cpp
+ *
+ * test font_chain.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_font_chain.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../lib/src/font_chain.h"
+#include "../../lib/src/supported_characters/coverage.h"
+
+/*!
+ * \brief tst_font_chain_build_coverage
+ *
+ * builds the coverage of the format 12 cmap that has the groups
+ *
+ * \param groups
+ * \param groups_count
+ * \param coverage [out]
+ * \return 0 on success
+ */
+static int tst_font_chain_build_coverage(sequential_map_group_t *groups, uint32_t groups_count,
+                                         prj_ttf_reader_coverage_t *coverage)
+{
+    encoding_record_format12_t format12;
+    encoding_record_t encoding_record;
+    character_to_glyph_index_mapping_table_t table;
+
+    memset(&format12, 0, sizeof(format12));
+    memset(&encoding_record, 0, sizeof(encoding_record));
+    memset(&table, 0, sizeof(table));
+    format12.format = 12;
+    format12.numGroups = groups_count;
+    format12.groups = groups;
+    encoding_record.platform_id = 3;
+    encoding_record.encoding_id = 10;
+    encoding_record.format12 = &format12;
+    table.num_tables = 1;
+    table.list_encoding_record = &encoding_record;
+
+    return coverage_build(&table, 100, coverage);
+}
+
+/*!
+ * \brief tst_font_chain_split_characters
+ *
+ * tests that font_chain_split_characters gives each character to
+ * the first font that has it, keeps the order of the characters
+ * and ignores the characters that none of the fonts has
+ *
+ * \return 0 on success
+ */
+int tst_font_chain_split_characters()
+{
+    int ret = 0;
+    uint32_t i;
+    sequential_map_group_t groups_first[1] = {
+        { 'A', 'C', 1 },
+    };
+    sequential_map_group_t groups_second[2] = {
+        { 'B', 'Z', 1 },
+        { 0x1F600, 0x1F600, 30 },
+    };
+    prj_ttf_reader_coverage_t coverage[2];
+    const prj_ttf_reader_coverage_t *list_coverage[2] = { &coverage[0], &coverage[1] };
+    prj_ttf_reader_font_chain_t chain;
+    const uint32_t list_characters[7] = { 'Z', 'A', '!', 0x1F600, 'B', 'Y', 'C' };
+    const uint32_t list_expected[6] = { 'A', 'B', 'C', 'Z', 0x1F600, 'Y' };
+    uint32_t *list_font_characters;
+    uint32_t list_font_characters_size[2];
+    uint32_t *list_many_characters;
+    const uint32_t many_characters_size = 40000;
+
+    memset(coverage, 0, sizeof(coverage));
+    if (tst_font_chain_build_coverage(groups_first, 1, &coverage[0])
+            || tst_font_chain_build_coverage(groups_second, 2, &coverage[1])) {
+        coverage_clear(&coverage[0]);
+        coverage_clear(&coverage[1]);
+        return 1;
+    }
+
+    // fonts are not used by font_chain_split_characters()
+    memset(&chain, 0, sizeof(chain));
+    chain.list_coverage = list_coverage;
+    chain.list_font_count = 2;
+
+    if (font_chain_split_characters(&chain, list_characters, 7, &list_font_characters, list_font_characters_size)) {
+        ret = 2;
+    } else {
+        if (list_font_characters_size[0] != 3 || list_font_characters_size[1] != 3) {
+            ret = 3;
+        } else if (memcmp(list_font_characters, list_expected, sizeof(list_expected))) {
+            ret = 4;
+        }
+        free(list_font_characters);
+    }
+
+    // count of the characters of single font does not fit into int16_t
+    list_many_characters = (uint32_t *)malloc(sizeof(uint32_t)*many_characters_size);
+    if (!list_many_characters) {
+        ret = 5;
+    } else {
+        for (i=0;i<many_characters_size;i++) {
+            list_many_characters[i] = 'D' + i%2;
+        }
+        if (font_chain_split_characters(&chain, list_many_characters, many_characters_size,
+                                        &list_font_characters, list_font_characters_size)) {
+            ret = 6;
+        } else {
+            if (list_font_characters_size[0] || list_font_characters_size[1] != many_characters_size
+                    || list_font_characters[0] != 'D' || list_font_characters[many_characters_size-1] != 'E') {
+                ret = 7;
+            }
+            free(list_font_characters);
+        }
+        free(list_many_characters);
+    }
+
+    // empty list
+    if (!ret && (font_chain_split_characters(&chain, list_characters, 0, &list_font_characters, list_font_characters_size)
+                 || list_font_characters_size[0] || list_font_characters_size[1])) {
+        ret = 8;
+    }
+    if (!ret) {
+        free(list_font_characters);
+    }
+
+    coverage_clear(&coverage[0]);
+    coverage_clear(&coverage[1]);
+    return ret;
+}
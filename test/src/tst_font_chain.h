@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_font_chain.h
+ *
+ * test font_chain.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_FONT_CHAIN_H
+#define TST_FONT_CHAIN_H
+
+int tst_font_chain_split_characters();
+
+#endif // TST_FONT_CHAIN_H
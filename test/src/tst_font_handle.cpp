@@ -0,0 +1,378 @@
+/*!
+ * \file
+ * \brief file tst_font_handle.cpp
+ *
+ * test font_handle.c sources and the font functions of prj-ttf-reader.c
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_font_handle.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "test_font.h"
+#include "../../lib/src/font_handle.h"
+
+/*!
+ * \brief characters of the generate calls, 'A'..
+ */
+#define TST_FONT_HANDLE_CHARACTERS  4
+
+extern int font_handle_map_file_fails;
+
+/*!
+ * \brief tst_font_handle_is_same_data
+ *
+ * \param data_a
+ * \param data_b
+ * \return 1 if the images and the glyph data are same
+ */
+static int tst_font_handle_is_same_data(const prj_ttf_reader_data_t *data_a, const prj_ttf_reader_data_t *data_b)
+{
+    return data_a->list_data_count == data_b->list_data_count
+            && data_a->image.width == data_b->image.width
+            && data_a->image.height == data_b->image.height
+            && !memcmp(data_a->image.data, data_b->image.data, (size_t)(data_a->image.width*data_a->image.height))
+            && !memcmp(data_a->list_data, data_b->list_data, sizeof(prj_ttf_reader_glyph_data_t)*data_a->list_data_count);
+}
+
+/*!
+ * \brief tst_font_handle_generate
+ *
+ * generates the glyphs of the characters 'A'.. with the opened font
+ *
+ * \param font
+ * \param data [out] cleared with prj_ttf_reader_clear_data()
+ * \return 0 on success
+ */
+static int tst_font_handle_generate(prj_ttf_reader_font_t *font, prj_ttf_reader_data_t **data)
+{
+    uint32_t i;
+    uint32_t list_characters[TST_FONT_HANDLE_CHARACTERS];
+
+    for (i=0;i<TST_FONT_HANDLE_CHARACTERS;i++) {
+        list_characters[i] = 'A' + i;
+    }
+    *data = prj_ttf_reader_init_data();
+    if (!*data) {
+        return 1;
+    }
+    return prj_ttf_reader_generate_glyphs_list_characters_font(list_characters, TST_FONT_HANDLE_CHARACTERS,
+                                                               font, 24.0f, 5, *data);
+}
+
+/*!
+ * \brief tst_font_handle_open_close
+ *
+ * tests that the opened font generates the same glyphs as
+ * the call with the file name, that the font can be used
+ * for many calls and that closing sets the font NULL
+ *
+ * \return 0 on success
+ */
+int tst_font_handle_open_close()
+{
+    int ret = 0;
+    uint32_t i;
+    uint32_t list_characters[TST_FONT_HANDLE_CHARACTERS];
+    char file_name[] = "/tmp/tst_font_handle_XXXXXX";
+    prj_ttf_reader_font_t *font = NULL;
+    prj_ttf_reader_data_t *data_font = NULL;
+    prj_ttf_reader_data_t *data_again = NULL;
+    prj_ttf_reader_data_t *data_file = prj_ttf_reader_init_data();
+    int fd = mkstemp(file_name);
+
+    if (fd < 0 || !data_file) {
+        prj_ttf_reader_clear_data(&data_file);
+        return 1;
+    }
+    close(fd);
+    for (i=0;i<TST_FONT_HANDLE_CHARACTERS;i++) {
+        list_characters[i] = 'A' + i;
+    }
+
+    if (test_font_write_file(file_name)) {
+        ret = 2;
+    } else if (prj_ttf_reader_open_font(file_name, &font) || !font) {
+        ret = 3;
+    } else if (tst_font_handle_generate(font, &data_font) || tst_font_handle_generate(font, &data_again)
+               || prj_ttf_reader_generate_glyphs_list_characters(list_characters, TST_FONT_HANDLE_CHARACTERS,
+                                                                 file_name, 24.0f, 5, data_file)) {
+        ret = 4;
+    } else if (data_font->list_data_count != TST_FONT_HANDLE_CHARACTERS
+               || !tst_font_handle_is_same_data(data_font, data_file)
+               || !tst_font_handle_is_same_data(data_font, data_again)) {
+        // font is parsed once and used by both calls
+        ret = 5;
+    } else if (prj_ttf_reader_get_kerning_font('A', 'B', 24.0f, font) != 0.0f) {
+        // font has no kern table
+        ret = 6;
+    }
+
+    prj_ttf_reader_close_font(&font);
+    if (font) {
+        ret = 7;
+    }
+    // closing the closed font does nothing
+    prj_ttf_reader_close_font(&font);
+    prj_ttf_reader_close_font(NULL);
+
+    unlink(file_name);
+    if (!ret && (!prj_ttf_reader_open_font(file_name, &font) || font)) {
+        ret = 8;
+    }
+    prj_ttf_reader_clear_data(&data_font);
+    prj_ttf_reader_clear_data(&data_again);
+    prj_ttf_reader_clear_data(&data_file);
+    return ret;
+}
+
+/*!
+ * \brief tst_font_handle_open_mmap_fallback
+ *
+ * tests that the font file is mapped with PRJ_TTF_READER_LOAD_MODE_MMAP
+ * and that it's read instead when mapping fails
+ *
+ * \return 0 on success
+ */
+int tst_font_handle_open_mmap_fallback()
+{
+    int ret = 0;
+    char file_name[] = "/tmp/tst_font_handle_XXXXXX";
+    prj_ttf_reader_font_t *font_mmap = NULL;
+    prj_ttf_reader_font_t *font_read = NULL;
+    prj_ttf_reader_data_t *data_mmap = NULL;
+    prj_ttf_reader_data_t *data_read = NULL;
+    struct stat file_stat;
+    int fd = mkstemp(file_name);
+
+    if (fd < 0) {
+        return 1;
+    }
+    close(fd);
+
+    if (test_font_write_file(file_name) || stat(file_name, &file_stat)) {
+        ret = 2;
+    } else if (prj_ttf_reader_open_font_mode(file_name, PRJ_TTF_READER_LOAD_MODE_MMAP, &font_mmap)
+               || font_mmap->file->data_owner != FONT_HANDLE_DATA_MMAP) {
+        ret = 3;
+    } else {
+        font_handle_map_file_fails = 1;
+        if (prj_ttf_reader_open_font_mode(file_name, PRJ_TTF_READER_LOAD_MODE_MMAP, &font_read)
+                || font_read->file->data_owner != FONT_HANDLE_DATA_MALLOC) {
+            ret = 4;
+        }
+        font_handle_map_file_fails = 0;
+    }
+
+    if (!ret && (font_mmap->file->file_stat.st_ino != file_stat.st_ino
+                 || font_read->file->file_stat.st_ino != file_stat.st_ino
+                 || font_read->file_data_size != (size_t)file_stat.st_size)) {
+        ret = 5;
+    } else if (!ret && (tst_font_handle_generate(font_mmap, &data_mmap) || tst_font_handle_generate(font_read, &data_read)
+                        || !tst_font_handle_is_same_data(data_mmap, data_read))) {
+        ret = 6;
+    }
+
+    prj_ttf_reader_close_font(&font_mmap);
+    prj_ttf_reader_close_font(&font_read);
+    prj_ttf_reader_clear_data(&data_mmap);
+    prj_ttf_reader_clear_data(&data_read);
+    unlink(file_name);
+    return ret;
+}
+
+/*!
+ * \brief tst_font_handle_open_memory_copy_borrow
+ *
+ * tests that the borrowed font data is used without copying and is
+ * not released on close, and that the copied font data is not needed
+ * after the font is opened
+ *
+ * \return 0 on success
+ */
+int tst_font_handle_open_memory_copy_borrow()
+{
+    int ret = 0;
+    uint8_t data[TEST_FONT_MAX_SIZE];
+    size_t data_size = test_font_write(data);
+    uint8_t *font_data = (uint8_t *)malloc(data_size);
+    prj_ttf_reader_font_t *font = NULL;
+    prj_ttf_reader_data_t *data_borrow = NULL;
+    prj_ttf_reader_data_t *data_copy = NULL;
+
+    if (!font_data) {
+        return 1;
+    }
+    memcpy(font_data, data, data_size);
+
+    if (prj_ttf_reader_open_font_memory(font_data, data_size, PRJ_TTF_READER_MEMORY_MODE_BORROW, &font)
+            || font->file_data != font_data || font->file->data_owner != FONT_HANDLE_DATA_BORROWED) {
+        ret = 2;
+    } else if (tst_font_handle_generate(font, &data_borrow)) {
+        ret = 3;
+    }
+    prj_ttf_reader_close_font(&font);
+    // borrowed data is not released or changed on close
+    if (!ret && memcmp(font_data, data, data_size)) {
+        ret = 4;
+    }
+
+    if (!ret && (prj_ttf_reader_open_font_memory(font_data, data_size, PRJ_TTF_READER_MEMORY_MODE_COPY, &font)
+                 || font->file_data == font_data || font->file->data_owner != FONT_HANDLE_DATA_MALLOC)) {
+        ret = 5;
+    }
+    // copied font doesn't use the data of the caller
+    free(font_data);
+    font_data = NULL;
+    if (!ret && (tst_font_handle_generate(font, &data_copy) || !tst_font_handle_is_same_data(data_borrow, data_copy))) {
+        ret = 6;
+    }
+    prj_ttf_reader_close_font(&font);
+
+    if (!ret && (prj_ttf_reader_open_font_memory(data, data_size, 2, &font) != EINVAL || font)) {
+        ret = 7;
+    }
+    prj_ttf_reader_clear_data(&data_borrow);
+    prj_ttf_reader_clear_data(&data_copy);
+    return ret;
+}
+
+/*!
+ * \brief tst_font_handle_lazy_tables
+ *
+ * tests that opening parses only head and maxp, that the other tables
+ * are parsed when the call needs them and that the error of the table
+ * is returned by the call that needs the table, also the next time
+ *
+ * \return 0 on success
+ */
+int tst_font_handle_lazy_tables()
+{
+    int ret = 0;
+    uint8_t data[TEST_FONT_MAX_SIZE];
+    size_t data_size = test_font_write(data);
+    size_t record = test_font_get_table_record(data, "hmtx");
+    prj_ttf_reader_font_t *font = NULL;
+    prj_ttf_reader_data_t *data_font = NULL;
+    const prj_ttf_reader_coverage_t *coverage = NULL;
+    const uint32_t generate_tables = FONT_HANDLE_TABLE_CMAP | FONT_HANDLE_TABLE_HHEA
+            | FONT_HANDLE_TABLE_HMTX | FONT_HANDLE_TABLE_LOCA;
+
+    if (prj_ttf_reader_open_font_memory(data, data_size, PRJ_TTF_READER_MEMORY_MODE_BORROW, &font)
+            || font->loaded_tables) {
+        ret = 1;
+    } else if (prj_ttf_reader_get_coverage_font(font, &coverage)
+               || !prj_ttf_reader_coverage_has_character(coverage, 'A')
+               || font->loaded_tables != (FONT_HANDLE_TABLE_CMAP | FONT_HANDLE_TABLE_COVERAGE)) {
+        // coverage needs only cmap
+        ret = 2;
+    } else if (tst_font_handle_generate(font, &data_font)
+               || (font->loaded_tables & generate_tables) != generate_tables
+               || (font->loaded_tables & FONT_HANDLE_TABLE_NAME)) {
+        ret = 3;
+    }
+    prj_ttf_reader_clear_data(&data_font);
+    prj_ttf_reader_close_font(&font);
+
+    // hmtx is shorter than the metrics of the glyphs, font is still opened
+    // and the coverage is built, generating returns the error
+    data[record + 15] = 2;
+    data[record + 14] = 0;
+    if (!ret && (prj_ttf_reader_open_font_memory(data, data_size, PRJ_TTF_READER_MEMORY_MODE_BORROW, &font)
+                 || prj_ttf_reader_get_coverage_font(font, &coverage))) {
+        ret = 4;
+    } else if (!ret && (!tst_font_handle_generate(font, &data_font)
+                        || !(font->failed_tables & FONT_HANDLE_TABLE_HMTX)
+                        || (font->loaded_tables & FONT_HANDLE_TABLE_HMTX))) {
+        ret = 5;
+    }
+    prj_ttf_reader_clear_data(&data_font);
+    // failed table is not parsed again
+    if (!ret && (font_handle_load_tables(font, FONT_HANDLE_TABLE_HMTX) != EINVAL || !tst_font_handle_generate(font, &data_font))) {
+        ret = 6;
+    }
+    prj_ttf_reader_clear_data(&data_font);
+    prj_ttf_reader_close_font(&font);
+    return ret;
+}
+
+/*!
+ * \brief tst_font_handle_options_shared
+ *
+ * tests that the options of the shared font can't be set, so one user
+ * can't change the glyphs of the other users, and that the options of
+ * the own font are copied into the generate call under the font lock
+ *
+ * \return 0 on success
+ */
+int tst_font_handle_options_shared()
+{
+    int ret = 0;
+    char file_name[] = "/tmp/tst_font_handle_XXXXXX";
+    prj_ttf_reader_font_t *font = NULL;
+    prj_ttf_reader_font_t *font_shared = NULL;
+    prj_ttf_reader_data_t *data_font = NULL;
+    prj_ttf_reader_data_t *data_shared = NULL;
+    font_generate_t generate;
+    int fd = mkstemp(file_name);
+
+    if (fd < 0) {
+        return 1;
+    }
+    close(fd);
+
+    if (test_font_write_file(file_name) || prj_ttf_reader_open_font(file_name, &font)
+            || prj_ttf_reader_open_font_shared(file_name, &font_shared)) {
+        ret = 2;
+    } else if (prj_ttf_reader_set_fill_mode_font(font_shared, PRJ_TTF_READER_FILL_MODE_SCANLINE) != EPERM
+               || prj_ttf_reader_set_max_glyph_memory_size_font(font_shared, 1) != EPERM
+               || prj_ttf_reader_set_thread_count_font(font_shared, 1) != EPERM) {
+        ret = 3;
+    } else if (prj_ttf_reader_set_fill_mode_font(font, PRJ_TTF_READER_FILL_MODE_TILED + 1) != EINVAL
+               || prj_ttf_reader_set_fill_mode_font(NULL, PRJ_TTF_READER_FILL_MODE_FLOOD) != EINVAL) {
+        ret = 4;
+    } else if (prj_ttf_reader_set_fill_mode_font(font, PRJ_TTF_READER_FILL_MODE_SCANLINE)
+               || prj_ttf_reader_set_max_glyph_memory_size_font(font, 1)
+               || prj_ttf_reader_set_thread_count_font(font, 2)) {
+        ret = 5;
+    }
+
+    if (!ret) {
+        // options of the shared font are still the defaults
+        font_handle_init_generate(font_shared, &generate);
+        if (generate.fill_mode != PRJ_TTF_READER_FILL_MODE_FLOOD || generate.max_glyph_memory_size
+                || generate.thread_count) {
+            ret = 6;
+        }
+        font_handle_clear_generate(&generate);
+    }
+    if (!ret) {
+        font_handle_init_generate(font, &generate);
+        if (generate.fill_mode != PRJ_TTF_READER_FILL_MODE_SCANLINE || generate.max_glyph_memory_size != 1
+                || generate.thread_count != 2) {
+            ret = 7;
+        }
+        font_handle_clear_generate(&generate);
+    }
+
+    // 1 byte canvas fails with the own font, the shared font is not limited
+    if (!ret && (tst_font_handle_generate(font, &data_font) != ENOMEM
+                 || tst_font_handle_generate(font_shared, &data_shared)
+                 || data_shared->list_data_count != TST_FONT_HANDLE_CHARACTERS)) {
+        ret = 8;
+    }
+
+    prj_ttf_reader_close_font(&font);
+    prj_ttf_reader_close_font(&font_shared);
+    prj_ttf_reader_clear_data(&data_font);
+    prj_ttf_reader_clear_data(&data_shared);
+    unlink(file_name);
+    return ret;
+}
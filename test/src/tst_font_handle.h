@@ -0,0 +1,21 @@
+/*!
+ * \file
+ * \brief file tst_font_handle.h
+ *
+ * test font_handle.c sources and the font functions of prj-ttf-reader.c
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_FONT_HANDLE_H
+#define TST_FONT_HANDLE_H
+
+int tst_font_handle_open_close();
+int tst_font_handle_open_mmap_fallback();
+int tst_font_handle_open_memory_copy_borrow();
+int tst_font_handle_lazy_tables();
+int tst_font_handle_options_shared();
+
+#endif // TST_FONT_HANDLE_H
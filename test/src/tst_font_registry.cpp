@@ -0,0 +1,237 @@
+/*!
+ * \file
+ * \brief file tst_font_registry.cpp
+ *
+ * test font_registry.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_font_registry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "../../lib/src/font_registry.h"
+#include "../../lib/src/font_handle.h"
+
+/*!
+ * \brief size of the font of tst_font_registry_write_font()
+ */
+#define TST_FONT_REGISTRY_FONT_SIZE     104
+
+/*!
+ * \brief The tst_font_registry_thread_t struct
+ *
+ * font_registry_acquire() call of single thread
+ */
+typedef struct
+{
+    pthread_t thread;
+    const char *file_name;
+    prj_ttf_reader_font_t *font;
+    int ret;
+} tst_font_registry_thread_t;
+
+/*!
+ * \brief tst_font_registry_write_font
+ *
+ * writes the smallest font that can be opened: offset table
+ * with head (54 bytes) and maxp (version 0.5) tables
+ *
+ * \param file_name
+ * \param glyphs_count glyphs count of maxp
+ * \return 0 on success
+ */
+static int tst_font_registry_write_font(const char *file_name, uint8_t glyphs_count)
+{
+    uint8_t data[TST_FONT_REGISTRY_FONT_SIZE];
+    const uint8_t header[44] = { 0, 1, 0, 0, 0, 2, 0, 32, 0, 1, 0, 0,
+                                 'h', 'e', 'a', 'd', 0, 0, 0, 0, 0, 0, 0, 44, 0, 0, 0, 54,
+                                 'm', 'a', 'x', 'p', 0, 0, 0, 0, 0, 0, 0, 98, 0, 0, 0, 6 };
+    const uint8_t maxp[6] = { 0, 0, 0x50, 0, 0, glyphs_count };
+    FILE *fp;
+    size_t written;
+
+    memset(data, 0, sizeof(data));
+    memcpy(data, header, sizeof(header));
+    // units per em of head
+    data[44 + 19] = 64;
+    memcpy(&data[98], maxp, sizeof(maxp));
+
+    fp = fopen(file_name, "wb");
+    if (!fp) {
+        return 1;
+    }
+    written = fwrite(data, 1, sizeof(data), fp);
+    fclose(fp);
+    return written == sizeof(data) ? 0 : 1;
+}
+
+/*!
+ * \brief tst_font_registry_acquire_release
+ *
+ * tests that the same unchanged font file is shared, that
+ * the changed font file is opened again while the old font
+ * is kept for its users and that the read font is not
+ * changed when the font file is rewritten
+ *
+ * \return 0 on success
+ */
+int tst_font_registry_acquire_release()
+{
+    int ret = 0;
+    char file_name[] = "/tmp/tst_font_registry_XXXXXX";
+    char new_file_name[sizeof(file_name) + 4];
+    prj_ttf_reader_font_t *font_a = NULL;
+    prj_ttf_reader_font_t *font_b = NULL;
+    prj_ttf_reader_font_t *font_mmap = NULL;
+    prj_ttf_reader_font_t *font_new = NULL;
+    int fd = mkstemp(file_name);
+
+    if (fd < 0) {
+        return 1;
+    }
+    close(fd);
+    snprintf(new_file_name, sizeof(new_file_name), "%s.new", file_name);
+
+    if (tst_font_registry_write_font(file_name, 1)) {
+        unlink(file_name);
+        return 2;
+    }
+
+    if (font_registry_acquire(file_name, 0, PRJ_TTF_READER_LOAD_MODE_READ, &font_a)
+            || font_registry_acquire(file_name, 0, PRJ_TTF_READER_LOAD_MODE_READ, &font_b)) {
+        ret = 3;
+    } else if (font_a != font_b || font_a->ref_count != 2 || !font_a->is_shared
+               || font_a->file->data_owner != FONT_HANDLE_DATA_MALLOC) {
+        ret = 4;
+    } else if (font_registry_acquire(file_name, 0, PRJ_TTF_READER_LOAD_MODE_MMAP, &font_mmap)
+               || font_mmap == font_a) {
+        // mapped font is not shared with the read font
+        ret = 5;
+    } else if (!font_registry_acquire(file_name, 1, PRJ_TTF_READER_LOAD_MODE_READ, &font_new) || font_new) {
+        // font is not a collection
+        ret = 6;
+    } else if (tst_font_registry_write_font(new_file_name, 2) || rename(new_file_name, file_name)) {
+        ret = 7;
+    } else if (font_registry_acquire(file_name, 0, PRJ_TTF_READER_LOAD_MODE_READ, &font_new)
+               || font_new == font_a || font_new->tables.max_profile.glyphs_count != 2) {
+        // replaced font file is opened again
+        ret = 8;
+    } else if (font_a->tables.max_profile.glyphs_count != 1 || font_a->ref_count != 2
+               || font_a->file_data[TST_FONT_REGISTRY_FONT_SIZE - 1] != 1) {
+        ret = 9;
+    } else if (tst_font_registry_write_font(file_name, 3)
+               || font_a->file_data[TST_FONT_REGISTRY_FONT_SIZE - 1] != 1
+               || font_new->file_data[TST_FONT_REGISTRY_FONT_SIZE - 1] != 2) {
+        // read fonts keep their own copy when the font file is rewritten
+        ret = 10;
+    }
+
+    font_registry_release(&font_b);
+    if (font_b || (font_a && font_a->ref_count != 1)) {
+        ret = 11;
+    }
+    font_registry_release(&font_a);
+    font_registry_release(&font_mmap);
+    font_registry_release(&font_new);
+    if (font_a || font_mmap || font_new) {
+        ret = 12;
+    }
+
+    // released font is not kept in the registry
+    if (!ret && (font_registry_acquire(file_name, 0, PRJ_TTF_READER_LOAD_MODE_READ, &font_a)
+                 || font_a->ref_count != 1 || font_a->tables.max_profile.glyphs_count != 3)) {
+        ret = 13;
+    }
+    font_registry_release(&font_a);
+
+    unlink(file_name);
+    if (!font_registry_acquire(file_name, 0, PRJ_TTF_READER_LOAD_MODE_READ, &font_a) || font_a) {
+        ret = 14;
+    }
+    return ret;
+}
+
+/*!
+ * \brief count of the threads of tst_font_registry_acquire_threads()
+ */
+#define TST_FONT_REGISTRY_THREAD_COUNT  4
+
+/*!
+ * \brief tst_font_registry_acquire_thread
+ *
+ * \param arg font_registry_acquire() parameters, file name and the font
+ * \return NULL
+ */
+static void *tst_font_registry_acquire_thread(void *arg)
+{
+    tst_font_registry_thread_t *thread = (tst_font_registry_thread_t *)arg;
+    thread->ret = font_registry_acquire(thread->file_name, 0, PRJ_TTF_READER_LOAD_MODE_READ, &thread->font);
+    return NULL;
+}
+
+/*!
+ * \brief tst_font_registry_acquire_threads
+ *
+ * tests that the font that is opened by many threads at the
+ * same time is shared and that it's keyed with the stat of
+ * the opened font file
+ *
+ * \return 0 on success
+ */
+int tst_font_registry_acquire_threads()
+{
+    int ret = 0;
+    uint32_t i;
+    char file_name[] = "/tmp/tst_font_registry_XXXXXX";
+    tst_font_registry_thread_t list_thread[TST_FONT_REGISTRY_THREAD_COUNT];
+    struct stat file_stat;
+    int fd = mkstemp(file_name);
+
+    if (fd < 0) {
+        return 1;
+    }
+    close(fd);
+    if (tst_font_registry_write_font(file_name, 1) || stat(file_name, &file_stat)) {
+        unlink(file_name);
+        return 2;
+    }
+
+    memset(list_thread, 0, sizeof(list_thread));
+    for (i=0;i<TST_FONT_REGISTRY_THREAD_COUNT;i++) {
+        list_thread[i].file_name = file_name;
+        if (pthread_create(&list_thread[i].thread, NULL, tst_font_registry_acquire_thread, &list_thread[i])) {
+            ret = 3;
+            break;
+        }
+    }
+    while (i > 0) {
+        i--;
+        pthread_join(list_thread[i].thread, NULL);
+    }
+
+    for (i=0;!ret && i<TST_FONT_REGISTRY_THREAD_COUNT;i++) {
+        if (list_thread[i].ret) {
+            ret = 4;
+        } else if (list_thread[i].font != list_thread[0].font) {
+            ret = 5;
+        }
+    }
+    if (!ret && (list_thread[0].font->ref_count != TST_FONT_REGISTRY_THREAD_COUNT
+                 || list_thread[0].font->file->file_stat.st_ino != file_stat.st_ino
+                 || list_thread[0].font->file->file_stat.st_size != TST_FONT_REGISTRY_FONT_SIZE)) {
+        ret = 6;
+    }
+
+    for (i=0;i<TST_FONT_REGISTRY_THREAD_COUNT;i++) {
+        font_registry_release(&list_thread[i].font);
+    }
+    unlink(file_name);
+    return ret;
+}
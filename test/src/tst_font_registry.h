@@ -0,0 +1,18 @@
+/*!
+ * \file
+ * \brief file tst_font_registry.h
+ *
+ * test font_registry.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_FONT_REGISTRY_H
+#define TST_FONT_REGISTRY_H
+
+int tst_font_registry_acquire_release();
+int tst_font_registry_acquire_threads();
+
+#endif // TST_FONT_REGISTRY_H
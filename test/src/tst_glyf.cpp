@@ -0,0 +1,154 @@
+/*!
+ * \file
+ * \brief file tst_glyf.cpp
+ *
+ * test glyf.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_glyf.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "../../lib/src/reader/glyf.h"
+
+int glyf_parse_flags(const uint8_t *data, size_t data_size, uint8_t *list_flags, uint16_t num_points, size_t *offset);
+int glyf_parse_point_scalar(const uint8_t *data, size_t data_size, const uint8_t *listFlags, int16_t *listPoint,
+                            uint16_t first_point, uint16_t num_points, size_t *offset, uint8_t x);
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+int glyf_parse_point_ssse3(const uint8_t *data, size_t data_size, const uint8_t *listFlags, int16_t *listPoint,
+                           uint16_t num_points, size_t *offset, uint8_t x);
+#endif
+
+/*!
+ * \brief tst_glyf_parse_flags_and_points
+ *
+ * tests that repeated flags are expanded, and SSSE3 parsing of
+ * the points gives same points, offset and return value than
+ * parsing of the points one by one
+ *
+ * \return 0 on success
+ */
+int tst_glyf_parse_flags_and_points()
+{
+    int i, j;
+    uint16_t num_points;
+    size_t data_size;
+    size_t offset_scalar, offset_ssse3;
+    int ret_scalar, ret_ssse3;
+    uint8_t list_flags[300];
+    int16_t list_point_scalar[300];
+    int16_t list_point_ssse3[300];
+    uint8_t data[700];
+    const uint8_t flags_data[] = { ON_CURVE_POINT, REPEAT_FLAG | X_SHORT_VECTOR, 2, Y_SHORT_VECTOR, REPEAT_FLAG, 10 };
+    size_t offset = 0;
+
+    // flag, flag repeated 2 times, flag, last repeat is longer than points
+    if (glyf_parse_flags(flags_data, sizeof(flags_data), list_flags, 7, &offset) || offset != 6
+            || list_flags[0] != ON_CURVE_POINT || list_flags[1] != (REPEAT_FLAG | X_SHORT_VECTOR)
+            || list_flags[3] != (REPEAT_FLAG | X_SHORT_VECTOR) || list_flags[4] != Y_SHORT_VECTOR
+            || list_flags[5] != REPEAT_FLAG || list_flags[6] != REPEAT_FLAG) {
+        return 1;
+    }
+    offset = 0;
+    if (glyf_parse_flags(flags_data, 2, list_flags, 7, &offset) != EIO) {
+        return 2;
+    }
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (!__builtin_cpu_supports("ssse3")) {
+        return 0;
+    }
+
+    srand(1);
+    for (i=0;i<1000;i++) {
+        num_points = (uint16_t)(1 + rand() % 300);
+        for (j=0;j<num_points;j++) {
+            list_flags[j] = (uint8_t)rand();
+        }
+        // data is too short sometimes
+        data_size = (size_t)(rand() % 700);
+        for (j=0;j<(int)data_size;j++) {
+            data[j] = (uint8_t)rand();
+        }
+        memset(list_point_scalar, 0, sizeof(list_point_scalar));
+        memset(list_point_ssse3, 0, sizeof(list_point_ssse3));
+        offset_scalar = offset_ssse3 = (size_t)(rand() % 4);
+
+        ret_scalar = glyf_parse_point_scalar(data, data_size, list_flags, list_point_scalar, 0, num_points, &offset_scalar, (uint8_t)(i%2));
+        ret_ssse3 = glyf_parse_point_ssse3(data, data_size, list_flags, list_point_ssse3, num_points, &offset_ssse3, (uint8_t)(i%2));
+        if (ret_scalar != ret_ssse3 || offset_scalar != offset_ssse3
+                || memcmp(list_point_scalar, list_point_ssse3, sizeof(list_point_scalar))) {
+            return 3;
+        }
+    }
+#endif
+    return 0;
+}
+
+/*!
+ * \brief tst_glyf_outline_iterator_closed
+ *
+ * curves that are not repeated form closed contours,
+ * first contour starts with two off-curve points and
+ * the second contour has on-curve points only
+ *
+ * \return 0 on success
+ */
+int tst_glyf_outline_iterator_closed()
+{
+    int count = 0;
+    float start_x = 0;
+    float start_y = 0;
+    float end_x = 0;
+    float end_y = 0;
+    glyph_curve_t curve;
+    glyf_outline_iterator_t iterator;
+    glyph_outline_t outline;
+    int16_t list_point_x[] = { 0, 0, 10, 20, 20, 10, 30, 40, 40 };
+    int16_t list_point_y[] = { 10, 0, 0, 0, 10, 20, 0, 0, 10 };
+    uint8_t list_flags[] = { 0, 0, ON_CURVE_POINT, 0, 0, ON_CURVE_POINT,
+                             ON_CURVE_POINT, ON_CURVE_POINT, ON_CURVE_POINT };
+    uint16_t list_end_points[] = { 5, 8 };
+
+    memset(&outline, 0, sizeof(outline));
+    outline.list_point_x = list_point_x;
+    outline.list_point_y = list_point_y;
+    outline.list_flags = list_flags;
+    outline.list_end_points = list_end_points;
+    outline.point_count = 9;
+    outline.contour_count = 2;
+
+    glyf_outline_iterator_init(&iterator, &outline);
+    while (glyf_outline_iterator_next(&iterator, &curve)) {
+        if (curve.is_repeated) {
+            continue;
+        }
+        if (count == 0 || (curve.x0 != end_x || curve.y0 != end_y)) {
+            // previous contour must be closed before the next one starts
+            if (count && (end_x != start_x || end_y != start_y)) {
+                return 1;
+            }
+            start_x = curve.x0;
+            start_y = curve.y0;
+        }
+        if (curve.x0 == curve.x1 && curve.y0 == curve.y1) {
+            return 2;
+        }
+        end_x = curve.x1;
+        end_y = curve.y1;
+        count++;
+    }
+    if (end_x != start_x || end_y != start_y) {
+        return 3;
+    }
+    // 4 curves of the first contour and 3 lines of the second one
+    if (count != 7) {
+        return 4;
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+/*!
+ * \file
+ * \brief file tst_glyf.h
+ *
+ * test glyf.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_GLYF_H
+#define TST_GLYF_H
+
+int tst_glyf_parse_flags_and_points();
+int tst_glyf_outline_iterator_closed();
+
+#endif // TST_GLYF_H
@@ -0,0 +1,100 @@
+/*!
+ * \file
+ * \brief file tst_glyph_area.cpp
+ *
+ * test glyph_area.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_glyph_area.h"
+#include <string.h>
+#include <math.h>
+#include "../../lib/src/drawfont/glyph_area.h"
+
+/*!
+ * \brief tst_glyph_area_is_coverage
+ * \param area
+ * \param x
+ * \param y
+ * \param coverage expected coverage
+ * \return true if coverage of x/y is the expected
+ */
+static bool tst_glyph_area_is_coverage(const glyph_area_t *area, int x, int y, float coverage)
+{
+    return fabsf(area->list_area[y*area->width+x] - coverage) <= 0.001f;
+}
+
+/*!
+ * \brief tst_glyph_area_coverage
+ *
+ * tests that the coverage of the pixels is the exact covered area
+ * of the square that is not aligned to the pixels, that the
+ * coverage of the diagonal line is the half of the pixel and that
+ * the sum of the coverage is the area of the curve
+ *
+ * \return 0 on success
+ */
+int tst_glyph_area_coverage()
+{
+    int ret = 0;
+    int i;
+    float sum;
+    glyph_area_t area;
+    arena_t arena;
+
+    memset(&arena, 0, sizeof(arena));
+
+    // square 1.5 - 4.5, counter-clockwise
+    if (glyph_area_init(&area, 6, 6, &arena)) {
+        arena_clear(&arena);
+        return 1;
+    }
+    glyph_area_add_line(&area, 1.5f, 1.5f, 4.5f, 1.5f);
+    glyph_area_add_line(&area, 4.5f, 1.5f, 4.5f, 4.5f);
+    glyph_area_add_line(&area, 4.5f, 4.5f, 1.5f, 4.5f);
+    glyph_area_add_line(&area, 1.5f, 4.5f, 1.5f, 1.5f);
+    glyph_area_accumulate(&area);
+    if (!tst_glyph_area_is_coverage(&area, 1, 1, 0.25f)
+            || !tst_glyph_area_is_coverage(&area, 2, 1, 0.5f)
+            || !tst_glyph_area_is_coverage(&area, 4, 4, 0.25f)
+            || !tst_glyph_area_is_coverage(&area, 2, 2, 1.0f)
+            || !tst_glyph_area_is_coverage(&area, 3, 3, 1.0f)
+            || !tst_glyph_area_is_coverage(&area, 0, 2, 0.0f)
+            || !tst_glyph_area_is_coverage(&area, 5, 2, 0.0f)) {
+        ret = 2;
+    }
+
+    // triangle, pixels of the diagonal line are half covered
+    arena_reset(&arena);
+    glyph_area_init(&area, 6, 6, &arena);
+    glyph_area_add_line(&area, 1.0f, 1.0f, 5.0f, 1.0f);
+    glyph_area_add_line(&area, 5.0f, 1.0f, 5.0f, 5.0f);
+    glyph_area_add_line(&area, 5.0f, 5.0f, 1.0f, 1.0f);
+    glyph_area_accumulate(&area);
+    if (!tst_glyph_area_is_coverage(&area, 1, 1, 0.5f)
+            || !tst_glyph_area_is_coverage(&area, 3, 3, 0.5f)
+            || !tst_glyph_area_is_coverage(&area, 4, 1, 1.0f)
+            || !tst_glyph_area_is_coverage(&area, 1, 3, 0.0f)) {
+        ret = 3;
+    }
+
+    // curve and line, area is 2/3*16*8 (lines of the curve are inside of the curve)
+    arena_reset(&arena);
+    glyph_area_init(&area, 20, 20, &arena);
+    glyph_area_add_curve(&area, 2.0f, 2.0f, 18.0f, 2.0f, 10.0f, 18.0f);
+    glyph_area_add_line(&area, 18.0f, 2.0f, 2.0f, 2.0f);
+    glyph_area_accumulate(&area);
+    sum = 0;
+    for (i=0;i<area.width*area.height;i++) {
+        sum += area.list_area[i];
+    }
+    if (fabsf(sum - 2.0f/3.0f*16.0f*8.0f) > 1.5f) {
+        ret = 4;
+    }
+
+    arena_clear(&arena);
+    return ret;
+}
@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_glyph_area.h
+ *
+ * test glyph_area.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_GLYPH_AREA_H
+#define TST_GLYPH_AREA_H
+
+int tst_glyph_area_coverage();
+
+#endif // TST_GLYPH_AREA_H
@@ -0,0 +1,147 @@
+/*!
+ * \file
+ * \brief file tst_glyph_cache.cpp
+ *
+ * test glyph_cache.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_glyph_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../lib/src/glyph_cache.h"
+
+/*!
+ * \brief tst_glyph_cache_lru
+ *
+ * tests that glyph_cache copies the outlines, evicts the least
+ * recently used glyph and keeps the glyphs that are in use
+ *
+ * \return 0 on success
+ */
+int tst_glyph_cache_lru()
+{
+    int ret = 0;
+    uint16_t i;
+    glyph_cache_t cache;
+    glyph_t list_glyph[4];
+    glyph_component_t component;
+    int16_t list_point_x[3][3];
+    int16_t list_point_y[3][3];
+    uint8_t list_flags[3] = { ON_CURVE_POINT, 0, ON_CURVE_POINT };
+    uint16_t end_point = 2;
+    glyf_outline_iterator_t iterator;
+    glyph_curve_t curve;
+    const glyph_t *cached[3];
+    prj_ttf_reader_glyph_cache_stats_t stats;
+    const size_t entry_size = sizeof(glyph_cache_entry_t) + sizeof(uint16_t) + (sizeof(int16_t)*2 + sizeof(uint8_t))*3;
+
+    memset(list_glyph, 0, sizeof(list_glyph));
+    for (i=0;i<3;i++) {
+        list_point_x[i][0] = 0;
+        list_point_y[i][0] = 0;
+        list_point_x[i][1] = (int16_t)i;
+        list_point_y[i][1] = (int16_t)(i+10);
+        list_point_x[i][2] = 20;
+        list_point_y[i][2] = 0;
+        list_glyph[i].glyph_index = i;
+        list_glyph[i].max_x = (int16_t)(i+100);
+        list_glyph[i].outline.list_point_x = list_point_x[i];
+        list_glyph[i].outline.list_point_y = list_point_y[i];
+        list_glyph[i].outline.list_flags = list_flags;
+        list_glyph[i].outline.list_end_points = &end_point;
+        list_glyph[i].outline.point_count = 3;
+        list_glyph[i].outline.contour_count = 1;
+    }
+
+    // room for two glyphs
+    glyph_cache_init(&cache, 4, entry_size*2);
+
+    cached[0] = glyph_cache_insert(&cache, &list_glyph[0]);
+    cached[1] = glyph_cache_insert(&cache, &list_glyph[1]);
+    if (!cached[0] || !cached[1] || cached[0] == &list_glyph[0]) {
+        glyph_cache_clear(&cache);
+        return 1;
+    }
+    // first curve of the outline is from on curve point 0 to point 2 through off curve point 1,
+    // off curve point 1 generates the same curve again
+    glyf_outline_iterator_init(&iterator, &cached[1]->outline);
+    if (cached[1]->max_x != 101 || cached[1]->outline.contour_count != 1
+            || cached[1]->outline.list_point_x == list_point_x[1]
+            || !glyf_outline_iterator_next(&iterator, &curve)
+            || !curve.is_curve || curve.is_repeated || curve.curve_x != 1.0f || curve.curve_y != 11.0f || curve.x1 != 20.0f
+            || !glyf_outline_iterator_next(&iterator, &curve)
+            || !curve.is_curve || !curve.is_repeated || curve.x0 != 0.0f || curve.x1 != 20.0f) {
+        ret = 2;
+    }
+    glyph_cache_release(&cache, cached[0]);
+    glyph_cache_release(&cache, cached[1]);
+
+    // glyph 0 becomes most recently used, so glyph 1 is evicted
+    if (glyph_cache_acquire(&cache, 0) != cached[0]) {
+        ret = 3;
+    }
+    glyph_cache_release(&cache, cached[0]);
+    cached[2] = glyph_cache_insert(&cache, &list_glyph[2]);
+    if (!cached[2] || glyph_cache_acquire(&cache, 1)) {
+        ret = 4;
+    }
+
+    // glyph 2 is in use, it's not evicted even if cache is too small
+    glyph_cache_set_max_memory_size(&cache, entry_size/2);
+    glyph_cache_get_stats(&cache, &stats);
+    if (stats.glyph_count != 1 || stats.memory_size != entry_size) {
+        ret = 5;
+    }
+    glyph_cache_release(&cache, cached[2]);
+
+    glyph_cache_get_stats(&cache, &stats);
+    if (stats.hit_count != 1 || stats.miss_count != 1 || stats.eviction_count != 3
+            || stats.glyph_count != 0 || stats.memory_size != 0) {
+        ret = 6;
+    }
+
+    // composite glyph keeps its component in the cache and
+    // the transformation is applied when the curves are generated
+    memset(&component, 0, sizeof(component));
+    component.glyph_index = 0;
+    component.glyph = &list_glyph[0];
+    component.transformation[0] = 1.0f;
+    component.transformation[3] = 1.0f;
+    component.transformation[4] = 5.0f;
+    list_glyph[3].glyph_index = 3;
+    list_glyph[3].num_contours = -1;
+    list_glyph[3].outline.list_component = &component;
+    list_glyph[3].outline.component_count = 1;
+    list_glyph[3].outline.component_depth = 1;
+    glyph_cache_set_max_memory_size(&cache, entry_size*4);
+    cached[0] = glyph_cache_insert(&cache, &list_glyph[3]);
+    glyph_cache_get_stats(&cache, &stats);
+    if (!cached[0] || stats.glyph_count != 2
+            || cached[0]->outline.list_component[0].glyph == &list_glyph[0]) {
+        ret = 8;
+    } else {
+        glyf_outline_iterator_init(&iterator, &cached[0]->outline);
+        if (!glyf_outline_iterator_next(&iterator, &curve) || curve.x0 != 5.0f || curve.x1 != 25.0f) {
+            ret = 9;
+        }
+        glyph_cache_release(&cache, cached[0]);
+    }
+
+    // component is evicted only with the composite glyph
+    glyph_cache_set_max_memory_size(&cache, 1);
+    glyph_cache_get_stats(&cache, &stats);
+    if (stats.glyph_count != 0 || stats.memory_size != 0) {
+        ret = 10;
+    }
+
+    glyph_cache_clear(&cache);
+    if (cache.list_entry || cache.first) {
+        ret = 7;
+    }
+    return ret;
+}
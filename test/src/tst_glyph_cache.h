@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_glyph_cache.h
+ *
+ * test glyph_cache.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_GLYPH_CACHE_H
+#define TST_GLYPH_CACHE_H
+
+int tst_glyph_cache_lru();
+
+#endif // TST_GLYPH_CACHE_H
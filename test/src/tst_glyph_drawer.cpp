@@ -10,7 +10,9 @@
 */
 #include <dirent.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include "tst_glyph_drawer.h"
 #include "../../lib/src/drawfont/glyph_drawer.h"
 #include "../../lib/src/drawfont/glyph_filler.h"
@@ -28,7 +30,7 @@ void tst_set_min_max_font_drawing_values(font_drawing_t *drawer)
     int x, y;
     for (x=0;x<drawer->width;x++) {
         for (y=0;y<drawer->height;y++) {
-            if (drawer->list_pixels[y*drawer->width+x].line) {
+            if (GLYPH_DRAWER_GET(drawer, GLYPH_DRAWER_PLANE_LINE, x, y)) {
                 if (!drawer->line_max_x && !drawer->line_max_y) {
                     drawer->line_min_x = x;
                     drawer->line_max_x = x;
@@ -96,10 +98,12 @@ int tst_fillInnerAreaInImageFilesRotate(LoadTestImageRotation rotation)
             }
 
             memset(&drawer, 0, sizeof(drawer));
-            glyph_drawer_init(&drawer, static_cast<int>(width), static_cast<int>(height));
+            glyph_drawer_init(&drawer, static_cast<int>(width), static_cast<int>(height), NULL);
             for (x=0;x<width;x++) {
                 for (y=0;y<height;y++) {
-                    drawer.list_pixels[y*drawer.width+x].line = test_getpixel_drawing(x, y, width, pixelsCorrect)->line;
+                    if (test_getpixel_drawing(x, y, width, pixelsCorrect)->line) {
+                        GLYPH_DRAWER_SET(&drawer, GLYPH_DRAWER_PLANE_LINE, static_cast<int>(x), static_cast<int>(y));
+                    }
                 }
             }
 
@@ -108,12 +112,12 @@ int tst_fillInnerAreaInImageFilesRotate(LoadTestImageRotation rotation)
 
             for (x=0;x<width;x++) {
                 for (y=0;y<height;y++) {
-                    if (drawer.list_pixels[y*drawer.width+x].line != test_getpixel_drawing(x, y, width, pixelsCorrect)->line) {
+                    if (glyph_drawer_get_pixel(&drawer, static_cast<int>(x), static_cast<int>(y)).line != test_getpixel_drawing(x, y, width, pixelsCorrect)->line) {
                         clear_pixel_list(&pixelsCorrect);
                         delete[] fileName;
                         return 1;
                     }
-                    if (drawer.list_pixels[y*drawer.width+x].inner_pixel != test_getpixel_drawing(x, y, width, pixelsCorrect)->inner_pixel) {
+                    if (glyph_drawer_get_pixel(&drawer, static_cast<int>(x), static_cast<int>(y)).inner_pixel != test_getpixel_drawing(x, y, width, pixelsCorrect)->inner_pixel) {
                         clear_pixel_list(&pixelsCorrect);
                         delete[] fileName;
                         return 2;
@@ -168,3 +172,187 @@ int tst_fillInnerAreaInImageFiles()
     return ret;
 }
 
+
+/*!
+ * \brief tst_glyph_drawer_paint_curve
+ *
+ * curve is drawn from the start point to the end point
+ * through the middle point of the curve
+ *
+ * \return 0 on success
+ */
+int tst_glyph_drawer_paint_curve()
+{
+    font_drawing_t drawing;
+
+    memset(&drawing, 0, sizeof(drawing));
+    if (glyph_drawer_init(&drawing, 40, 40, NULL)) {
+        return 1;
+    }
+    if (glyph_drawer_paint_curve(2, 2, 37, 2, 20, 37, 0.5f, &drawing, 1)) {
+        glyph_drawer_clear(&drawing);
+        return 2;
+    }
+    // middle point of the curve is 19.75/19.5
+    if (!GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, 2, 2)
+            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, 37, 2)
+            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, 19, 19)
+            || GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, 19, 21)) {
+        glyph_drawer_clear(&drawing);
+        return 3;
+    }
+    // single path never crosses itself
+    if (glyph_drawer_get_pixel(&drawing, 19, 19).line != 1) {
+        glyph_drawer_clear(&drawing);
+        return 4;
+    }
+    glyph_drawer_clear(&drawing);
+    return 0;
+}
+
+/*!
+ * \brief tst_glyph_drawer_draw_line
+ *
+ * lines of every direction have single pixel in each step
+ * of the longer axis, both end points and the area of the end points
+ *
+ * \return 0 on success
+ */
+int tst_glyph_drawer_draw_line()
+{
+    font_drawing_t drawing;
+    int x0, y0, x1, y1;
+    int x, y, count;
+    int length;
+
+    for (x0=0;x0<8;x0++) {
+        for (y0=0;y0<8;y0++) {
+            for (x1=0;x1<8;x1++) {
+                for (y1=0;y1<8;y1++) {
+                    memset(&drawing, 0, sizeof(drawing));
+                    if (glyph_drawer_init(&drawing, 8, 8, NULL)) {
+                        return 1;
+                    }
+                    // area of the first line is set, so (0, 0) must not be first point
+                    drawing.line_max_x = 8;
+                    drawing.line_max_y = 8;
+                    drawing.line_min_x = 8;
+                    drawing.line_min_y = 8;
+                    glyph_drawer_draw_line(x0, y0, x1, y1, &drawing, 1);
+
+                    count = 0;
+                    for (y=0;y<8;y++) {
+                        for (x=0;x<8;x++) {
+                            count += GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, x, y);
+                        }
+                    }
+                    length = abs(x1 - x0) > abs(y1 - y0) ? abs(x1 - x0) : abs(y1 - y0);
+                    if (count != length + 1
+                            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, x0, y0)
+                            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, x1, y1)
+                            || drawing.line_min_x != (x0 < x1 ? x0 : x1)
+                            || drawing.line_min_y != (y0 < y1 ? y0 : y1)) {
+                        glyph_drawer_clear(&drawing);
+                        return 2;
+                    }
+                    glyph_drawer_clear(&drawing);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*!
+ * \brief tst_glyph_drawer_pool
+ *
+ * buffers of the pool are reused for smaller drawing
+ * and they are zero after glyph_drawer_clear(), buffers
+ * don't exceed the max memory size of the pool
+ *
+ * \return 0 on success
+ */
+int tst_glyph_drawer_pool()
+{
+    font_drawing_t drawing;
+    glyph_drawer_pool_t pool;
+    glyph_memory_t memory;
+    uint64_t *list_plane;
+    size_t i;
+
+    memset(&pool, 0, sizeof(pool));
+    memset(&drawing, 0, sizeof(drawing));
+    if (glyph_drawer_init(&drawing, 100, 40, &pool)) {
+        glyph_drawer_pool_clear(&pool);
+        return 1;
+    }
+    glyph_drawer_draw_line(3, 30, 90, 5, &drawing, 1);
+    glyph_drawer_clear(&drawing);
+    list_plane = pool.list_plane;
+    for (i=0;i<pool.list_plane_size;i++) {
+        if (pool.list_plane[i]) {
+            glyph_drawer_pool_clear(&pool);
+            return 2;
+        }
+    }
+    for (i=0;i<pool.list_path_index_size;i++) {
+        if (pool.list_path_index[i].key) {
+            glyph_drawer_pool_clear(&pool);
+            return 3;
+        }
+    }
+
+    if (glyph_drawer_init(&drawing, 60, 30, &pool)) {
+        glyph_drawer_pool_clear(&pool);
+        return 4;
+    }
+    if (drawing.list_plane[0] != list_plane
+            || GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_LINE, 10, 10)) {
+        glyph_drawer_clear(&drawing);
+        glyph_drawer_pool_clear(&pool);
+        return 5;
+    }
+    glyph_drawer_clear(&drawing);
+    glyph_drawer_pool_clear(&pool);
+
+    // planes are not doubled when it would exceed the max memory size
+    memory.memory_size = 0;
+    // initial path index table and 141 words of planes
+    memory.max_memory_size = 1024*sizeof(glyph_drawer_path_index_t) + 141*sizeof(uint64_t) + 4;
+    pool.memory = &memory;
+    if (glyph_drawer_init(&drawing, 64, 10, &pool)) {
+        glyph_drawer_pool_clear(&pool);
+        return 6;
+    }
+    glyph_drawer_clear(&drawing);
+    if (glyph_drawer_init(&drawing, 64, 20, &pool) || pool.list_plane_size != 141) {
+        glyph_drawer_clear(&drawing);
+        glyph_drawer_pool_clear(&pool);
+        return 7;
+    }
+    glyph_drawer_clear(&drawing);
+    if (glyph_drawer_init(&drawing, 64, 30, &pool) != ENOMEM) {
+        glyph_drawer_clear(&drawing);
+        glyph_drawer_pool_clear(&pool);
+        return 8;
+    }
+    glyph_drawer_clear(&drawing);
+
+    // path index table can't be doubled for the 600 line pixels
+    memory.max_memory_size = memory.memory_size + 141*sizeof(uint64_t);
+    if (glyph_drawer_init(&drawing, 600, 2, &pool)) {
+        glyph_drawer_pool_clear(&pool);
+        return 9;
+    }
+    if (glyph_drawer_draw_line(0, 0, 599, 0, &drawing, 1) != ENOMEM) {
+        glyph_drawer_clear(&drawing);
+        glyph_drawer_pool_clear(&pool);
+        return 10;
+    }
+    glyph_drawer_clear(&drawing);
+    glyph_drawer_pool_clear(&pool);
+    if (memory.memory_size) {
+        return 11;
+    }
+    return 0;
+}
@@ -13,5 +13,8 @@
 #define TST_GLYPHRAWER_H
 
 int tst_fillInnerAreaInImageFiles();
+int tst_glyph_drawer_paint_curve();
+int tst_glyph_drawer_draw_line();
+int tst_glyph_drawer_pool();
 
 #endif // TST_GLYPHRAWER_H
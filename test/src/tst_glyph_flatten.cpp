@@ -0,0 +1,75 @@
+/*!
+ * \file
+ * \brief file tst_glyph_flatten.cpp
+ *
+ * test glyph_flatten.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_glyph_flatten.h"
+#include <math.h>
+#include "../../lib/src/drawfont/glyph_flatten.h"
+
+/*!
+ * \brief tst_glyph_flatten_points
+ *
+ * points are on the curve, the middle of each line is
+ * inside of the tolerance and the last point is the end point
+ *
+ * \return 0 on success
+ */
+int tst_glyph_flatten_points()
+{
+    int count = 0;
+    float x, y, t, mt;
+    float prev_x = 0, prev_y = 0;
+    float curve_x, curve_y;
+    glyph_flatten_t flatten;
+
+    // straight line is a single line
+    glyph_flatten_init(&flatten, 0, 0, 10, 0, 5, 0, 0.25f, 64);
+    if (!glyph_flatten_next(&flatten, &x, &y) || fabsf(x - 10) > 0 || fabsf(y) > 0) {
+        return 1;
+    }
+    if (glyph_flatten_next(&flatten, &x, &y)) {
+        return 2;
+    }
+
+    // |p0-2c+p1| = 200, count = ceil(sqrt(200/(4*0.25))) = 15
+    glyph_flatten_init(&flatten, 0, 0, 100, 0, 50, 100, 0.25f, 64);
+    while (glyph_flatten_next(&flatten, &x, &y)) {
+        count++;
+        t = (float)count/15.0f;
+        mt = 1.0f - t;
+        if (fabsf(x - (2.0f*mt*t*50 + t*t*100)) > 0.01f || fabsf(y - 2.0f*mt*t*100) > 0.01f) {
+            return 3;
+        }
+        // middle of the line is farthest from the curve
+        t = ((float)count - 0.5f)/15.0f;
+        mt = 1.0f - t;
+        curve_x = 2.0f*mt*t*50 + t*t*100;
+        curve_y = 2.0f*mt*t*100;
+        if (hypotf((prev_x + x)/2.0f - curve_x, (prev_y + y)/2.0f - curve_y) > 0.25f) {
+            return 4;
+        }
+        prev_x = x;
+        prev_y = y;
+    }
+    if (count != 15 || fabsf(x - 100) > 0 || fabsf(y) > 0) {
+        return 5;
+    }
+
+    // count is limited
+    count = 0;
+    glyph_flatten_init(&flatten, 0, 0, 100, 0, 50, 100, 0.25f, 8);
+    while (glyph_flatten_next(&flatten, &x, &y)) {
+        count++;
+    }
+    if (count != 8) {
+        return 6;
+    }
+    return 0;
+}
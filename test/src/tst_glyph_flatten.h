@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_glyph_flatten.h
+ *
+ * test glyph_flatten.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_GLYPH_FLATTEN_H
+#define TST_GLYPH_FLATTEN_H
+
+int tst_glyph_flatten_points();
+
+#endif // TST_GLYPH_FLATTEN_H
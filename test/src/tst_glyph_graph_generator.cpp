@@ -11,11 +11,17 @@
 #include "tst_glyph_graph_generator.h"
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test_font.h"
+#include "../../lib/src/font_handle.h"
+#include "../../lib/src/drawfont/glyph_graph_generator.h"
 
 int32_t get_min_value(float value, int quality);
 int32_t get_max_value(float value, int quality);
 int32_t decrease_min_value(int32_t value, int32_t quality, const float value_to_correct);
 int32_t increase_max_value(int32_t value, int32_t quality, const float value_to_correct);
+void set_quadratic_min_max(float *min, float *max, const float value0, const float curve_value, const float value1);
 
 /*!
  * \brief tst_glyph_graph_generator_min_value
@@ -215,3 +221,218 @@ int tst_glyph_graph_generator_max_value()
     }
     return 0;
 }
+
+/*!
+ * \brief tst_glyph_graph_generator_quadratic_min_max
+ *
+ * Tests set_quadratic_min_max in glyph_graph_generator
+ *
+ * \return 0 on success
+ */
+int tst_glyph_graph_generator_quadratic_min_max()
+{
+    float min = 0;
+    float max = 0;
+
+    // extremum is at t = 0.5, half way to the control point
+    set_quadratic_min_max(&min, &max, 0, 20, 0);
+    if (max < 9.99f || max > 10.01f || min < 0 || min > 0) {
+        return 1;
+    }
+
+    set_quadratic_min_max(&min, &max, 10, -10, 0);
+    if (min < -3.34f || min > -3.33f) {
+        return 2;
+    }
+
+    // monotonic curve and line have no extremum between end points
+    min = 0;
+    max = 10;
+    set_quadratic_min_max(&min, &max, 0, 5, 10);
+    set_quadratic_min_max(&min, &max, 0, 2, 10);
+    set_quadratic_min_max(&min, &max, 5, 5, 5);
+    if (min < 0 || min > 0 || max < 10 || max > 10) {
+        return 3;
+    }
+    return 0;
+}
+
+/*!
+ * \brief tst_glyph_graph_generator_generate
+ *
+ * generates the glyphs of the characters 'A'.. with the thread count
+ *
+ * \param font
+ * \param fill_mode
+ * \param thread_count
+ * \param rotate
+ * \param image_data [out]
+ * \return 0 on success
+ */
+static int tst_glyph_graph_generator_generate(prj_ttf_reader_font_t *font, int fill_mode, uint32_t thread_count,
+                                              float rotate, prj_ttf_reader_data_t *image_data)
+{
+    int ret;
+    uint32_t i;
+    uint32_t list_characters[TEST_FONT_GLYPHS];
+    font_generate_t generate;
+
+    for (i=0;i<TEST_FONT_GLYPHS;i++) {
+        list_characters[i] = 'A' + i;
+    }
+    font_handle_init_generate(font, &generate);
+    generate.fill_mode = fill_mode;
+    generate.thread_count = thread_count;
+    ret = glyph_graph_generator_generate_graph(list_characters, TEST_FONT_GLYPHS,
+                                               font->file_data, font->file_data_size, 24.0f,
+                                               &font->tables, &generate, 5, image_data,
+                                               &font->tables.hor_metrics_table, &font->tables.hor_header_table,
+                                               rotate, 0, 0);
+    font_handle_clear_generate(&generate);
+    return ret;
+}
+
+/*!
+ * \brief tst_glyph_graph_generator_thread_count
+ *
+ * tests that the image and the glyph data are same when
+ * the glyphs are drawn by single thread and by many threads
+ *
+ * \return 0 on success
+ */
+int tst_glyph_graph_generator_thread_count()
+{
+    int ret = 0;
+    int fill_mode;
+    int rotation;
+    uint8_t data[TEST_FONT_MAX_SIZE];
+    size_t data_size = test_font_write(data);
+    prj_ttf_reader_font_t *font = NULL;
+    prj_ttf_reader_data_t single;
+    prj_ttf_reader_data_t many;
+
+    if (font_handle_open_memory(data, data_size, PRJ_TTF_READER_MEMORY_MODE_BORROW, &font)
+            || font_handle_load_tables(font, FONT_HANDLE_TABLE_CMAP | FONT_HANDLE_TABLE_LOCA | FONT_HANDLE_TABLE_HMTX)) {
+        font_handle_close(&font);
+        return 1;
+    }
+
+    for (fill_mode=PRJ_TTF_READER_FILL_MODE_FLOOD;fill_mode<=PRJ_TTF_READER_FILL_MODE_TILED && !ret;fill_mode++) {
+        for (rotation=0;rotation<2 && !ret;rotation++) {
+            memset(&single, 0, sizeof(single));
+            memset(&many, 0, sizeof(many));
+            if (tst_glyph_graph_generator_generate(font, fill_mode, 1, 0.5f*(float)rotation, &single)
+                    || tst_glyph_graph_generator_generate(font, fill_mode, 4, 0.5f*(float)rotation, &many)) {
+                ret = 2;
+            } else if (single.list_data_count != TEST_FONT_GLYPHS
+                       || single.list_data_count != many.list_data_count
+                       || single.image.width != many.image.width || single.image.height != many.image.height) {
+                ret = 3;
+            } else if (memcmp(single.image.data, many.image.data, (size_t)(single.image.width*single.image.height))
+                       || memcmp(single.list_data, many.list_data, sizeof(prj_ttf_reader_glyph_data_t)*single.list_data_count)) {
+                ret = 4;
+            }
+            free(single.image.data);
+            free(single.list_data);
+            free(many.image.data);
+            free(many.list_data);
+        }
+    }
+    // workers are kept by the font until it's closed
+    if (!ret && font->workers.list_thread_count != 3) {
+        ret = 5;
+    }
+    font_handle_close(&font);
+    return ret;
+}
+
+/*!
+ * \brief tst_glyph_graph_generator_generate_max_memory
+ *
+ * generates the glyph of the character 'L' in the calling thread
+ *
+ * \param font
+ * \param fill_mode
+ * \param font_size_px
+ * \param max_memory_size
+ * \param use_workers 1 to keep the canvas in the workers of the font,
+ * 0 to draw with a new canvas
+ * \return 0 on success
+ */
+static int tst_glyph_graph_generator_generate_max_memory(prj_ttf_reader_font_t *font, int fill_mode, float font_size_px,
+                                                         size_t max_memory_size, int use_workers)
+{
+    int ret;
+    uint32_t character = 'L';
+    font_generate_t generate;
+    prj_ttf_reader_data_t image_data;
+
+    memset(&image_data, 0, sizeof(image_data));
+    font_handle_init_generate(font, &generate);
+    generate.fill_mode = fill_mode;
+    generate.max_glyph_memory_size = max_memory_size;
+    generate.thread_count = 1;
+    if (!use_workers) {
+        generate.workers = NULL;
+    }
+    ret = glyph_graph_generator_generate_graph(&character, 1,
+                                               font->file_data, font->file_data_size, font_size_px,
+                                               &font->tables, &generate, 10, &image_data,
+                                               &font->tables.hor_metrics_table, &font->tables.hor_header_table,
+                                               0, 0, 0);
+    font_handle_clear_generate(&generate);
+    free(image_data.image.data);
+    free(image_data.list_data);
+    return ret;
+}
+
+/*!
+ * \brief tst_glyph_graph_generator_max_memory_retry
+ *
+ * large glyph is drawn with the smallest max memory size that it fits,
+ * the canvas keeps its buffers. Smaller glyphs of other fill modes need
+ * more than the rest of the max memory size, but they must still fit
+ *
+ * \return 0 on success
+ */
+int tst_glyph_graph_generator_max_memory_retry()
+{
+    int ret = 0;
+    uint8_t data[TEST_FONT_MAX_SIZE];
+    size_t data_size = test_font_write(data);
+    prj_ttf_reader_font_t *font = NULL;
+    size_t min_size = 0;
+    size_t max_size = 4*1024*1024;
+    size_t size;
+
+    if (font_handle_open_memory(data, data_size, PRJ_TTF_READER_MEMORY_MODE_BORROW, &font)
+            || font_handle_load_tables(font, FONT_HANDLE_TABLE_CMAP | FONT_HANDLE_TABLE_LOCA | FONT_HANDLE_TABLE_HMTX)) {
+        font_handle_close(&font);
+        return 1;
+    }
+
+    // smallest max memory size of the large glyph
+    if (tst_glyph_graph_generator_generate_max_memory(font, PRJ_TTF_READER_FILL_MODE_FLOOD, 120.0f, max_size, 0)) {
+        ret = 2;
+    }
+    while (!ret && min_size + 1 < max_size) {
+        size = min_size + (max_size - min_size)/2;
+        if (tst_glyph_graph_generator_generate_max_memory(font, PRJ_TTF_READER_FILL_MODE_FLOOD, 120.0f, size, 0)) {
+            min_size = size;
+        } else {
+            max_size = size;
+        }
+    }
+
+    if (!ret && tst_glyph_graph_generator_generate_max_memory(font, PRJ_TTF_READER_FILL_MODE_FLOOD, 120.0f, max_size, 1)) {
+        ret = 3;
+    }
+    if (!ret && tst_glyph_graph_generator_generate_max_memory(font, PRJ_TTF_READER_FILL_MODE_ANALYTIC, 100.0f, max_size, 1)) {
+        ret = 4;
+    }
+    if (!ret && tst_glyph_graph_generator_generate_max_memory(font, PRJ_TTF_READER_FILL_MODE_TILED, 100.0f, max_size, 1)) {
+        ret = 5;
+    }
+    font_handle_close(&font);
+    return ret;
+}
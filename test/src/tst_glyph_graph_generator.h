@@ -13,5 +13,8 @@
 
 int tst_glyph_graph_generator_min_value();
 int tst_glyph_graph_generator_max_value();
+int tst_glyph_graph_generator_quadratic_min_max();
+int tst_glyph_graph_generator_thread_count();
+int tst_glyph_graph_generator_max_memory_retry();
 
 #endif // TST_GLYPH_GRAPH_GENERATOR_H
@@ -0,0 +1,142 @@
+/*!
+ * \file
+ * \brief file tst_glyph_scanline.cpp
+ *
+ * test glyph_scanline.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_glyph_scanline.h"
+#include <string.h>
+#include <errno.h>
+#include "../../lib/src/drawfont/glyph_scanline.h"
+#include "../../lib/src/drawfont/glyph_drawer.h"
+
+/*!
+ * \brief tst_glyph_scanline_add_square
+ *
+ * adds square into edge list, counter-clockwise or clockwise
+ *
+ * \param scanline
+ * \param min min x and y
+ * \param max max x and y
+ * \param clockwise
+ */
+static void tst_glyph_scanline_add_square(glyph_scanline_t *scanline, float min, float max, bool clockwise)
+{
+    if (clockwise) {
+        glyph_scanline_add_line(scanline, min, min, min, max);
+        glyph_scanline_add_line(scanline, min, max, max, max);
+        glyph_scanline_add_line(scanline, max, max, max, min);
+        glyph_scanline_add_line(scanline, max, min, min, min);
+    } else {
+        glyph_scanline_add_line(scanline, min, min, max, min);
+        glyph_scanline_add_line(scanline, max, min, max, max);
+        glyph_scanline_add_line(scanline, max, max, min, max);
+        glyph_scanline_add_line(scanline, min, max, min, min);
+    }
+}
+
+/*!
+ * \brief tst_glyph_scanline_count_inner
+ * \param drawing
+ * \return count of inner pixels
+ */
+static int tst_glyph_scanline_count_inner(const font_drawing_t *drawing)
+{
+    int x, y, count = 0;
+    for (y=0;y<drawing->height;y++) {
+        for (x=0;x<drawing->width;x++) {
+            if (GLYPH_DRAWER_GET(drawing, GLYPH_DRAWER_PLANE_INNER, x, y)) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+/*!
+ * \brief tst_glyph_scanline_fill
+ *
+ * tests that pixels are filled by the non-zero winding rule,
+ * contours of same direction fill the inner contour and
+ * opposite direction makes the hole, also the curve is filled
+ * and the lists don't exceed the max memory size
+ *
+ * \return 0 on success
+ */
+int tst_glyph_scanline_fill()
+{
+    int ret = 0;
+    int i, count;
+    font_drawing_t drawing;
+    glyph_scanline_t scanline;
+    glyph_memory_t memory;
+    const size_t edge_size = sizeof(glyph_scanline_edge_t) + sizeof(uint32_t) + sizeof(glyph_scanline_crossing_t);
+
+    memset(&scanline, 0, sizeof(scanline));
+    memset(&drawing, 0, sizeof(drawing));
+
+    // same direction, inner square is filled
+    glyph_drawer_init(&drawing, 20, 20, NULL);
+    tst_glyph_scanline_add_square(&scanline, 2, 18, false);
+    tst_glyph_scanline_add_square(&scanline, 6, 14, false);
+    glyph_scanline_fill(&scanline, &drawing);
+    if (tst_glyph_scanline_count_inner(&drawing) != 16*16
+            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_INNER, 10, 10)
+            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_INNER, 2, 2)
+            || GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_INNER, 18, 18)) {
+        ret = 1;
+    }
+    glyph_drawer_clear(&drawing);
+
+    // opposite direction makes the hole
+    glyph_scanline_reset(&scanline);
+    glyph_drawer_init(&drawing, 20, 20, NULL);
+    tst_glyph_scanline_add_square(&scanline, 2, 18, false);
+    tst_glyph_scanline_add_square(&scanline, 6, 14, true);
+    glyph_scanline_fill(&scanline, &drawing);
+    if (tst_glyph_scanline_count_inner(&drawing) != 16*16 - 8*8
+            || GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_INNER, 10, 10)
+            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_INNER, 4, 10)) {
+        ret = 2;
+    }
+    glyph_drawer_clear(&drawing);
+
+    // curve and line, area is 2/3*16*8
+    glyph_scanline_reset(&scanline);
+    glyph_drawer_init(&drawing, 20, 20, NULL);
+    glyph_scanline_add_curve(&scanline, 2, 2, 18, 2, 10, 18);
+    glyph_scanline_add_line(&scanline, 18, 2, 2, 2);
+    glyph_scanline_fill(&scanline, &drawing);
+    count = tst_glyph_scanline_count_inner(&drawing);
+    if (count < 80 || count > 91
+            || !GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_INNER, 10, 9)
+            || GLYPH_DRAWER_GET(&drawing, GLYPH_DRAWER_PLANE_INNER, 10, 11)) {
+        ret = 3;
+    }
+    glyph_drawer_clear(&drawing);
+
+    glyph_scanline_clear(&scanline);
+
+    // lists grow only by one edge when doubling would exceed the max memory size
+    memory.memory_size = 0;
+    memory.max_memory_size = 513*edge_size;
+    scanline.memory = &memory;
+    for (i=0;i<257;i++) {
+        if (glyph_scanline_add_line(&scanline, 0, (float)i, 1, (float)i + 1)) {
+            ret = 4;
+        }
+    }
+    if (scanline.list_edge_size != 257 || glyph_scanline_add_line(&scanline, 0, 0, 1, 1) != ENOMEM) {
+        ret = 5;
+    }
+    glyph_scanline_clear(&scanline);
+    if (memory.memory_size) {
+        ret = 6;
+    }
+    return ret;
+}
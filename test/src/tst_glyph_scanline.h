@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_glyph_scanline.h
+ *
+ * test glyph_scanline.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_GLYPH_SCANLINE_H
+#define TST_GLYPH_SCANLINE_H
+
+int tst_glyph_scanline_fill();
+
+#endif // TST_GLYPH_SCANLINE_H
@@ -0,0 +1,75 @@
+/*!
+ * \file
+ * \brief file tst_glyph_tiles.cpp
+ *
+ * test glyph_tiles.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_glyph_tiles.h"
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include "../../lib/src/drawfont/glyph_tiles.h"
+#include "../../lib/src/drawfont/glyph_scanline.h"
+#include "../../lib/src/drawfont/glyph_drawer.h"
+
+/*!
+ * \brief tst_glyph_tiles_fill
+ *
+ * square from 10 to 190 is filled into tiles, only
+ * the tiles of the edges of the square are allocated
+ *
+ * \return 0 on success
+ */
+int tst_glyph_tiles_fill()
+{
+    int ret = 0;
+    glyph_tiles_t tiles;
+    glyph_memory_t memory;
+    glyph_scanline_t scanline;
+    font_drawing_t drawing;
+
+    memset(&scanline, 0, sizeof(scanline));
+    memset(&drawing, 0, sizeof(drawing));
+
+    if (glyph_tiles_init(&tiles, 200, 200, NULL)) {
+        return 1;
+    }
+    glyph_drawer_init_tiles(&drawing, &tiles);
+    glyph_scanline_add_line(&scanline, 10, 10, 190, 10);
+    glyph_scanline_add_line(&scanline, 190, 10, 190, 190);
+    glyph_scanline_add_line(&scanline, 190, 190, 10, 190);
+    glyph_scanline_add_line(&scanline, 10, 190, 10, 10);
+    glyph_drawer_draw_line(10, 10, 190, 10, &drawing, 1);
+    if (glyph_scanline_fill(&scanline, &drawing)) {
+        ret = 2;
+    } else if (!tiles.list_tile_full[1*tiles.tile_columns + 1] || tiles.list_tile[1*tiles.tile_columns + 1]
+            || tiles.list_tile_full[0] || !tiles.list_tile[0]
+            || glyph_tiles_get(&tiles, 1, 100) != ~(uint64_t)0
+            || glyph_tiles_get(&tiles, 0, 10) != (~(uint64_t)0 << 10)
+            || glyph_tiles_get(&tiles, 0, 9)
+            || glyph_tiles_get(&tiles, 2, 189) != ~(~(uint64_t)0 << (190 - 128))) {
+        ret = 3;
+    }
+    glyph_drawer_clear(&drawing);
+    glyph_scanline_clear(&scanline);
+
+    // tile list fits, but the tile does not
+    memory.memory_size = 0;
+    memory.max_memory_size = 17*sizeof(uint64_t *) + 17 + 100;
+    if (glyph_tiles_init(&tiles, 200, 200, &memory)) {
+        return 4;
+    }
+    if (glyph_tiles_set(&tiles, 1, 70, 1) != ENOMEM) {
+        ret = 5;
+    }
+    glyph_tiles_clear(&tiles);
+    if (memory.memory_size) {
+        ret = 6;
+    }
+    return ret;
+}
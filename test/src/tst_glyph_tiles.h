@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_glyph_tiles.h
+ *
+ * test glyph_tiles.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_GLYPH_TILES_H
+#define TST_GLYPH_TILES_H
+
+int tst_glyph_tiles_fill();
+
+#endif // TST_GLYPH_TILES_H
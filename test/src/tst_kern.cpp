@@ -0,0 +1,101 @@
+/*!
+ * \file
+ * \brief file tst_kern.cpp
+ *
+ * test kern.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_kern.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../../lib/src/reader/kern.h"
+
+/*!
+ * \brief tst_kern_put
+ *
+ * \param data
+ * \param offset [in/out]
+ * \param value 16 bit value in big endian
+ */
+static void tst_kern_put(uint8_t *data, size_t *offset, uint16_t value)
+{
+    data[*offset] = (uint8_t)(value >> 8);
+    data[*offset + 1] = (uint8_t)value;
+    *offset += 2;
+}
+
+/*!
+ * \brief tst_kern_parse_generated_characters
+ *
+ * tests that kerning pairs are added only for the generated
+ * characters, and for every character of the same glyph
+ *
+ * \return 0 on success
+ */
+int tst_kern_parse_generated_characters()
+{
+    int ret = 0;
+    uint8_t data[64];
+    size_t offset = 0;
+    glyph_character_t list_glyph_character[4];
+    prj_ttf_reader_data_t *image_data = prj_ttf_reader_init_data();
+
+    if (!image_data) {
+        return 1;
+    }
+
+    // kern table with one sub table, pairs are sorted by left and right glyph
+    tst_kern_put(data, &offset, 0);         // version
+    tst_kern_put(data, &offset, 1);         // nTables
+    tst_kern_put(data, &offset, 0);         // sub table version
+    tst_kern_put(data, &offset, 14 + 3*6);  // length
+    tst_kern_put(data, &offset, 1);         // coverage
+    tst_kern_put(data, &offset, 3);         // nPairs
+    tst_kern_put(data, &offset, 0);         // searchRange
+    tst_kern_put(data, &offset, 0);         // entrySelector
+    tst_kern_put(data, &offset, 0);         // rangeShift
+    tst_kern_put(data, &offset, 1);
+    tst_kern_put(data, &offset, 2);
+    tst_kern_put(data, &offset, (uint16_t)-100);
+    tst_kern_put(data, &offset, 2);
+    tst_kern_put(data, &offset, 5);
+    tst_kern_put(data, &offset, 40);
+    tst_kern_put(data, &offset, 3);
+    tst_kern_put(data, &offset, 4);
+    tst_kern_put(data, &offset, 60);
+
+    // 'A' and 'a' share glyph 1, glyphs 4 and 5 are not generated
+    memset(list_glyph_character, 0, sizeof(list_glyph_character));
+    list_glyph_character[0].glyph_index = 1;
+    list_glyph_character[0].character = 'A';
+    list_glyph_character[1].glyph_index = 1;
+    list_glyph_character[1].character = 'a';
+    list_glyph_character[2].glyph_index = 2;
+    list_glyph_character[2].character = 'B';
+    list_glyph_character[3].glyph_index = 3;
+    list_glyph_character[3].character = 'C';
+
+    if (kern_parse(data, offset, 0, image_data, 0.5f, list_glyph_character, 4)) {
+        ret = 2;
+    } else if (image_data->list_kerning_left_character_count != 2) {
+        ret = 3;
+    } else if (prj_ttf_reader_get_kerning('A', 'B', image_data) != -50.0f
+               || prj_ttf_reader_get_kerning('a', 'B', image_data) != -50.0f) {
+        ret = 4;
+    } else if (prj_ttf_reader_get_kerning('B', 'A', image_data) != 0.0f
+               || prj_ttf_reader_get_kerning('C', 'B', image_data) != 0.0f) {
+        ret = 5;
+    }
+
+    // truncated table
+    if (!ret && !kern_parse(data, offset - 2, 0, image_data, 0.5f, list_glyph_character, 4)) {
+        ret = 6;
+    }
+
+    prj_ttf_reader_clear_data(&image_data);
+    return ret;
+}
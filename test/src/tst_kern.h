@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_kern.h
+ *
+ * test kern.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_KERN_H
+#define TST_KERN_H
+
+int tst_kern_parse_generated_characters();
+
+#endif // TST_KERN_H
@@ -0,0 +1,75 @@
+/*!
+ * \file
+ * \brief file tst_loca.cpp
+ *
+ * test loca.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_loca.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../../lib/src/reader/loca.h"
+
+/*!
+ * \brief count of the loca offsets of the font that has 65535 glyphs
+ */
+#define TST_LOCA_MAX_TABLE_COUNT    65536
+
+/*!
+ * \brief tst_loca_parse_max_glyphs
+ *
+ * tests that all the offsets of the font with 65535 glyphs
+ * (65536 offsets) are parsed in short and long format
+ *
+ * \return 0 on success
+ */
+int tst_loca_parse_max_glyphs()
+{
+    int ret = 0;
+    uint32_t i;
+    size_t data_size = 4*TST_LOCA_MAX_TABLE_COUNT;
+    uint8_t *data = (uint8_t *)malloc(data_size);
+    index_to_loc_table_t *list_tables = NULL;
+
+    if (!data) {
+        return 1;
+    }
+
+    // short format: offset/2 is the index
+    for (i=0;i<TST_LOCA_MAX_TABLE_COUNT;i++) {
+        data[2*i] = (uint8_t)(i >> 8);
+        data[2*i + 1] = (uint8_t)i;
+    }
+    if (loca_parse(data, 2*TST_LOCA_MAX_TABLE_COUNT, 0, &list_tables, TST_LOCA_MAX_TABLE_COUNT, 0)) {
+        ret = 2;
+    } else if (list_tables[1].offset != 2 || list_tables[TST_LOCA_MAX_TABLE_COUNT - 1].offset != 2*(TST_LOCA_MAX_TABLE_COUNT - 1)) {
+        ret = 3;
+    }
+    loca_clear(&list_tables);
+
+    // long format
+    for (i=0;!ret && i<TST_LOCA_MAX_TABLE_COUNT;i++) {
+        data[4*i] = 0;
+        data[4*i + 1] = (uint8_t)(i >> 16);
+        data[4*i + 2] = (uint8_t)(i >> 8);
+        data[4*i + 3] = (uint8_t)i;
+    }
+    if (!ret && loca_parse(data, data_size, 0, &list_tables, TST_LOCA_MAX_TABLE_COUNT, 1)) {
+        ret = 4;
+    } else if (!ret && list_tables[TST_LOCA_MAX_TABLE_COUNT - 1].offset != TST_LOCA_MAX_TABLE_COUNT - 1) {
+        ret = 5;
+    }
+    loca_clear(&list_tables);
+
+    // table is shorter than the offsets
+    if (!ret && !loca_parse(data, data_size - 4, 0, &list_tables, TST_LOCA_MAX_TABLE_COUNT, 1)) {
+        ret = 6;
+    }
+    loca_clear(&list_tables);
+    free(data);
+    return ret;
+}
@@ -0,0 +1,17 @@
+/*!
+ * \file
+ * \brief file tst_loca.h
+ *
+ * test loca.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_LOCA_H
+#define TST_LOCA_H
+
+int tst_loca_parse_max_glyphs();
+
+#endif // TST_LOCA_H
@@ -0,0 +1,178 @@
+/*!
+ * \file
+ * \brief file tst_otff.cpp
+ *
+ * test otff.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#include "tst_otff.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "../../lib/src/reader/otff.h"
+
+/*!
+ * \brief tst_otff_table_directory
+ *
+ * tests otff_parse_table_directory and otff_get_table
+ *
+ * \return 0 on success
+ */
+int tst_otff_table_directory()
+{
+    table_record_t list_table_record[5];
+    table_directory_t directory;
+    table_view_t view;
+
+    memset(list_table_record, 0, sizeof(list_table_record));
+    list_table_record[0].table_tag = OTFF_TAG('g', 'l', 'y', 'f');
+    list_table_record[0].offset = 100;
+    list_table_record[0].length = 50;
+    list_table_record[1].table_tag = OTFF_TAG('k', 'e', 'r', 'n');
+    list_table_record[1].offset = 200;
+    list_table_record[1].length = 10;
+    list_table_record[2].table_tag = OTFF_TAG('c', 'm', 'a', 'p');
+    list_table_record[2].offset = 20;
+    list_table_record[2].length = 30;
+    list_table_record[3].table_tag = OTFF_TAG('c', 'm', 'a', 'p');
+    list_table_record[3].offset = 60;
+    list_table_record[3].length = 30;
+    list_table_record[4].table_tag = OTFF_TAG('O', 'S', '/', '2');
+    list_table_record[4].offset = 10;
+    list_table_record[4].length = 10;
+
+    if (OTFF_TAG_GLYF != 0x676C7966) {
+        return 1;
+    }
+
+    otff_parse_table_directory(list_table_record, 5, 120, &directory);
+
+    // length is limited to the end of the data
+    if (otff_get_table(&directory, OTFF_TABLE_GLYF, &view) || view.offset != 100 || view.length != 20) {
+        return 2;
+    }
+
+    // table outside of the data is not found
+    if (!otff_get_table(&directory, OTFF_TABLE_KERN, &view)) {
+        return 3;
+    }
+
+    // first one of same tags is used
+    if (otff_get_table(&directory, OTFF_TABLE_CMAP, &view) || view.offset != 20 || view.length != 30) {
+        return 4;
+    }
+
+    if (!otff_get_table(&directory, OTFF_TABLE_HEAD, &view)
+            || !otff_get_table(&directory, OTFF_TABLE_COUNT, &view)) {
+        return 5;
+    }
+
+    if (otff_get_table_record_index_by_tag(list_table_record, 5, OTFF_TAG_CMAP) != 2
+            || otff_get_table_record_index_by_tag(list_table_record, 5, OTFF_TAG_HEAD) != UINT16_MAX) {
+        return 6;
+    }
+
+    if (otff_get_table_record_index(list_table_record, 5, "OS/2") != 4
+            || otff_get_table_record_index(list_table_record, 5, "OS") != UINT16_MAX) {
+        return 7;
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief tst_otff_collection
+ *
+ * tests otff_get_face_count and otff_get_face_offset
+ *
+ * \return 0 on success
+ */
+int tst_otff_collection()
+{
+    uint32_t face_count;
+    size_t face_offset;
+    const uint8_t collection[] = { 't', 't', 'c', 'f', 0, 1, 0, 0, 0, 0, 0, 2,
+                                   0, 0, 0, 20, 0, 0, 1, 0 };
+    const uint8_t single[] = { 0, 1, 0, 0, 0, 10 };
+
+    if (otff_get_face_count(collection, sizeof(collection), &face_count) || face_count != 2) {
+        return 1;
+    }
+
+    if (otff_get_face_offset(collection, sizeof(collection), 0, &face_offset) || face_offset != 20) {
+        return 2;
+    }
+
+    if (otff_get_face_offset(collection, sizeof(collection), 1, &face_offset) || face_offset != 256) {
+        return 3;
+    }
+
+    if (!otff_get_face_offset(collection, sizeof(collection), 2, &face_offset)) {
+        return 4;
+    }
+
+    // offsets outside of the data
+    if (!otff_get_face_offset(collection, sizeof(collection) - 1, 1, &face_offset)) {
+        return 5;
+    }
+
+    if (otff_get_face_count(single, sizeof(single), &face_count) || face_count != 1) {
+        return 6;
+    }
+
+    if (otff_get_face_offset(single, sizeof(single), 0, &face_offset) || face_offset != 0) {
+        return 7;
+    }
+
+    if (!otff_get_face_offset(single, sizeof(single), 1, &face_offset)) {
+        return 8;
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief tst_otff_collection_truncated
+ *
+ * tests that the collection is rejected when numFonts of
+ * the TTC header has more offsets than the font data
+ *
+ * \return 0 on success
+ */
+int tst_otff_collection_truncated()
+{
+    uint32_t face_count;
+    size_t face_offset;
+    uint8_t collection[] = { 't', 't', 'c', 'f', 0, 1, 0, 0, 0, 0, 0, 2,
+                             0, 0, 0, 20, 0, 0, 1, 0 };
+
+    // only the first offset is in the data
+    if (otff_get_face_count(collection, sizeof(collection) - 4, &face_count) != EINVAL) {
+        return 1;
+    }
+
+    if (otff_get_face_offset(collection, sizeof(collection) - 4, 0, &face_offset) != EINVAL) {
+        return 2;
+    }
+
+    // numFonts would overflow 12 + 4*numFonts in 32 bits
+    collection[8] = 0x40;
+    if (otff_get_face_count(collection, sizeof(collection), &face_count) != EINVAL) {
+        return 3;
+    }
+
+    // header without offsets
+    collection[8] = 0;
+    if (otff_get_face_count(collection, 12, &face_count) != EINVAL) {
+        return 4;
+    }
+
+    if (otff_get_face_count(collection, sizeof(collection), &face_count) || face_count != 2) {
+        return 5;
+    }
+    return 0;
+}
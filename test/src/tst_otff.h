@@ -0,0 +1,19 @@
+/*!
+ * \file
+ * \brief file tst_otff.h
+ *
+ * test otff.c sources
+ *
+ * Copyright of Timo Hannukkala. All rights reserved.
+ *
+ * \author Timo Hannukkala <timohannukkala@hotmail.com>
+ */
+
+#ifndef TST_OTFF_H
+#define TST_OTFF_H
+
+int tst_otff_table_directory();
+int tst_otff_collection();
+int tst_otff_collection_truncated();
+
+#endif // TST_OTFF_H